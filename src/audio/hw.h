@@ -43,6 +43,7 @@
 
 #define HST_SPI         spi0
 #define HST_BAUDRATE_HZ 1000000
+#define HST_DMA_IRQ     DMA_IRQ_0
 
 // DAC chip I2S
 #define AUD_I2S_PIO pio0
@@ -31,6 +31,7 @@ static void task(void)
     cdc_task();
     usb_task();
     aud_task();
+    sgu_task();
     hst_task();
     led_task();
 }
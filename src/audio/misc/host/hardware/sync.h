@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_SYNC_H_
+#define _HOST_HARDWARE_SYNC_H_
+
+// A full fence stands in for the data memory barrier.
+
+static inline void __dmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif /* _HOST_HARDWARE_SYNC_H_ */
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_PICO_H_
+#define _HOST_PICO_H_
+
+/* Just enough of the Pico SDK to build sys/ply.c on a Linux box,
+ * see misc/sgu_play.c.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define __not_in_flash_func(func_name) func_name
+
+#endif /* _HOST_PICO_H_ */
@@ -0,0 +1,145 @@
+/*
+ * sgu_golden.c  Compare SGU-1 control rate rendering against per sample
+ *
+ * gcc -std=gnu23 sgu_golden.c -O2 -c -o sgu_golden_ref.o -DSGU_GOLDEN_REF
+ * gcc -std=gnu23 sgu_golden.c sgu_golden_ref.o -O2 -o sgu_golden -Wall -lm
+ * ./sgu_golden [seconds]
+ *
+ * Plays the same pseudo random notes on two SGU-1 instances, one built
+ * with SGU_CONTROL_RATE and SGU_DSP and the golden one evaluating every
+ * operator on every sample in plain C, and reports how far the outputs
+ * drift apart. Add -DSGU_CONTROL_RATE=0 to the second line to check the
+ * DSP kernels alone, which must match bit for bit.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifdef SGU_GOLDEN_REF
+
+#define SGU_CONTROL_RATE        0
+#define SGU_DSP                 0
+#define SGU_Init                ref_SGU_Init
+#define SGU_Reset               ref_SGU_Reset
+#define SGU_Write               ref_SGU_Write
+#define SGU_NextSample          ref_SGU_NextSample
+#define SGU_NextSample_Setup    ref_SGU_NextSample_Setup
+#define SGU_NextSample_Channels ref_SGU_NextSample_Channels
+#define SGU_NextSample_Finalize ref_SGU_NextSample_Finalize
+#define SGU_GetSample           ref_SGU_GetSample
+#include "../snd/sgu.c"
+
+#else
+
+#include "../snd/sgu.c"
+#include <stdio.h>
+
+void ref_SGU_Init(struct SGU *sgu, size_t sampleMemSize);
+void ref_SGU_Reset(struct SGU *sgu);
+void ref_SGU_Write(struct SGU *sgu, uint16_t addr13, uint8_t data);
+void ref_SGU_NextSample(struct SGU *sgu, int32_t *l, int32_t *r);
+
+static struct SGU sgu, ref;
+
+static uint32_t rnd(void)
+{
+    static uint32_t seed = 0x5A5A5A5A;
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+static void write_reg(uint8_t ch, size_t reg, uint8_t data)
+{
+    const uint16_t addr = (uint16_t)((ch << 6) | reg);
+    SGU_Write(&sgu, addr, data);
+    ref_SGU_Write(&ref, addr, data);
+}
+
+#define CH_REG(field) offsetof(struct SGU_CH, field)
+
+// New random FM voice with a short or long note, filter and ring mod
+static void note_on(uint8_t ch)
+{
+    for (uint8_t op = 0; op < SGU_OP_PER_CH; op++)
+    {
+        const size_t base = op * SGU_OP_REGS;
+        for (size_t reg = 0; reg < SGU_OP_REGS; reg++)
+            write_reg(ch, base + reg, (uint8_t)rnd());
+        // let notes release fully, keep to implemented waveforms
+        write_reg(ch, base + 3, (uint8_t)(rnd() | 0x08));
+        write_reg(ch, base + 7, (uint8_t)((rnd() & 0xF8) | rnd() % 6));
+    }
+    const uint16_t freq = (uint16_t)rnd();
+    write_reg(ch, CH_REG(freq), (uint8_t)freq);
+    write_reg(ch, CH_REG(freq) + 1, (uint8_t)(freq >> 8));
+    write_reg(ch, CH_REG(vol), rnd() & 0x7F);
+    write_reg(ch, CH_REG(pan), (uint8_t)rnd());
+    write_reg(ch, CH_REG(cutoff), (uint8_t)rnd());
+    write_reg(ch, CH_REG(cutoff) + 1, (uint8_t)rnd());
+    write_reg(ch, CH_REG(reson), (uint8_t)rnd());
+    write_reg(ch, CH_REG(duty), rnd() & 0x7F);
+    write_reg(ch, CH_REG(flags1), 0);
+    write_reg(ch, CH_REG(flags0), (uint8_t)((rnd() & 0xF0) | SGU1_FLAGS0_CTL_GATE));
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned seconds = argc > 1 ? (unsigned)atoi(argv[1]) : 60;
+    const uint32_t samples = seconds * SGU_CHIP_CLOCK;
+
+    SGU_Init(&sgu, SGU_PCM_RAM_SIZE);
+    SGU_Reset(&sgu);
+    ref_SGU_Init(&ref, SGU_PCM_RAM_SIZE);
+    ref_SGU_Reset(&ref);
+
+    int32_t next[SGU_CHNS] = {0};
+    uint32_t exact = 0;
+    int64_t worst = 0;
+    double err = 0, sig = 0;
+    for (uint32_t n = 0; n < samples; n++)
+    {
+        for (uint8_t ch = 0; ch < SGU_CHNS; ch++)
+        {
+            if (--next[ch] > 0)
+                continue;
+            if (sgu.chan[ch].flags0 & SGU1_FLAGS0_CTL_GATE)
+            {
+                write_reg(ch, CH_REG(flags0), sgu.chan[ch].flags0 & ~SGU1_FLAGS0_CTL_GATE);
+                next[ch] = (int32_t)(rnd() % (SGU_CHIP_CLOCK * 2));
+            }
+            else
+            {
+                note_on(ch);
+                next[ch] = (int32_t)(rnd() % (SGU_CHIP_CLOCK / 2));
+            }
+        }
+
+        // level changes during notes land on the next control sample
+        if (rnd() % 1024 == 0)
+            write_reg(rnd() % SGU_CHNS, rnd() % SGU_OP_PER_CH * SGU_OP_REGS + 1, (uint8_t)rnd());
+
+        int32_t l, r, ref_l, ref_r;
+        SGU_NextSample(&sgu, &l, &r);
+        ref_SGU_NextSample(&ref, &ref_l, &ref_r);
+
+        const int64_t dl = (int64_t)l - ref_l;
+        const int64_t dr = (int64_t)r - ref_r;
+        if (!dl && !dr)
+            ++exact;
+        if (llabs(dl) > worst)
+            worst = llabs(dl);
+        if (llabs(dr) > worst)
+            worst = llabs(dr);
+        err += (double)(dl * dl + dr * dr);
+        sig += (double)ref_l * ref_l + (double)ref_r * ref_r;
+    }
+
+    printf("%u samples, %.2f%% bit exact, worst deviation %lld\n",
+           samples, 100.0 * exact / samples, (long long)worst);
+    if (err > 0)
+        printf("deviation %.1f dB below the golden signal\n", 10 * log10(sig / err));
+    return 0;
+}
+
+#endif
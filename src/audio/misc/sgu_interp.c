@@ -0,0 +1,129 @@
+/*
+ * sgu_interp.c  Measure SGU-1 PCM interpolation aliasing
+ *
+ * gcc -std=gnu23 sgu_interp.c -O2 -o sgu_interp -Wall -lm
+ * ./sgu_interp [samples per cycle]
+ *
+ * Loops a single cycle 8-bit sine sample on a PCM channel at a range of
+ * rates (PCM samples per output sample) with each interpolation mode, fits the ideal sine at the
+ * played frequency to the channel output and reports the signal to
+ * residual ratio. The residual is the aliasing and interpolation error
+ * on top of the 8-bit quantization floor, printed first.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "../snd/sgu.c"
+#include <stdio.h>
+
+#define CHAN    0
+#define SAMPLES (SGU_CHIP_CLOCK * 2)
+
+static struct SGU sgu;
+
+static void write_reg(size_t reg, uint8_t data)
+{
+    SGU_Write(&sgu, (uint16_t)((CHAN << 6) | reg), data);
+}
+
+#define CH_REG(field) offsetof(struct SGU_CH, field)
+
+static void write_reg16(size_t reg, uint16_t data)
+{
+    write_reg(reg, (uint8_t)data);
+    write_reg(reg + 1, (uint8_t)(data >> 8));
+}
+
+// Least squares fit of DC and a sine at the known frequency,
+// returns signal to residual power in dB.
+static double fit_db(const double *y, size_t n, double cycles_per_sample)
+{
+    double m[3][4] = {{0}};
+    for (size_t i = 0; i < n; i++)
+    {
+        const double w = 2 * M_PI * cycles_per_sample * i;
+        const double v[3] = {1, sin(w), cos(w)};
+        for (int r = 0; r < 3; r++)
+        {
+            for (int c = 0; c < 3; c++)
+                m[r][c] += v[r] * v[c];
+            m[r][3] += v[r] * y[i];
+        }
+    }
+    for (int p = 0; p < 3; p++)
+        for (int r = 0; r < 3; r++)
+            if (r != p)
+            {
+                const double f = m[r][p] / m[p][p];
+                for (int c = p; c < 4; c++)
+                    m[r][c] -= f * m[p][c];
+            }
+    const double k[3] = {m[0][3] / m[0][0], m[1][3] / m[1][1], m[2][3] / m[2][2]};
+    double sig = 0, err = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double w = 2 * M_PI * cycles_per_sample * i;
+        const double s = k[1] * sin(w) + k[2] * cos(w);
+        const double e = y[i] - k[0] - s;
+        sig += s * s;
+        err += e * e;
+    }
+    return 10 * log10(sig / err);
+}
+
+static double play_db(unsigned interp, uint16_t freq, unsigned length)
+{
+    SGU_Reset(&sgu);
+    write_reg16(CH_REG(pcmpos), 0);
+    write_reg16(CH_REG(pcmrst), 0);
+    write_reg16(CH_REG(pcmbnd), (uint16_t)length);
+    write_reg16(CH_REG(freq), freq);
+    write_reg(CH_REG(vol), 0x7F);
+    write_reg(CH_REG(flags1), SGU1_FLAGS1_PCM_LOOP);
+    write_reg(CH_REG(flags0), (uint8_t)(SGU1_FLAGS0_PCM_MASK | SGU1_FLAGS0_CTL_GATE
+                                        | interp << SGU1_FLAGS0_INTERP_SHIFT));
+
+    static double y[SAMPLES];
+    for (size_t i = 0; i < SAMPLES; i++)
+    {
+        int32_t l, r;
+        SGU_NextSample(&sgu, &l, &r);
+        y[i] = sgu.src[CHAN];
+    }
+    return fit_db(y, SAMPLES, (double)freq / 0x8000 / length);
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned length = argc > 1 ? (unsigned)atoi(argv[1]) : 32;
+    if (length < 4 || length > SGU_PCM_RAM_SIZE)
+    {
+        fprintf(stderr, "4 to %u samples per cycle\n", SGU_PCM_RAM_SIZE);
+        return 1;
+    }
+
+    SGU_Init(&sgu, SGU_PCM_RAM_SIZE);
+    double quant = 0, sig = 0;
+    for (unsigned i = 0; i < length; i++)
+    {
+        const double s = 127 * sin(2 * M_PI * i / length);
+        sgu.pcm[i] = (int8_t)lrint(s);
+        sig += s * s;
+        quant += (sgu.pcm[i] - s) * (sgu.pcm[i] - s);
+    }
+    printf("%u sample sine, 8-bit quantization floor %.1f dB\n", length, 10 * log10(sig / quant));
+    printf("  rate    nearest  linear   cubic\n");
+
+    static const double rates[] = {0.1, 0.25, 0.37, 0.5, 0.77, 0.9};
+    for (size_t i = 0; i < sizeof(rates) / sizeof(*rates); i++)
+    {
+        const uint16_t freq = (uint16_t)lrint(rates[i] * 0x8000);
+        printf("  %.3f", (double)freq / 0x8000);
+        for (unsigned interp = SGU1_INTERP_NONE; interp <= SGU1_INTERP_CUBIC; interp++)
+            printf("  %5.1f dB", play_db(interp, freq, length));
+        printf("\n");
+    }
+    return 0;
+}
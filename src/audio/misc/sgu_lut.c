@@ -0,0 +1,106 @@
+/*
+ * sgu_lut.c  Generate the SGU-1 lookup tables on the host
+ *
+ * gcc -std=gnu23 sgu_lut.c -O2 -o sgu_lut -Wall -lm
+ * ./sgu_lut > ../snd/sgu_lut.h
+ *
+ * gcc -std=gnu23 sgu_lut.c -O2 -o sgu_lut_check -Wall -lm -DSGU_LUT_CHECK
+ * ./sgu_lut_check
+ *
+ * Builds the tables with the runtime code of SGU_Init() and prints
+ * them as C. The check build compares the generated header with the
+ * runtime tables bit for bit, and lists sine entries so close to an
+ * integer step that another libm could round them the other way.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define SGU_STATIC_LUT 0
+#include "../snd/sgu.c"
+
+#ifdef SGU_LUT_CHECK
+
+#define sine_lut       static_sine_lut
+#define triangle_lut   static_triangle_lut
+#define sawtooth_lut   static_sawtooth_lut
+#define env_gain_lut   static_env_gain_lut
+#define pan_gain_lut   static_pan_gain_lut
+#include "../snd/sgu_lut.h"
+#undef sine_lut
+#undef triangle_lut
+#undef sawtooth_lut
+#undef env_gain_lut
+#undef pan_gain_lut
+
+static int check(const char *name, const void *runtime, const void *generated, size_t size)
+{
+    if (!memcmp(runtime, generated, size))
+        return 0;
+    fprintf(stderr, "%s differs\n", name);
+    return 1;
+}
+
+#define CHECK(lut) check(#lut, lut, static_##lut, sizeof(lut))
+
+#else
+
+static void print_i16(const char *name, const int16_t *lut, size_t len)
+{
+    printf("static const int16_t __attribute__((aligned(4))) %s[%zu] = {", name, len);
+    for (size_t i = 0; i < len; ++i)
+        printf("%s%6d,", i % 8 ? " " : "\n    ", lut[i]);
+    printf("\n};\n\n");
+}
+
+static void print_u16(const char *name, const uint16_t *lut, size_t len)
+{
+    printf("static const uint16_t __attribute__((aligned(4))) %s[%zu] = {", name, len);
+    for (size_t i = 0; i < len; ++i)
+        printf("%s0x%04x,", i % 8 ? " " : "\n    ", lut[i]);
+    printf("\n};\n\n");
+}
+
+static void print_u32(const char *name, const uint32_t *lut, size_t len)
+{
+    printf("static const uint32_t %s[%zu] = {", name, len);
+    for (size_t i = 0; i < len; ++i)
+        printf("%s0x%08x,", i % 8 ? " " : "\n    ", lut[i]);
+    printf("\n};\n\n");
+}
+
+#endif
+
+int main(void)
+{
+    static struct SGU sgu;
+    SGU_Init(&sgu, SGU_PCM_RAM_SIZE);
+
+#ifdef SGU_LUT_CHECK
+    int err = CHECK(sine_lut) + CHECK(triangle_lut) + CHECK(sawtooth_lut)
+              + CHECK(env_gain_lut) + CHECK(pan_gain_lut);
+    if (err)
+        return 1;
+    int fragile = 0;
+    for (int32_t i = 0; i < SGU_WAVEFORM_LENGTH >> 1; i++)
+    {
+        const long double s = sinl(M_PI * (long double)i / ((SGU_WAVEFORM_LENGTH >> 1) - 1)) * INT16_MAX;
+        const long double frac = fabsl(s - truncl(s));
+        if (fabsl(s) >= 1 && (frac < 1e-9L || frac > 1 - 1e-9L))
+        {
+            printf("sine_lut[%d] = %d is %.12Lf\n", i, sine_lut[i], s);
+            ++fragile;
+        }
+    }
+    printf("SGU lookup tables match, %d fragile sine entries\n", fragile);
+#else
+    printf("// Generated by misc/sgu_lut.c, do not edit.\n\n");
+    print_i16("sine_lut", sine_lut, SGU_WAVEFORM_LENGTH);
+    print_i16("triangle_lut", triangle_lut, SGU_WAVEFORM_LENGTH);
+    print_i16("sawtooth_lut", sawtooth_lut, SGU_WAVEFORM_LENGTH);
+    print_u16("env_gain_lut", env_gain_lut, 0x400);
+    print_u32("pan_gain_lut", pan_gain_lut, 256);
+#endif
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * sgu_play.c  Render an SGU-1 register stream to a WAV file
+ *
+ * gcc -std=gnu23 sgu_play.c ../sys/ply.c -O2 -o sgu_play -Wall -lm -Ihost -I.. -I../..
+ * ./sgu_play stream.sgr out.wav [max seconds]
+ *
+ * Plays a register stream (see sgr.h), as recorded by the VPU, through
+ * the SGU-1 engine with the player of the SGU-1, sys/ply.c: the commands
+ * due on a sample go before it is rendered. The stream is read from the
+ * file instead of the PCM RAM ring.
+ * Writes 16-bit stereo at the chip clock, scaled as the I2S output is.
+ * A looping stream plays for the max seconds, 60 unless given.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "../../sgr.h"
+#include "../snd/sgu.c"
+#include "../sys/ply.h"
+#include "../sys/sgu.h"
+#include <stdio.h>
+
+// The player writes here.
+sgu1_t sgu_instance;
+
+static uint8_t *cmds;
+static uint32_t cmds_len;
+static uint32_t loop;
+
+static uint32_t pos;
+static bool active = true;
+
+static uint8_t fetch(void)
+{
+    if (pos == cmds_len)
+    {
+        if (loop == SGR_NO_LOOP)
+            return SGR_END;
+        pos = loop;
+    }
+    return cmds[pos++];
+}
+
+static void put16(FILE *f, uint16_t v)
+{
+    fputc(v & 0xFF, f);
+    fputc(v >> 8, f);
+}
+
+static void put32(FILE *f, uint32_t v)
+{
+    put16(f, (uint16_t)v);
+    put16(f, (uint16_t)(v >> 16));
+}
+
+static void wav_header(FILE *f, uint32_t frames)
+{
+    fwrite("RIFF", 1, 4, f);
+    put32(f, 36 + frames * 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(f, 16);
+    put16(f, 1); // PCM
+    put16(f, 2);
+    put32(f, SGU_CHIP_CLOCK);
+    put32(f, SGU_CHIP_CLOCK * 4);
+    put16(f, 4);
+    put16(f, 16);
+    fwrite("data", 1, 4, f);
+    put32(f, frames * 4);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "%s stream.sgr out.wav [max seconds]\n", argv[0]);
+        return 1;
+    }
+    const uint32_t seconds = argc > 3 ? (uint32_t)atoi(argv[3]) : 60;
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    uint8_t header[SGR_HEADER_SIZE];
+    if (fread(header, 1, SGR_HEADER_SIZE, in) != SGR_HEADER_SIZE
+        || !sgr_header_loop(header, &loop))
+    {
+        fprintf(stderr, "%s: not an SGR version %u stream\n", argv[1], SGR_VERSION);
+        return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    cmds_len = (uint32_t)ftell(in) - SGR_HEADER_SIZE;
+    fseek(in, SGR_HEADER_SIZE, SEEK_SET);
+    cmds = malloc(cmds_len + 1);
+    if (fread(cmds, 1, cmds_len, in) != cmds_len)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    fclose(in);
+    if (loop != SGR_NO_LOOP && loop >= cmds_len)
+    {
+        fprintf(stderr, "%s: loop offset %u past the end\n", argv[1], loop);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[2], "wb");
+    if (!out)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    wav_header(out, 0);
+
+    SGU_Init(&sgu_instance.sgu, SGU_PCM_RAM_SIZE);
+    SGU_Reset(&sgu_instance.sgu);
+
+    const uint32_t max = seconds * SGU_CHIP_CLOCK;
+    uint32_t frames = 0, writes = 0;
+    while (active && frames < max)
+    {
+        const uint32_t from = pos;
+        active = ply_step(fetch);
+        if (pos != from)
+            ++writes;
+        int32_t l, r;
+        SGU_NextSample(&sgu_instance.sgu, &l, &r);
+        put16(out, (uint16_t)clamp(l >> 1, INT16_MIN, INT16_MAX));
+        put16(out, (uint16_t)clamp(r >> 1, INT16_MIN, INT16_MAX));
+        ++frames;
+    }
+    fseek(out, 0, SEEK_SET);
+    wav_header(out, frames);
+    fclose(out);
+
+    printf("%u command bytes, %s, %u samples with commands\n", cmds_len,
+           loop == SGR_NO_LOOP ? "plays once" : "loops", writes);
+    printf("%.2f s at %u Hz%s\n", (double)frames / SGU_CHIP_CLOCK, SGU_CHIP_CLOCK,
+           active ? ", cut at the max" : "");
+    free(cmds);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * sgu_stream.c  Simulate SGU-1 PCM streaming under refill latency
+ *
+ * gcc -std=gnu23 sgu_stream.c -O2 -o sgu_stream -Wall -lm
+ * ./sgu_stream [ring bytes] [sample rate Hz] [worst latency ms] [seconds]
+ *
+ * Streams pseudo random 8-bit samples through a ring of PCM RAM on one
+ * channel, refilled the way the VPU and RIA do it. The VPU polls the
+ * ring halves played every AUD_POLL_US, the RIA starts refilling a half
+ * after up to the worst latency (ACK wait, task and FatFs stalls) and
+ * sends it at PIX frame speed. Every sample the channel reads is checked
+ * against the source, a mismatch is a refill that came too late.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "../snd/sgu.c"
+#include <stdio.h>
+
+#define AUD_POLL_US     2000
+#define PIX_BYTES_PER_S 1000000 // 64 KB upload in about 65 ms
+
+#define CHAN 0
+#define RING 0x4000
+
+static struct SGU sgu;
+
+static uint32_t rnd(void)
+{
+    static uint32_t seed = 0x5A5A5A5A;
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+static int8_t *source;
+static uint32_t source_len;
+
+static int8_t source_at(uint32_t k)
+{
+    return k < source_len ? source[k] : 0;
+}
+
+static void write_reg(size_t reg, uint8_t data)
+{
+    SGU_Write(&sgu, (uint16_t)((CHAN << 6) | reg), data);
+}
+
+#define CH_REG(field) offsetof(struct SGU_CH, field)
+
+static void write_reg16(size_t reg, uint16_t data)
+{
+    write_reg(reg, (uint8_t)data);
+    write_reg(reg + 1, (uint8_t)(data >> 8));
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t size = argc > 1 ? (uint32_t)atoi(argv[1]) : 4096;
+    const uint32_t rate = argc > 2 ? (uint32_t)atoi(argv[2]) : 16000;
+    const uint32_t latency_ms = argc > 3 ? (uint32_t)atoi(argv[3]) : 20;
+    const uint32_t seconds = argc > 4 ? (uint32_t)atoi(argv[4]) : 180;
+    if (size < 64 || RING + size > SGU_PCM_RAM_SIZE || rate < 1 || rate > SGU_CHIP_CLOCK)
+    {
+        fprintf(stderr, "ring of 64 to %u bytes, rate up to %u Hz\n",
+                SGU_PCM_RAM_SIZE - RING, SGU_CHIP_CLOCK);
+        return 1;
+    }
+
+    source_len = seconds * rate;
+    source = malloc(source_len);
+    for (uint32_t k = 0; k < source_len; k++)
+        source[k] = (int8_t)rnd();
+
+    SGU_Init(&sgu, SGU_PCM_RAM_SIZE);
+    SGU_Reset(&sgu);
+
+    // RIA primes both halves before the channel starts
+    const uint32_t half_len[2] = {size / 2, size - size / 2};
+    const uint32_t half_start[2] = {0, size / 2};
+    uint32_t src = 0;
+    for (uint32_t i = 0; i < size; i++)
+        sgu.pcm[RING + i] = source_at(src++);
+
+    write_reg16(CH_REG(pcmpos), RING);
+    write_reg16(CH_REG(pcmrst), RING);
+    write_reg16(CH_REG(pcmbnd), (uint16_t)(RING + size));
+    write_reg16(CH_REG(freq), (uint16_t)((rate * 0x8000ull + SGU_CHIP_CLOCK / 2) / SGU_CHIP_CLOCK));
+    write_reg(CH_REG(vol), 0x7F);
+    write_reg(CH_REG(flags1), SGU1_FLAGS1_PCM_STREAM);
+    write_reg(CH_REG(flags0), SGU1_FLAGS0_PCM_MASK | SGU1_FLAGS0_CTL_GATE);
+
+    const uint32_t poll = AUD_POLL_US * SGU_CHIP_CLOCK / 1000000;
+    const double bytes_per_sample = (double)PIX_BYTES_PER_S / SGU_CHIP_CLOCK;
+    uint8_t vpu_asked = 0;      // halves the VPU asked refills for
+    uint8_t ria_asked = 0;      // requests the RIA got
+    uint8_t ria_filled = 0;     // halves refilled
+    int64_t ria_start = -1;     // sample the refill being waited for starts
+    double ria_done = 0;        // bytes of it sent
+    uint32_t refills = 0;
+    double worst_slack = 1e9;
+
+    uint32_t k = 0; // source index the channel plays
+    uint16_t last = RING;
+    uint32_t late = 0;
+    const uint32_t samples = (uint32_t)((uint64_t)source_len * SGU_CHIP_CLOCK / rate);
+    for (uint32_t n = 0; n < samples; n++)
+    {
+        const uint16_t pos = sgu.chan[CHAN].pcmpos;
+        if (pos != last)
+            ++k, last = pos;
+        if (sgu.pcm[pos] != source_at(k))
+            ++late;
+
+        int32_t l, r;
+        SGU_NextSample(&sgu, &l, &r);
+
+        // VPU poll, the request goes with the next PIX ACK
+        if (n % poll == 0 && sgu.pcm_halves[CHAN] != vpu_asked)
+        {
+            ++vpu_asked;
+            ++ria_asked;
+        }
+
+        // RIA task refills the halves in turn
+        if (ria_asked == ria_filled)
+            continue;
+        if (ria_start < 0)
+            ria_start = n + (int64_t)(rnd() % (latency_ms * SGU_CHIP_CLOCK / 1000 + 1));
+        if (n < ria_start)
+            continue;
+        const uint8_t half = ria_filled & 1;
+        const uint32_t from = (uint32_t)ria_done;
+        ria_done += bytes_per_sample;
+        if (ria_done > half_len[half])
+            ria_done = half_len[half];
+        for (uint32_t i = from; i < (uint32_t)ria_done; i++)
+            sgu.pcm[RING + half_start[half] + i] = source_at(src++);
+        if (ria_done < half_len[half])
+            continue;
+
+        // time until the channel gets to the refilled half
+        const uint32_t ahead = (RING + half_start[half] + size - sgu.chan[CHAN].pcmpos) % size;
+        const double slack = ahead * 1000.0 / rate;
+        if (slack < worst_slack)
+            worst_slack = slack;
+        ++refills;
+        ++ria_filled;
+        ria_start = -1;
+        ria_done = 0;
+    }
+
+    printf("%u bytes at %u Hz through a %u byte ring, %u refills\n",
+           k, rate, size, refills);
+    printf("half plays %.1f ms, worst latency %u ms, least slack %.1f ms\n",
+           half_len[0] * 1000.0 / rate, latency_ms, worst_slack);
+    printf("%u samples late, %s\n", late, late ? "GAPS" : "gap free");
+    free(source);
+    return late ? 1 : 0;
+}
@@ -61,6 +61,14 @@ static inline uint32_t __builtin_arm_usat(int32_t val, unsigned bits)
     return val < 0 ? 0 : (uint32_t)val > max ? max
                                              : (uint32_t)val;
 }
+static inline int32_t __builtin_arm_smulwb(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * (int16_t)b) >> 16);
+}
+static inline int32_t __builtin_arm_smulwt(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * (int16_t)(b >> 16)) >> 16);
+}
 
 #ifdef __clang__
 #pragma clang diagnostic ignored "-Wunknown-attributes"
@@ -71,6 +79,19 @@ static inline uint32_t __builtin_arm_usat(int32_t val, unsigned bits)
 #endif
 #endif
 
+// Lookup tables are generated by misc/sgu_lut.c on the MCU,
+// so no float code is linked in and nothing is computed at boot.
+#ifndef SGU_STATIC_LUT
+#ifdef SGU_ON_MCU
+#define SGU_STATIC_LUT 1
+#else
+#define SGU_STATIC_LUT 0
+#endif
+#endif
+
+#if SGU_STATIC_LUT
+#include "./sgu_lut.h"
+#else
 // precomputed waveforms (1024 samples each)
 static int16_t __attribute__((aligned(2)))
 __uninitialized_ram(sine_lut)[SGU_WAVEFORM_LENGTH];
@@ -81,9 +102,15 @@ __uninitialized_ram(sawtooth_lut)[SGU_WAVEFORM_LENGTH];
 // precomputed envelope attenuation to volume
 static uint16_t __attribute__((aligned(2)))
 __uninitialized_ram(env_gain_lut)[0x400];
-// Panning gain lookup tables
-static uint8_t __uninitialized_ram(pan_gain_lut_l)[256];
-static uint8_t __uninitialized_ram(pan_gain_lut_r)[256];
+// Panning gain lookup table, Q8 left gain in the low, right in the high halfword
+static uint32_t __uninitialized_ram(pan_gain_lut)[256];
+#endif
+
+// Use the Cortex-M33 DSP extension multiplies, emulated on the host.
+// 0 keeps the plain C arithmetic they replace, for comparison.
+#ifndef SGU_DSP
+#define SGU_DSP 1
+#endif
 
 static inline uint32_t sgu_clz32(uint32_t value)
 {
@@ -105,6 +132,79 @@ static inline uint32_t sgu_clz32(uint32_t value)
 #endif
 }
 
+//-------------------------------------------------
+//  pan_voice - scale a voice by the packed stereo
+//  gains; SMULWB/SMULWT of the doubled voice by a
+//  Q8 gain is exactly (voice * gain) >> 7
+//-------------------------------------------------
+static inline void pan_voice(int32_t voice, uint32_t gains, int32_t *out_l, int32_t *out_r)
+{
+#if SGU_DSP
+    *out_l = __builtin_arm_smulwb(voice * 2, (int32_t)gains);
+    *out_r = __builtin_arm_smulwt(voice * 2, (int32_t)gains);
+#else
+    *out_l = (voice * (int32_t)((gains >> 8) & 0xFF)) >> 7;
+    *out_r = (voice * (int32_t)(gains >> 24)) >> 7;
+#endif
+}
+
+//-------------------------------------------------
+//  pcm_next - position the channel plays after pos,
+//  following the loop; a finished one-shot holds
+//-------------------------------------------------
+static inline uint16_t pcm_next(const struct SGU_CH *ch_reg, uint16_t pos, bool loop)
+{
+    if (pos < ch_reg->pcmbnd)
+    {
+        ++pos;
+        if (pos != ch_reg->pcmbnd || !loop)
+            return pos;
+    }
+    else if (!loop)
+        return pos;
+    return ch_reg->pcmrst;
+}
+
+//-------------------------------------------------
+//  pcm_frac_mul - x scaled by the Q15 phase fraction
+//  and halved, a single SMULWB
+//-------------------------------------------------
+static inline int32_t pcm_frac_mul(int32_t x, int32_t frac)
+{
+#if SGU_DSP
+    return __builtin_arm_smulwb(x, frac);
+#else
+    return (int32_t)(((int64_t)x * frac) >> 16);
+#endif
+}
+
+//-------------------------------------------------
+//  pcm_interpolate - PCM sample at pcmpos plus the
+//  Q15 fraction, at the FM operator output scale;
+//  linear, or 4-point Catmull-Rom cubic in Horner
+//  form with three multiplies
+//-------------------------------------------------
+static inline int32_t pcm_interpolate(const int8_t *pcm, const struct SGU_CH *ch_reg, unsigned interp, int32_t frac)
+{
+    const bool loop = (ch_reg->flags1 & (SGU1_FLAGS1_PCM_LOOP | SGU1_FLAGS1_PCM_STREAM)) != 0;
+    const uint16_t pos = ch_reg->pcmpos;
+    const uint16_t next = pcm_next(ch_reg, pos, loop);
+    const int32_t s0 = pcm[pos] * 64;
+    const int32_t s1 = pcm[next] * 64;
+    if (interp == SGU1_INTERP_LINEAR)
+        return s0 + pcm_frac_mul((s1 - s0) * 2, frac);
+
+    const uint16_t prev = pos != ch_reg->pcmrst ? (uint16_t)(pos - 1)
+                          : loop                ? (uint16_t)(ch_reg->pcmbnd - 1)
+                                                : pos;
+    const int32_t sp = pcm[prev & (SGU_PCM_RAM_SIZE - 1)] * 64;
+    const int32_t s2 = pcm[pcm_next(ch_reg, next, loop)] * 64;
+    const int32_t a = 3 * (s0 - s1) + s2 - sp;
+    const int32_t b = 2 * sp - 5 * s0 + 4 * s1 - s2;
+    const int32_t c = s1 - sp;
+    return s0 + pcm_frac_mul(c + pcm_frac_mul((b + pcm_frac_mul(a * 2, frac)) * 2, frac), frac);
+}
+
 //-------------------------------------------------
 //  svf_saturate - cheap soft saturation for analog warmth
 //  Prevents harsh digital clipping, emulates analog op-amp behavior.
@@ -126,6 +226,14 @@ static const uint32_t EG_CLOCK_DIVIDER = 3;
 // "quiet" value, used to optimize when we can skip doing work
 static const uint32_t EG_QUIET = 0x380;
 
+// Operator phase steps and gains are evaluated on envelope clock and LFO
+// step samples, on key and frequency changes, and held in between. Other
+// register writes land up to EG_CLOCK_DIVIDER - 1 samples late.
+// 0 evaluates them every sample.
+#ifndef SGU_CONTROL_RATE
+#define SGU_CONTROL_RATE 1
+#endif
+
 //-------------------------------------------------
 //  opl_key_scale_atten - converts an
 //  OPL concatenated block (3 bits) and fnum
@@ -423,12 +531,15 @@ static void fm_channel_reset(struct sgu_ch_state *self, uint8_t ch)
 {
     // reset our data
     self->op_flags = 0; // clear all packed booleans
+    self->freq = 0;
     for (uint8_t op = 0; op < SGU_OP_PER_CH; op++)
     {
         phase_reset(self, ch, op);
         self->op[op].envelope_attenuation = 0x3ff;
         self->op[op].envelope_state = SGU_EG_RELEASE;
         self->op[op].eg_delay_counter = 0;
+        self->op[op].phase_step = 0;
+        self->op[op].gain = 0;
     }
 }
 
@@ -491,11 +602,20 @@ static inline void clock_envelope(struct sgu_ch_state *self, uint8_t op, uint8_t
 }
 
 //-------------------------------------------------
-//  clock_phase - clock the 10.10 phase value; the
-//  OPN version of the logic has been verified
-//  against the Nuked phase generator
+//  envelope_done - released all the way down;
+//  clocking the envelope no longer changes it
 //-------------------------------------------------
-static inline void clock_phase(struct sgu_ch_state *self, uint8_t op, uint8_t op_reg[], uint32_t ch_keycode, uint32_t ratio_base_step)
+static inline bool envelope_done(const struct sgu_op_state *os)
+{
+    return os->envelope_state == SGU_EG_RELEASE && os->envelope_attenuation == 0x3ff;
+}
+
+//-------------------------------------------------
+//  compute_phase_step - step of the 10.22 phase
+//  value; the OPN version of the logic has been
+//  verified against the Nuked phase generator
+//-------------------------------------------------
+static inline uint32_t compute_phase_step(uint8_t op_reg[], uint32_t ch_keycode, uint32_t ratio_base_step)
 {
     uint32_t phase_step;
     const uint8_t base = SGU_OP0_MUL(op_reg[0]);
@@ -514,9 +634,7 @@ static inline void clock_phase(struct sgu_ch_state *self, uint8_t op, uint8_t op
                                                       compute_multiplier(base),
                                                       scale);
     }
-
-    // finally apply the step to the current phase value
-    self->op[op].phase += phase_step;
+    return phase_step;
 }
 
 //-------------------------------------------------
@@ -572,6 +690,41 @@ static inline uint32_t attenuation_to_volume(uint32_t input)
     return s_power_table[input & 0xff] >> (input >> 8);
 }
 
+//-------------------------------------------------
+//  compute_gain - Q13 linear gain of the operator
+//  from envelope, LFO AM, total level and key
+//  scaling
+//-------------------------------------------------
+static inline uint16_t compute_gain(const struct sgu_op_state *os, uint8_t op_reg[], uint32_t lfo_am, uint32_t ksl_atten)
+{
+    // compute the effective attenuation of the envelope
+    uint32_t env_att = os->envelope_attenuation;
+
+    // add in LFO AM modulation (apply per-operator AM depth)
+    if (SGU_OP0_TRM(op_reg[0]))
+    {
+        uint32_t am_offset = lfo_am;
+        if (!SGU_OP6_TRMD(op_reg[6]))
+            am_offset >>= 2;
+        env_att += am_offset;
+    }
+
+    // add in total level, scaled by 8
+    env_att += SGU_OP16_TL(op_reg[1], op_reg[6]) << 3;
+
+    // add key scale level
+    const uint32_t ksl = SGU_OP1_KSL(op_reg[1]);
+    if (ksl)
+        env_att += ksl_atten << ksl;
+
+    // clamp to max (USAT: single-cycle unsigned saturate)
+    env_att = (uint32_t)__builtin_arm_usat((int32_t)env_att, 10);
+
+    // the attenuation from the envelope generator as a 4.6 value, shifted up to 4.8
+    // env_att <<= 2; shifting handled by the lookup table generator.
+    return env_gain_lut[env_att];
+}
+
 // -----------------------------------------------------------------------------
 // Generate one stereo sample (l,r) for the whole CHNS-channel chip.
 // Order per channel:
@@ -604,12 +757,16 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Setup(struct SGU *restric
         sgu->envelope_counter += 4 - EG_CLOCK_DIVIDER;
 
     // clock the global LFO (once per sample)
+    const int32_t lfo_raw_pm = sgu->cached_lfo_raw_pm;
+    const uint8_t lfo_am = sgu->lfo_am;
     sgu->cached_lfo_raw_pm = clock_lfo(
         &sgu->lfo_am_counter,
         &sgu->lfo_pm_counter,
         &sgu->lfo_am);
     sgu->cached_env_tick = ((sgu->envelope_counter & 3u) == 0u);
     sgu->cached_env_counter_tick = sgu->envelope_counter >> 2;
+    sgu->cached_control = !SGU_CONTROL_RATE || sgu->cached_env_tick
+                          || lfo_raw_pm != sgu->cached_lfo_raw_pm || lfo_am != sgu->lfo_am;
 }
 
 // ---------------------------------------------------------------------------
@@ -626,6 +783,7 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
 
     const int32_t lfo_raw_pm = sgu->cached_lfo_raw_pm;
     const bool env_tick = sgu->cached_env_tick;
+    const bool control = sgu->cached_control;
     const uint32_t env_counter_tick = sgu->cached_env_counter_tick;
 
     for (unsigned ch = ch_start; ch < ch_end; ch++)
@@ -641,7 +799,11 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
         if (ch_flags0 & SGU1_FLAGS0_PCM_MASK) // PCM mode
         {
             // Signed 8-bit PCM sample scaled to match FM operator output (~14-bit range).
-            ch_sample = (int16_t)sgu->pcm[ch_reg->pcmpos] << 6;
+            const unsigned interp = (ch_flags0 & SGU1_FLAGS0_INTERP_MASK) >> SGU1_FLAGS0_INTERP_SHIFT;
+            if (interp == SGU1_INTERP_NONE)
+                ch_sample = (int16_t)sgu->pcm[ch_reg->pcmpos] << 6;
+            else
+                ch_sample = pcm_interpolate(sgu->pcm, ch_reg, interp, sgu->pcm_phase_accum[ch]);
 
             // PCM phase accumulator. When it crosses 0x8000, advance sample position by 1.
             sgu->pcm_phase_accum[ch] += minval(ch_reg->freq, 0x8000);
@@ -658,29 +820,50 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
                     // If we hit the boundary exactly, loop if enabled.
                     if (ch_reg->pcmpos == ch_reg->pcmbnd)
                     {
-                        if (ch_reg->flags1 & SGU1_FLAGS1_PCM_LOOP)
+                        if (ch_reg->flags1 & (SGU1_FLAGS1_PCM_LOOP | SGU1_FLAGS1_PCM_STREAM))
                             ch_reg->pcmpos = ch_reg->pcmrst;
                     }
 
                     // Wrap to PCM RAM size (power-of-2 ring buffer).
                     ch_reg->pcmpos &= (SGU_PCM_RAM_SIZE - 1);
+
+                    // Entering either half of the ring frees the other one.
+                    if ((ch_reg->flags1 & SGU1_FLAGS1_PCM_STREAM)
+                        && (ch_reg->pcmpos == ch_reg->pcmrst
+                            || ch_reg->pcmpos == ch_reg->pcmrst + (uint16_t)(ch_reg->pcmbnd - ch_reg->pcmrst) / 2))
+                        ++sgu->pcm_halves[ch];
                 }
-                else if (ch_reg->flags1 & SGU1_FLAGS1_PCM_LOOP)
+                else if (ch_reg->flags1 & (SGU1_FLAGS1_PCM_LOOP | SGU1_FLAGS1_PCM_STREAM))
                 {
                     // If already at/over boundary and looping, force restart.
                     ch_reg->pcmpos = ch_reg->pcmrst;
                 }
             }
         }
+        else if (!key_live && sgu->silent[ch])
+        {
+            // Nothing to hear until the next key on. Phases hold where the
+            // channel went quiet, the rest of its state is already settled.
+            ch_state->op_flags &= ~(0xFu << OP_FLAGS_PHASE_WRAP);
+        }
         else
         {
+            bool silent = !key_live;
             uint32_t ch_keycode, block, fnum_4msb;
             freq16_decode(ch_freq, &ch_keycode, &block, &fnum_4msb);
             uint32_t ch_ksl_atten = opl_key_scale_atten(block, fnum_4msb);
-            const uint32_t phase_step_pm0 = sgu_phase_step_from_freq_clamped((int32_t)ch_freq);
-            const int32_t pm_mul = (int32_t)ch_freq * lfo_raw_pm;
-            const uint32_t phase_step_pm_half = sgu_phase_step_from_freq_clamped((int32_t)ch_freq + (pm_mul >> 11));
-            const uint32_t phase_step_pm_full = sgu_phase_step_from_freq_clamped((int32_t)ch_freq + (pm_mul >> 10));
+            // a note programmed before key on gets its steps from the start
+            const bool refresh_ch = control || ch_freq != ch_state->freq
+                                    || key_live != OP_FLAG_GET(ch_state->op_flags, OP_FLAGS_KEYON_GATE, 0);
+            ch_state->freq = ch_freq;
+            uint32_t phase_step_pm0 = 0, phase_step_pm_half = 0, phase_step_pm_full = 0;
+            if (refresh_ch)
+            {
+                phase_step_pm0 = sgu_phase_step_from_freq_clamped((int32_t)ch_freq);
+                const int32_t pm_mul = (int32_t)ch_freq * lfo_raw_pm;
+                phase_step_pm_half = sgu_phase_step_from_freq_clamped((int32_t)ch_freq + (pm_mul >> 11));
+                phase_step_pm_full = sgu_phase_step_from_freq_clamped((int32_t)ch_freq + (pm_mul >> 10));
+            }
 
             // run channel operators
             for (uint8_t op = 0; op < SGU_OP_PER_CH; op++)
@@ -720,8 +903,10 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
                     OP_FLAG_CLR(ch_state->op_flags, OP_FLAGS_KEYON_GATE, op);
 
                 // has the key changed?
+                bool refresh = refresh_ch;
                 if ((keystate ^ OP_FLAG_GET(ch_state->op_flags, OP_FLAGS_KEY_STATE, op)) != 0)
                 {
+                    refresh = true;
                     if (keystate)
                         OP_FLAG_SET(ch_state->op_flags, OP_FLAGS_KEY_STATE, op);
                     else
@@ -739,24 +924,24 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
                 const uint32_t phase_before = os->phase;
 
                 // clock the envelope (only on envelope ticks)
-                if (env_tick)
+                if (env_tick && !envelope_done(os))
                     clock_envelope(ch_state, op, op_reg, ch_keycode, env_counter_tick);
 
                 // handle phase reset due to SYNC (previous op wrap from last sample)
                 const unsigned prev_op = op ? (op - 1u) : (SGU_OP_PER_CH - 1u);
                 const bool sync_reset = (SGU_OP6_SYNC(op_reg[6]) && OP_FLAG_GET(ch_state->op_flags, OP_FLAGS_PHASE_WRAP, prev_op));
-                if (sync_reset)
-                {
-                    phase_reset(ch_state, ch, op);
-                }
-                else
+                if (refresh_ch)
                 {
-                    // clock the phase (apply per-operator PM depth)
+                    // apply per-operator PM depth
                     uint32_t ratio_base_step = phase_step_pm0;
                     if (SGU_OP0_VIB(op_reg[0]))
                         ratio_base_step = SGU_OP6_VIBD(op_reg[6]) ? phase_step_pm_full : phase_step_pm_half;
-                    clock_phase(ch_state, op, op_reg, ch_keycode, ratio_base_step);
+                    os->phase_step = compute_phase_step(op_reg, ch_keycode, ratio_base_step);
                 }
+                if (sync_reset)
+                    phase_reset(ch_state, ch, op);
+                else
+                    os->phase += os->phase_step;
 
                 // record wrap for next operator's SYNC
                 if (os->phase < phase_before)
@@ -942,32 +1127,11 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
                             sample = -sample;
                     }
 
-                    // compute the effective attenuation of the envelope
-                    uint32_t env_att = os->envelope_attenuation;
+                    // attenuation only moves on envelope clocks and key changes
+                    if (refresh)
+                        os->gain = compute_gain(os, op_reg, sgu->lfo_am, ch_ksl_atten);
 
-                    // add in LFO AM modulation (apply per-operator AM depth)
-                    if (SGU_OP0_TRM(op_reg[0]))
-                    {
-                        uint32_t am_offset = sgu->lfo_am;
-                        if (!SGU_OP6_TRMD(op_reg[6]))
-                            am_offset >>= 2;
-                        env_att += am_offset;
-                    }
-
-                    // add in total level, scaled by 8
-                    env_att += SGU_OP16_TL(op_reg[1], op_reg[6]) << 3;
-
-                    // add key scale level
-                    const uint32_t ksl = SGU_OP1_KSL(op_reg[1]);
-                    if (ksl)
-                        env_att += ch_ksl_atten << ksl;
-
-                    // clamp to max (USAT: single-cycle unsigned saturate)
-                    env_att = (uint32_t)__builtin_arm_usat((int32_t)env_att, 10);
-
-                    // the attenuation from the envelope generator as a 4.6 value, shifted up to 4.8
-                    // env_att <<= 2; shifting handled by the lookup table generator.
-                    const int32_t amp = sample * (int32_t)env_gain_lut[env_att];
+                    const int32_t amp = sample * (int32_t)os->gain;
                     // scale back to int16 range: divide by 2^13 (Q13 gain)
                     // and scale down 2 more to Q14 output range
                     // add 0.5 LSB for rounding before shifting (optional)
@@ -994,7 +1158,10 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
                 const unsigned out = SGU_OP7_OUT(op_reg[7]);
                 if (out)
                     ch_sample += ((int16_t)val) >> (7 - out);
+
+                silent = silent && envelope_done(os) && !os->value && !os->blep;
             }
+            sgu->silent[ch] = silent && !ch_state->op0_fb;
         }
 
         // ------------------------------------------------------------
@@ -1025,7 +1192,9 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
         // Resonant filter (state-variable filter)
         // flags0 bits 5..7 select which outputs to mix: LP/HP/BP.
         // ------------------------------------------------------------
-        if (ch_flags0 & (SGU1_FLAGS0_CTL_NSLOW | SGU1_FLAGS0_CTL_NSHIGH | SGU1_FLAGS0_CTL_NSBAND))
+        // Settled at zero with no input it would stay there.
+        if ((ch_flags0 & (SGU1_FLAGS0_CTL_NSLOW | SGU1_FLAGS0_CTL_NSHIGH | SGU1_FLAGS0_CTL_NSBAND))
+            && (voice_sample || sgu->svf_low[ch] || sgu->svf_band[ch]))
         {
             const int32_t ff = (int32_t)ch_reg->cutoff * 3;
 
@@ -1045,8 +1214,8 @@ void __attribute__((optimize("Ofast"))) SGU_NextSample_Channels(
         sgu->post[ch] = voice_sample;
 
         // Panning
-        int32_t out_l = (voice_sample * pan_gain_lut_l[(uint8_t)ch_reg->pan]) >> 7;
-        int32_t out_r = (voice_sample * pan_gain_lut_r[(uint8_t)ch_reg->pan]) >> 7;
+        int32_t out_l, out_r;
+        pan_voice(voice_sample, pan_gain_lut[(uint8_t)ch_reg->pan], &out_l, &out_r);
 
         // Sweeps (affect parameters for future samples)
         // (flags1 bit5).
@@ -1284,11 +1453,11 @@ void __attribute__((optimize("Ofast"))) SGU_Init(struct SGU *sgu, size_t sampleM
     (void)sampleMemSize;
     memset(sgu, 0, sizeof(struct SGU));
 
+#if !SGU_STATIC_LUT
     /**
      * Compute lookup tables.
      * NOTE: these are shared among all SGU instances,
      * but with exactly same values, so we compute them per-instance for simplicity.
-     * TODO: move to pre-computed static const tables.
      */
     for (int32_t i = 0; i < SGU_WAVEFORM_LENGTH; i++)
     {
@@ -1319,22 +1488,18 @@ void __attribute__((optimize("Ofast"))) SGU_Init(struct SGU *sgu, size_t sampleM
         env_gain_lut[i] = (uint16_t)attenuation_to_volume((uint32_t)i << 2);
     }
 
-    // Build pan gain lookup tables (same as su.c)
+    // Build pan gain lookup table (same as su.c)
     // Start with "center pan": both gains 127
-    for (size_t i = 0; i < 256; i++)
-    {
-        pan_gain_lut_l[i] = 127;
-        pan_gain_lut_r[i] = 127;
-    }
     // Pan shaping:
     // - For i=0..127: left gain decreases from 127->0 (panned right)
     // - For i=128..255: right gain increases from 0->126 (panned left)
-    for (size_t i = 0; i < 128; i++)
+    for (uint32_t i = 0; i < 256; i++)
     {
-        pan_gain_lut_l[i] = (uint8_t)(127 - i);
-        pan_gain_lut_r[128 + i] = (uint8_t)(i - 1);
+        const uint32_t gain_l = (i < 128) ? 127 - i : 127;
+        const uint32_t gain_r = (i < 128) ? 127 : (i == 128) ? 0 : i - 129;
+        pan_gain_lut[i] = (gain_r << 24) | (gain_l << 8);
     }
-    pan_gain_lut_r[128] = 0;
+#endif
 
 #ifdef SGU_ON_MCU
     // there can be only one…
@@ -1371,17 +1536,24 @@ void SGU_Reset(struct SGU *sgu)
 
         sgu->phase_reset_countdown[ch] = 0;
         sgu->pcm_phase_accum[ch] = 0;
+        sgu->pcm_halves[ch] = 0;
 
         sgu->src[ch] = 0;
         sgu->post[ch] = 0;
         sgu->outL[ch] = 0;
         sgu->outR[ch] = 0;
+        sgu->silent[ch] = false;
     }
 }
 
 void SGU_Write(struct SGU *sgu, uint16_t addr13, uint8_t data)
 {
-    ((uint8_t *)sgu->chan)[addr13] = data;
+    uint8_t *reg = &((uint8_t *)sgu->chan)[addr13];
+    // the host counts ring halves from the start of a stream
+    if ((addr13 & (SGU_REGS_PER_CH - 1)) == offsetof(struct SGU_CH, flags1)
+        && (data & ~*reg & SGU1_FLAGS1_PCM_STREAM))
+        sgu->pcm_halves[addr13 / SGU_REGS_PER_CH] = 0;
+    *reg = data;
 }
 
 static_assert(sizeof(struct SGU_CH) == (SGU_OP_PER_CH * SGU_OP_REGS + SGU_CH_REGS), "SGU channel size mismatch");
@@ -317,6 +317,8 @@ Additional WAVE form related parameter (per-operator, 4 bits)
 
 // channel control bits
 #define SGU1_FLAGS0_CTL_GATE      (1 << 0)
+#define SGU1_FLAGS0_INTERP_SHIFT  (1)
+#define SGU1_FLAGS0_INTERP_MASK   (0x3 << SGU1_FLAGS0_INTERP_SHIFT)
 #define SGU1_FLAGS0_PCM_SHIFT     (3)
 #define SGU1_FLAGS0_PCM_MASK      (0x1 << SGU1_FLAGS0_PCM_SHIFT)
 #define SGU1_FLAGS0_CONTROL_SHIFT (4)
@@ -326,6 +328,11 @@ Additional WAVE form related parameter (per-operator, 4 bits)
 #define SGU1_FLAGS0_CTL_NSHIGH    (1 << 6)
 #define SGU1_FLAGS0_CTL_NSBAND    (1 << 7)
 
+// PCM interpolation, flags0 bits 1-2
+#define SGU1_INTERP_NONE   (0) // nearest sample
+#define SGU1_INTERP_LINEAR (1)
+#define SGU1_INTERP_CUBIC  (2) // 4-point Catmull-Rom, 3 too
+
 #define SGU1_FLAGS1_PHASE_RESET        (1 << 0)
 #define SGU1_FLAGS1_FILTER_PHASE_RESET (1 << 1)
 #define SGU1_FLAGS1_PCM_LOOP           (1 << 2)
@@ -333,6 +340,7 @@ Additional WAVE form related parameter (per-operator, 4 bits)
 #define SGU1_FLAGS1_FREQ_SWEEP         (1 << 4)
 #define SGU1_FLAGS1_VOL_SWEEP          (1 << 5)
 #define SGU1_FLAGS1_CUT_SWEEP          (1 << 6)
+#define SGU1_FLAGS1_PCM_STREAM         (1 << 7)
 
 // -----------------------------------------------------------------------------
 // Notes on behavior (implementation-level, not register-level)
@@ -440,6 +448,8 @@ struct SGU_CH
     // flags0:
     //  - bit 0: (GATE) ADSR envelope is running when set; key-on/key-off,
     //    rising edge is starting the envelope generator and resetting the signal phase.
+    //  - bits 1..2: PCM interpolation between pcmpos and the samples around it
+    //    at the fractional phase: nearest, linear or cubic (SGU1_INTERP_*)
     //  - bit 3: PCM enable (when set, src = pcm[pcmpos])
     //  - bit 4: ring mod enable (multiply by next channel's raw sample)
     //  - bits 5..7: filter mode selects (LP/HP/BP) (implemented as bitmask picks)
@@ -452,6 +462,8 @@ struct SGU_CH
     //  - bit 4: freq sweep enable
     //  - bit 5: vol sweep enable
     //  - bit 6: cutoff sweep enable
+    //  - bit 7: PCM stream, loops like bit 2 and counts the ring halves
+    //    (pcmrst..midpoint, midpoint..pcmbnd) played for the host to refill
     uint8_t flags1;
 
     // cutoff: filter cutoff control (scaled to ff inside filter section).
@@ -504,14 +516,16 @@ struct SGU_CH
     uint8_t special2;
 };
 
-// Per-operator state, packed for cache locality (20 bytes per operator)
+// Per-operator state, packed for cache locality (28 bytes per operator)
 struct sgu_op_state
 {
     uint32_t phase;                     // current phase value (10.22 format)
+    uint32_t phase_step;                // phase step, updated at control rate
     int16_t value;                      // current operator value
     uint16_t envelope_attenuation;      // computed envelope attenuation (4.6 format)
     uint16_t eg_delay_counter;          // delay counter (samples)
     uint16_t blep_frac;                 // fractional phase at edge (for sub-sample interpolation)
+    uint16_t gain;                      // Q13 linear gain, updated at control rate
     int16_t blep_prev_sample;           // previous raw sample for edge detection
     enum envelope_state envelope_state; // current envelope state
     uint8_t blep;                       // BLEP damping after dramatic phase changes
@@ -550,12 +564,14 @@ struct SGU
     {
         int16_t op0_fb;                        // feedback memory for first operator
         uint16_t op_flags;                     // packed boolean flags (see OP_FLAGS_*)
+        uint16_t freq;                         // frequency the phase steps are from
         struct sgu_op_state op[SGU_OP_PER_CH]; // per-operator state (AoS layout)
     } m_channel[SGU_CHNS];
 
     // Cached per-sample globals (written by Setup, read by both cores)
     int32_t cached_lfo_raw_pm;
     bool cached_env_tick;
+    bool cached_control; // envelope or LFO step: evaluate operator controls
     uint32_t cached_env_counter_tick;
 
     // src[i] = raw oscillator sample for channel i (16-bit, used for ring mod).
@@ -589,12 +605,20 @@ struct SGU
     // PCM phase accumulator for fractional PCM playback
     int32_t pcm_phase_accum[SGU_CHNS];
 
+    // Ring halves played by PCM stream channels, modulo 256.
+    // Zeroed when the stream flag is set.
+    uint8_t pcm_halves[SGU_CHNS];
+
     // PCM sample memory (signed 8-bit)
     int8_t *pcm;
 
     // Per-channel mute (software-side, not part of chip spec).
     bool muted[SGU_CHNS];
 
+    // Channel keyed off with all operators released to full attenuation
+    // and output settled at zero, skipped until the next key on.
+    bool silent[SGU_CHNS];
+
     // ========================================================================
     // REGISTER MAP (must be contiguous for SGU_Write)
     // SGU_Write does: ((uint8_t *)sgu->chan)[addr13] = data;
@@ -0,0 +1,561 @@
+// Generated by misc/sgu_lut.c, do not edit.
+
+static const int16_t __attribute__((aligned(4))) sine_lut[1024] = {
+         0,    201,    402,    604,    805,   1007,   1208,   1409,
+      1610,   1812,   2013,   2214,   2415,   2616,   2816,   3017,
+      3217,   3418,   3618,   3818,   4018,   4218,   4418,   4617,
+      4817,   5016,   5215,   5414,   5612,   5811,   6009,   6207,
+      6404,   6602,   6799,   6996,   7193,   7389,   7585,   7781,
+      7976,   8172,   8367,   8561,   8756,   8950,   9143,   9336,
+      9529,   9722,   9914,  10106,  10297,  10488,  10679,  10869,
+     11059,  11249,  11438,  11626,  11814,  12002,  12189,  12376,
+     12562,  12748,  12933,  13118,  13302,  13486,  13670,  13853,
+     14035,  14217,  14398,  14578,  14759,  14938,  15117,  15296,
+     15474,  15651,  15827,  16004,  16179,  16354,  16528,  16702,
+     16875,  17047,  17219,  17390,  17560,  17730,  17899,  18068,
+     18235,  18402,  18569,  18734,  18899,  19063,  19227,  19390,
+     19552,  19713,  19873,  20033,  20192,  20351,  20508,  20665,
+     20821,  20976,  21130,  21284,  21437,  21589,  21740,  21890,
+     22039,  22188,  22336,  22483,  22629,  22774,  22919,  23062,
+     23205,  23347,  23488,  23628,  23767,  23905,  24042,  24179,
+     24314,  24449,  24582,  24715,  24847,  24978,  25108,  25237,
+     25365,  25492,  25618,  25743,  25867,  25990,  26112,  26234,
+     26354,  26473,  26591,  26708,  26825,  26940,  27054,  27167,
+     27279,  27390,  27500,  27609,  27717,  27824,  27930,  28035,
+     28139,  28241,  28343,  28443,  28543,  28641,  28739,  28835,
+     28930,  29024,  29117,  29209,  29300,  29389,  29478,  29565,
+     29651,  29737,  29821,  29904,  29985,  30066,  30145,  30224,
+     30301,  30377,  30452,  30526,  30599,  30670,  30740,  30810,
+     30877,  30944,  31010,  31074,  31138,  31200,  31261,  31321,
+     31379,  31437,  31493,  31548,  31602,  31654,  31706,  31756,
+     31805,  31853,  31900,  31945,  31989,  32032,  32074,  32115,
+     32154,  32192,  32229,  32265,  32299,  32333,  32365,  32395,
+     32425,  32454,  32481,  32507,  32531,  32555,  32577,  32598,
+     32618,  32636,  32654,  32670,  32685,  32698,  32711,  32722,
+     32732,  32740,  32748,  32754,  32759,  32763,  32765,  32766,
+     32766,  32765,  32763,  32759,  32754,  32748,  32740,  32732,
+     32722,  32711,  32698,  32685,  32670,  32654,  32636,  32618,
+     32598,  32577,  32555,  32531,  32507,  32481,  32454,  32425,
+     32395,  32365,  32333,  32299,  32265,  32229,  32192,  32154,
+     32115,  32074,  32032,  31989,  31945,  31900,  31853,  31805,
+     31756,  31706,  31654,  31602,  31548,  31493,  31437,  31379,
+     31321,  31261,  31200,  31138,  31074,  31010,  30944,  30877,
+     30810,  30740,  30670,  30599,  30526,  30452,  30377,  30301,
+     30224,  30145,  30066,  29985,  29904,  29821,  29737,  29651,
+     29565,  29478,  29389,  29300,  29209,  29117,  29024,  28930,
+     28835,  28739,  28641,  28543,  28443,  28343,  28241,  28139,
+     28035,  27930,  27824,  27717,  27609,  27500,  27390,  27279,
+     27167,  27054,  26940,  26825,  26708,  26591,  26473,  26354,
+     26234,  26112,  25990,  25867,  25743,  25618,  25492,  25365,
+     25237,  25108,  24978,  24847,  24715,  24582,  24449,  24314,
+     24179,  24042,  23905,  23767,  23628,  23488,  23347,  23205,
+     23062,  22919,  22774,  22629,  22483,  22336,  22188,  22039,
+     21890,  21740,  21589,  21437,  21284,  21130,  20976,  20821,
+     20665,  20508,  20351,  20192,  20033,  19873,  19713,  19552,
+     19390,  19227,  19063,  18899,  18734,  18569,  18402,  18235,
+     18068,  17899,  17730,  17560,  17390,  17219,  17047,  16875,
+     16702,  16528,  16354,  16179,  16004,  15827,  15651,  15474,
+     15296,  15117,  14938,  14759,  14578,  14398,  14217,  14035,
+     13853,  13670,  13486,  13302,  13118,  12933,  12748,  12562,
+     12376,  12189,  12002,  11814,  11626,  11438,  11249,  11059,
+     10869,  10679,  10488,  10297,  10106,   9914,   9722,   9529,
+      9336,   9143,   8950,   8756,   8561,   8367,   8172,   7976,
+      7781,   7585,   7389,   7193,   6996,   6799,   6602,   6404,
+      6207,   6009,   5811,   5612,   5414,   5215,   5016,   4817,
+      4617,   4418,   4218,   4018,   3818,   3618,   3418,   3217,
+      3017,   2816,   2616,   2415,   2214,   2013,   1812,   1610,
+      1409,   1208,   1007,    805,    604,    402,    201,      0,
+         0,   -201,   -402,   -604,   -805,  -1007,  -1208,  -1409,
+     -1610,  -1812,  -2013,  -2214,  -2415,  -2616,  -2816,  -3017,
+     -3217,  -3418,  -3618,  -3818,  -4018,  -4218,  -4418,  -4617,
+     -4817,  -5016,  -5215,  -5414,  -5612,  -5811,  -6009,  -6207,
+     -6404,  -6602,  -6799,  -6996,  -7193,  -7389,  -7585,  -7781,
+     -7976,  -8172,  -8367,  -8561,  -8756,  -8950,  -9143,  -9336,
+     -9529,  -9722,  -9914, -10106, -10297, -10488, -10679, -10869,
+    -11059, -11249, -11438, -11626, -11814, -12002, -12189, -12376,
+    -12562, -12748, -12933, -13118, -13302, -13486, -13670, -13853,
+    -14035, -14217, -14398, -14578, -14759, -14938, -15117, -15296,
+    -15474, -15651, -15827, -16004, -16179, -16354, -16528, -16702,
+    -16875, -17047, -17219, -17390, -17560, -17730, -17899, -18068,
+    -18235, -18402, -18569, -18734, -18899, -19063, -19227, -19390,
+    -19552, -19713, -19873, -20033, -20192, -20351, -20508, -20665,
+    -20821, -20976, -21130, -21284, -21437, -21589, -21740, -21890,
+    -22039, -22188, -22336, -22483, -22629, -22774, -22919, -23062,
+    -23205, -23347, -23488, -23628, -23767, -23905, -24042, -24179,
+    -24314, -24449, -24582, -24715, -24847, -24978, -25108, -25237,
+    -25365, -25492, -25618, -25743, -25867, -25990, -26112, -26234,
+    -26354, -26473, -26591, -26708, -26825, -26940, -27054, -27167,
+    -27279, -27390, -27500, -27609, -27717, -27824, -27930, -28035,
+    -28139, -28241, -28343, -28443, -28543, -28641, -28739, -28835,
+    -28930, -29024, -29117, -29209, -29300, -29389, -29478, -29565,
+    -29651, -29737, -29821, -29904, -29985, -30066, -30145, -30224,
+    -30301, -30377, -30452, -30526, -30599, -30670, -30740, -30810,
+    -30877, -30944, -31010, -31074, -31138, -31200, -31261, -31321,
+    -31379, -31437, -31493, -31548, -31602, -31654, -31706, -31756,
+    -31805, -31853, -31900, -31945, -31989, -32032, -32074, -32115,
+    -32154, -32192, -32229, -32265, -32299, -32333, -32365, -32395,
+    -32425, -32454, -32481, -32507, -32531, -32555, -32577, -32598,
+    -32618, -32636, -32654, -32670, -32685, -32698, -32711, -32722,
+    -32732, -32740, -32748, -32754, -32759, -32763, -32765, -32766,
+    -32766, -32765, -32763, -32759, -32754, -32748, -32740, -32732,
+    -32722, -32711, -32698, -32685, -32670, -32654, -32636, -32618,
+    -32598, -32577, -32555, -32531, -32507, -32481, -32454, -32425,
+    -32395, -32365, -32333, -32299, -32265, -32229, -32192, -32154,
+    -32115, -32074, -32032, -31989, -31945, -31900, -31853, -31805,
+    -31756, -31706, -31654, -31602, -31548, -31493, -31437, -31379,
+    -31321, -31261, -31200, -31138, -31074, -31010, -30944, -30877,
+    -30810, -30740, -30670, -30599, -30526, -30452, -30377, -30301,
+    -30224, -30145, -30066, -29985, -29904, -29821, -29737, -29651,
+    -29565, -29478, -29389, -29300, -29209, -29117, -29024, -28930,
+    -28835, -28739, -28641, -28543, -28443, -28343, -28241, -28139,
+    -28035, -27930, -27824, -27717, -27609, -27500, -27390, -27279,
+    -27167, -27054, -26940, -26825, -26708, -26591, -26473, -26354,
+    -26234, -26112, -25990, -25867, -25743, -25618, -25492, -25365,
+    -25237, -25108, -24978, -24847, -24715, -24582, -24449, -24314,
+    -24179, -24042, -23905, -23767, -23628, -23488, -23347, -23205,
+    -23062, -22919, -22774, -22629, -22483, -22336, -22188, -22039,
+    -21890, -21740, -21589, -21437, -21284, -21130, -20976, -20821,
+    -20665, -20508, -20351, -20192, -20033, -19873, -19713, -19552,
+    -19390, -19227, -19063, -18899, -18734, -18569, -18402, -18235,
+    -18068, -17899, -17730, -17560, -17390, -17219, -17047, -16875,
+    -16702, -16528, -16354, -16179, -16004, -15827, -15651, -15474,
+    -15296, -15117, -14938, -14759, -14578, -14398, -14217, -14035,
+    -13853, -13670, -13486, -13302, -13118, -12933, -12748, -12562,
+    -12376, -12189, -12002, -11814, -11626, -11438, -11249, -11059,
+    -10869, -10679, -10488, -10297, -10106,  -9914,  -9722,  -9529,
+     -9336,  -9143,  -8950,  -8756,  -8561,  -8367,  -8172,  -7976,
+     -7781,  -7585,  -7389,  -7193,  -6996,  -6799,  -6602,  -6404,
+     -6207,  -6009,  -5811,  -5612,  -5414,  -5215,  -5016,  -4817,
+     -4617,  -4418,  -4218,  -4018,  -3818,  -3618,  -3418,  -3217,
+     -3017,  -2816,  -2616,  -2415,  -2214,  -2013,  -1812,  -1610,
+     -1409,  -1208,  -1007,   -805,   -604,   -402,   -201,      0,
+};
+
+static const int16_t __attribute__((aligned(4))) triangle_lut[1024] = {
+         0,    128,    256,    385,    513,    642,    770,    899,
+      1027,   1156,   1284,   1413,   1541,   1670,   1798,   1927,
+      2055,   2184,   2312,   2441,   2569,   2698,   2826,   2955,
+      3083,   3212,   3340,   3469,   3597,   3726,   3854,   3983,
+      4111,   4240,   4368,   4497,   4625,   4754,   4882,   5011,
+      5139,   5268,   5396,   5525,   5653,   5782,   5910,   6039,
+      6167,   6296,   6424,   6553,   6681,   6810,   6938,   7067,
+      7195,   7324,   7452,   7581,   7709,   7838,   7966,   8095,
+      8223,   8352,   8480,   8609,   8737,   8866,   8994,   9123,
+      9251,   9380,   9508,   9637,   9765,   9894,  10022,  10151,
+     10279,  10408,  10536,  10665,  10793,  10922,  11050,  11179,
+     11307,  11436,  11564,  11693,  11821,  11950,  12078,  12207,
+     12335,  12464,  12592,  12721,  12849,  12978,  13106,  13235,
+     13363,  13492,  13620,  13749,  13877,  14006,  14134,  14263,
+     14391,  14520,  14648,  14777,  14905,  15034,  15162,  15291,
+     15419,  15548,  15676,  15805,  15933,  16062,  16190,  16319,
+     16447,  16576,  16704,  16833,  16961,  17090,  17218,  17347,
+     17475,  17604,  17732,  17861,  17989,  18118,  18246,  18375,
+     18503,  18632,  18760,  18889,  19017,  19146,  19274,  19403,
+     19531,  19660,  19788,  19917,  20045,  20174,  20302,  20431,
+     20559,  20688,  20816,  20945,  21073,  21202,  21330,  21459,
+     21587,  21716,  21844,  21973,  22101,  22230,  22358,  22487,
+     22615,  22744,  22872,  23001,  23129,  23258,  23386,  23515,
+     23643,  23772,  23900,  24029,  24157,  24286,  24414,  24543,
+     24671,  24800,  24928,  25057,  25185,  25314,  25442,  25571,
+     25699,  25828,  25956,  26085,  26213,  26342,  26470,  26599,
+     26727,  26856,  26984,  27113,  27241,  27370,  27498,  27627,
+     27755,  27884,  28012,  28141,  28269,  28398,  28526,  28655,
+     28783,  28912,  29040,  29169,  29297,  29426,  29554,  29683,
+     29811,  29940,  30068,  30197,  30325,  30454,  30582,  30711,
+     30839,  30968,  31096,  31225,  31353,  31482,  31610,  31739,
+     31867,  31996,  32124,  32253,  32381,  32510,  32638,  32767,
+     32767,  32639,  32511,  32382,  32254,  32125,  31997,  31868,
+     31740,  31611,  31483,  31354,  31226,  31097,  30969,  30840,
+     30712,  30583,  30455,  30326,  30198,  30069,  29941,  29812,
+     29684,  29555,  29427,  29298,  29170,  29041,  28913,  28784,
+     28656,  28527,  28399,  28270,  28142,  28013,  27885,  27756,
+     27628,  27499,  27371,  27242,  27114,  26985,  26857,  26728,
+     26600,  26471,  26343,  26214,  26086,  25957,  25829,  25700,
+     25572,  25443,  25315,  25186,  25058,  24929,  24801,  24672,
+     24544,  24415,  24287,  24158,  24030,  23901,  23773,  23644,
+     23516,  23387,  23259,  23130,  23002,  22873,  22745,  22616,
+     22488,  22359,  22231,  22102,  21974,  21845,  21717,  21588,
+     21460,  21331,  21203,  21074,  20946,  20817,  20689,  20560,
+     20432,  20303,  20175,  20046,  19918,  19789,  19661,  19532,
+     19404,  19275,  19147,  19018,  18890,  18761,  18633,  18504,
+     18376,  18247,  18119,  17990,  17862,  17733,  17605,  17476,
+     17348,  17219,  17091,  16962,  16834,  16705,  16577,  16448,
+     16320,  16191,  16063,  15934,  15806,  15677,  15549,  15420,
+     15292,  15163,  15035,  14906,  14778,  14649,  14521,  14392,
+     14264,  14135,  14007,  13878,  13750,  13621,  13493,  13364,
+     13236,  13107,  12979,  12850,  12722,  12593,  12465,  12336,
+     12208,  12079,  11951,  11822,  11694,  11565,  11437,  11308,
+     11180,  11051,  10923,  10794,  10666,  10537,  10409,  10280,
+     10152,  10023,   9895,   9766,   9638,   9509,   9381,   9252,
+      9124,   8995,   8867,   8738,   8610,   8481,   8353,   8224,
+      8096,   7967,   7839,   7710,   7582,   7453,   7325,   7196,
+      7068,   6939,   6811,   6682,   6554,   6425,   6297,   6168,
+      6040,   5911,   5783,   5654,   5526,   5397,   5269,   5140,
+      5012,   4883,   4755,   4626,   4498,   4369,   4241,   4112,
+      3984,   3855,   3727,   3598,   3470,   3341,   3213,   3084,
+      2956,   2827,   2699,   2570,   2442,   2313,   2185,   2056,
+      1928,   1799,   1671,   1542,   1414,   1285,   1157,   1028,
+       900,    771,    643,    514,    386,    257,    129,      0,
+         0,   -128,   -256,   -385,   -513,   -642,   -770,   -899,
+     -1027,  -1156,  -1284,  -1413,  -1541,  -1670,  -1798,  -1927,
+     -2055,  -2184,  -2312,  -2441,  -2569,  -2698,  -2826,  -2955,
+     -3083,  -3212,  -3340,  -3469,  -3597,  -3726,  -3854,  -3983,
+     -4111,  -4240,  -4368,  -4497,  -4625,  -4754,  -4882,  -5011,
+     -5139,  -5268,  -5396,  -5525,  -5653,  -5782,  -5910,  -6039,
+     -6167,  -6296,  -6424,  -6553,  -6681,  -6810,  -6938,  -7067,
+     -7195,  -7324,  -7452,  -7581,  -7709,  -7838,  -7966,  -8095,
+     -8223,  -8352,  -8480,  -8609,  -8737,  -8866,  -8994,  -9123,
+     -9251,  -9380,  -9508,  -9637,  -9765,  -9894, -10022, -10151,
+    -10279, -10408, -10536, -10665, -10793, -10922, -11050, -11179,
+    -11307, -11436, -11564, -11693, -11821, -11950, -12078, -12207,
+    -12335, -12464, -12592, -12721, -12849, -12978, -13106, -13235,
+    -13363, -13492, -13620, -13749, -13877, -14006, -14134, -14263,
+    -14391, -14520, -14648, -14777, -14905, -15034, -15162, -15291,
+    -15419, -15548, -15676, -15805, -15933, -16062, -16190, -16319,
+    -16447, -16576, -16704, -16833, -16961, -17090, -17218, -17347,
+    -17475, -17604, -17732, -17861, -17989, -18118, -18246, -18375,
+    -18503, -18632, -18760, -18889, -19017, -19146, -19274, -19403,
+    -19531, -19660, -19788, -19917, -20045, -20174, -20302, -20431,
+    -20559, -20688, -20816, -20945, -21073, -21202, -21330, -21459,
+    -21587, -21716, -21844, -21973, -22101, -22230, -22358, -22487,
+    -22615, -22744, -22872, -23001, -23129, -23258, -23386, -23515,
+    -23643, -23772, -23900, -24029, -24157, -24286, -24414, -24543,
+    -24671, -24800, -24928, -25057, -25185, -25314, -25442, -25571,
+    -25699, -25828, -25956, -26085, -26213, -26342, -26470, -26599,
+    -26727, -26856, -26984, -27113, -27241, -27370, -27498, -27627,
+    -27755, -27884, -28012, -28141, -28269, -28398, -28526, -28655,
+    -28783, -28912, -29040, -29169, -29297, -29426, -29554, -29683,
+    -29811, -29940, -30068, -30197, -30325, -30454, -30582, -30711,
+    -30839, -30968, -31096, -31225, -31353, -31482, -31610, -31739,
+    -31867, -31996, -32124, -32253, -32381, -32510, -32638, -32767,
+    -32768, -32640, -32512, -32383, -32255, -32126, -31998, -31869,
+    -31741, -31612, -31484, -31355, -31227, -31098, -30970, -30841,
+    -30713, -30584, -30456, -30327, -30199, -30070, -29942, -29813,
+    -29685, -29556, -29428, -29299, -29171, -29042, -28914, -28785,
+    -28657, -28528, -28400, -28271, -28143, -28014, -27886, -27757,
+    -27629, -27500, -27372, -27243, -27115, -26986, -26858, -26729,
+    -26601, -26472, -26344, -26215, -26087, -25958, -25830, -25701,
+    -25573, -25444, -25316, -25187, -25059, -24930, -24802, -24673,
+    -24545, -24416, -24288, -24159, -24031, -23902, -23774, -23645,
+    -23517, -23388, -23260, -23131, -23003, -22874, -22746, -22617,
+    -22489, -22360, -22232, -22103, -21975, -21846, -21718, -21589,
+    -21461, -21332, -21204, -21075, -20947, -20818, -20690, -20561,
+    -20433, -20304, -20176, -20047, -19919, -19790, -19662, -19533,
+    -19405, -19276, -19148, -19019, -18891, -18762, -18634, -18505,
+    -18377, -18248, -18120, -17991, -17863, -17734, -17606, -17477,
+    -17349, -17220, -17092, -16963, -16835, -16706, -16578, -16449,
+    -16321, -16192, -16064, -15935, -15807, -15678, -15550, -15421,
+    -15293, -15164, -15036, -14907, -14779, -14650, -14522, -14393,
+    -14265, -14136, -14008, -13879, -13751, -13622, -13494, -13365,
+    -13237, -13108, -12980, -12851, -12723, -12594, -12466, -12337,
+    -12209, -12080, -11952, -11823, -11695, -11566, -11438, -11309,
+    -11181, -11052, -10924, -10795, -10667, -10538, -10410, -10281,
+    -10153, -10024,  -9896,  -9767,  -9639,  -9510,  -9382,  -9253,
+     -9125,  -8996,  -8868,  -8739,  -8611,  -8482,  -8354,  -8225,
+     -8097,  -7968,  -7840,  -7711,  -7583,  -7454,  -7326,  -7197,
+     -7069,  -6940,  -6812,  -6683,  -6555,  -6426,  -6298,  -6169,
+     -6041,  -5912,  -5784,  -5655,  -5527,  -5398,  -5270,  -5141,
+     -5013,  -4884,  -4756,  -4627,  -4499,  -4370,  -4242,  -4113,
+     -3985,  -3856,  -3728,  -3599,  -3471,  -3342,  -3214,  -3085,
+     -2957,  -2828,  -2700,  -2571,  -2443,  -2314,  -2186,  -2057,
+     -1929,  -1800,  -1672,  -1543,  -1415,  -1286,  -1158,  -1029,
+      -901,   -772,   -644,   -515,   -387,   -258,   -130,     -1,
+};
+
+static const int16_t __attribute__((aligned(4))) sawtooth_lut[1024] = {
+    -32768, -32704, -32640, -32576, -32512, -32448, -32384, -32320,
+    -32256, -32192, -32128, -32064, -32000, -31936, -31872, -31808,
+    -31744, -31679, -31615, -31551, -31487, -31423, -31359, -31295,
+    -31231, -31167, -31103, -31039, -30975, -30911, -30847, -30783,
+    -30719, -30654, -30590, -30526, -30462, -30398, -30334, -30270,
+    -30206, -30142, -30078, -30014, -29950, -29886, -29822, -29758,
+    -29694, -29629, -29565, -29501, -29437, -29373, -29309, -29245,
+    -29181, -29117, -29053, -28989, -28925, -28861, -28797, -28733,
+    -28669, -28604, -28540, -28476, -28412, -28348, -28284, -28220,
+    -28156, -28092, -28028, -27964, -27900, -27836, -27772, -27708,
+    -27644, -27580, -27515, -27451, -27387, -27323, -27259, -27195,
+    -27131, -27067, -27003, -26939, -26875, -26811, -26747, -26683,
+    -26619, -26555, -26490, -26426, -26362, -26298, -26234, -26170,
+    -26106, -26042, -25978, -25914, -25850, -25786, -25722, -25658,
+    -25594, -25530, -25465, -25401, -25337, -25273, -25209, -25145,
+    -25081, -25017, -24953, -24889, -24825, -24761, -24697, -24633,
+    -24569, -24505, -24440, -24376, -24312, -24248, -24184, -24120,
+    -24056, -23992, -23928, -23864, -23800, -23736, -23672, -23608,
+    -23544, -23480, -23416, -23351, -23287, -23223, -23159, -23095,
+    -23031, -22967, -22903, -22839, -22775, -22711, -22647, -22583,
+    -22519, -22455, -22391, -22326, -22262, -22198, -22134, -22070,
+    -22006, -21942, -21878, -21814, -21750, -21686, -21622, -21558,
+    -21494, -21430, -21366, -21301, -21237, -21173, -21109, -21045,
+    -20981, -20917, -20853, -20789, -20725, -20661, -20597, -20533,
+    -20469, -20405, -20341, -20276, -20212, -20148, -20084, -20020,
+    -19956, -19892, -19828, -19764, -19700, -19636, -19572, -19508,
+    -19444, -19380, -19316, -19252, -19187, -19123, -19059, -18995,
+    -18931, -18867, -18803, -18739, -18675, -18611, -18547, -18483,
+    -18419, -18355, -18291, -18227, -18162, -18098, -18034, -17970,
+    -17906, -17842, -17778, -17714, -17650, -17586, -17522, -17458,
+    -17394, -17330, -17266, -17202, -17137, -17073, -17009, -16945,
+    -16881, -16817, -16753, -16689, -16625, -16561, -16497, -16433,
+    -16369, -16305, -16241, -16177, -16112, -16048, -15984, -15920,
+    -15856, -15792, -15728, -15664, -15600, -15536, -15472, -15408,
+    -15344, -15280, -15216, -15152, -15088, -15023, -14959, -14895,
+    -14831, -14767, -14703, -14639, -14575, -14511, -14447, -14383,
+    -14319, -14255, -14191, -14127, -14063, -13998, -13934, -13870,
+    -13806, -13742, -13678, -13614, -13550, -13486, -13422, -13358,
+    -13294, -13230, -13166, -13102, -13038, -12973, -12909, -12845,
+    -12781, -12717, -12653, -12589, -12525, -12461, -12397, -12333,
+    -12269, -12205, -12141, -12077, -12013, -11948, -11884, -11820,
+    -11756, -11692, -11628, -11564, -11500, -11436, -11372, -11308,
+    -11244, -11180, -11116, -11052, -10988, -10923, -10859, -10795,
+    -10731, -10667, -10603, -10539, -10475, -10411, -10347, -10283,
+    -10219, -10155, -10091, -10027,  -9963,  -9899,  -9834,  -9770,
+     -9706,  -9642,  -9578,  -9514,  -9450,  -9386,  -9322,  -9258,
+     -9194,  -9130,  -9066,  -9002,  -8938,  -8874,  -8809,  -8745,
+     -8681,  -8617,  -8553,  -8489,  -8425,  -8361,  -8297,  -8233,
+     -8169,  -8105,  -8041,  -7977,  -7913,  -7849,  -7784,  -7720,
+     -7656,  -7592,  -7528,  -7464,  -7400,  -7336,  -7272,  -7208,
+     -7144,  -7080,  -7016,  -6952,  -6888,  -6824,  -6759,  -6695,
+     -6631,  -6567,  -6503,  -6439,  -6375,  -6311,  -6247,  -6183,
+     -6119,  -6055,  -5991,  -5927,  -5863,  -5799,  -5735,  -5670,
+     -5606,  -5542,  -5478,  -5414,  -5350,  -5286,  -5222,  -5158,
+     -5094,  -5030,  -4966,  -4902,  -4838,  -4774,  -4710,  -4645,
+     -4581,  -4517,  -4453,  -4389,  -4325,  -4261,  -4197,  -4133,
+     -4069,  -4005,  -3941,  -3877,  -3813,  -3749,  -3685,  -3620,
+     -3556,  -3492,  -3428,  -3364,  -3300,  -3236,  -3172,  -3108,
+     -3044,  -2980,  -2916,  -2852,  -2788,  -2724,  -2660,  -2595,
+     -2531,  -2467,  -2403,  -2339,  -2275,  -2211,  -2147,  -2083,
+     -2019,  -1955,  -1891,  -1827,  -1763,  -1699,  -1635,  -1571,
+     -1506,  -1442,  -1378,  -1314,  -1250,  -1186,  -1122,  -1058,
+      -994,   -930,   -866,   -802,   -738,   -674,   -610,   -546,
+      -481,   -417,   -353,   -289,   -225,   -161,    -97,    -33,
+        31,     95,    159,    223,    287,    351,    415,    479,
+       544,    608,    672,    736,    800,    864,    928,    992,
+      1056,   1120,   1184,   1248,   1312,   1376,   1440,   1504,
+      1569,   1633,   1697,   1761,   1825,   1889,   1953,   2017,
+      2081,   2145,   2209,   2273,   2337,   2401,   2465,   2529,
+      2593,   2658,   2722,   2786,   2850,   2914,   2978,   3042,
+      3106,   3170,   3234,   3298,   3362,   3426,   3490,   3554,
+      3618,   3683,   3747,   3811,   3875,   3939,   4003,   4067,
+      4131,   4195,   4259,   4323,   4387,   4451,   4515,   4579,
+      4643,   4708,   4772,   4836,   4900,   4964,   5028,   5092,
+      5156,   5220,   5284,   5348,   5412,   5476,   5540,   5604,
+      5668,   5733,   5797,   5861,   5925,   5989,   6053,   6117,
+      6181,   6245,   6309,   6373,   6437,   6501,   6565,   6629,
+      6693,   6757,   6822,   6886,   6950,   7014,   7078,   7142,
+      7206,   7270,   7334,   7398,   7462,   7526,   7590,   7654,
+      7718,   7782,   7847,   7911,   7975,   8039,   8103,   8167,
+      8231,   8295,   8359,   8423,   8487,   8551,   8615,   8679,
+      8743,   8807,   8872,   8936,   9000,   9064,   9128,   9192,
+      9256,   9320,   9384,   9448,   9512,   9576,   9640,   9704,
+      9768,   9832,   9897,   9961,  10025,  10089,  10153,  10217,
+     10281,  10345,  10409,  10473,  10537,  10601,  10665,  10729,
+     10793,  10857,  10922,  10986,  11050,  11114,  11178,  11242,
+     11306,  11370,  11434,  11498,  11562,  11626,  11690,  11754,
+     11818,  11882,  11946,  12011,  12075,  12139,  12203,  12267,
+     12331,  12395,  12459,  12523,  12587,  12651,  12715,  12779,
+     12843,  12907,  12971,  13036,  13100,  13164,  13228,  13292,
+     13356,  13420,  13484,  13548,  13612,  13676,  13740,  13804,
+     13868,  13932,  13996,  14061,  14125,  14189,  14253,  14317,
+     14381,  14445,  14509,  14573,  14637,  14701,  14765,  14829,
+     14893,  14957,  15021,  15086,  15150,  15214,  15278,  15342,
+     15406,  15470,  15534,  15598,  15662,  15726,  15790,  15854,
+     15918,  15982,  16046,  16110,  16175,  16239,  16303,  16367,
+     16431,  16495,  16559,  16623,  16687,  16751,  16815,  16879,
+     16943,  17007,  17071,  17135,  17200,  17264,  17328,  17392,
+     17456,  17520,  17584,  17648,  17712,  17776,  17840,  17904,
+     17968,  18032,  18096,  18160,  18225,  18289,  18353,  18417,
+     18481,  18545,  18609,  18673,  18737,  18801,  18865,  18929,
+     18993,  19057,  19121,  19185,  19250,  19314,  19378,  19442,
+     19506,  19570,  19634,  19698,  19762,  19826,  19890,  19954,
+     20018,  20082,  20146,  20210,  20274,  20339,  20403,  20467,
+     20531,  20595,  20659,  20723,  20787,  20851,  20915,  20979,
+     21043,  21107,  21171,  21235,  21299,  21364,  21428,  21492,
+     21556,  21620,  21684,  21748,  21812,  21876,  21940,  22004,
+     22068,  22132,  22196,  22260,  22324,  22389,  22453,  22517,
+     22581,  22645,  22709,  22773,  22837,  22901,  22965,  23029,
+     23093,  23157,  23221,  23285,  23349,  23414,  23478,  23542,
+     23606,  23670,  23734,  23798,  23862,  23926,  23990,  24054,
+     24118,  24182,  24246,  24310,  24374,  24438,  24503,  24567,
+     24631,  24695,  24759,  24823,  24887,  24951,  25015,  25079,
+     25143,  25207,  25271,  25335,  25399,  25463,  25528,  25592,
+     25656,  25720,  25784,  25848,  25912,  25976,  26040,  26104,
+     26168,  26232,  26296,  26360,  26424,  26488,  26553,  26617,
+     26681,  26745,  26809,  26873,  26937,  27001,  27065,  27129,
+     27193,  27257,  27321,  27385,  27449,  27513,  27578,  27642,
+     27706,  27770,  27834,  27898,  27962,  28026,  28090,  28154,
+     28218,  28282,  28346,  28410,  28474,  28538,  28602,  28667,
+     28731,  28795,  28859,  28923,  28987,  29051,  29115,  29179,
+     29243,  29307,  29371,  29435,  29499,  29563,  29627,  29692,
+     29756,  29820,  29884,  29948,  30012,  30076,  30140,  30204,
+     30268,  30332,  30396,  30460,  30524,  30588,  30652,  30717,
+     30781,  30845,  30909,  30973,  31037,  31101,  31165,  31229,
+     31293,  31357,  31421,  31485,  31549,  31613,  31677,  31742,
+     31806,  31870,  31934,  31998,  32062,  32126,  32190,  32254,
+     32318,  32382,  32446,  32510,  32574,  32638,  32702,  32767,
+};
+
+static const uint16_t __attribute__((aligned(4))) env_gain_lut[1024] = {
+    0x1fe8, 0x1f90, 0x1f3c, 0x1ee4, 0x1e90, 0x1e3c, 0x1de8, 0x1d94,
+    0x1d44, 0x1cf4, 0x1ca4, 0x1c54, 0x1c08, 0x1bb8, 0x1b6c, 0x1b20,
+    0x1ad4, 0x1a8c, 0x1a44, 0x19fc, 0x19b4, 0x196c, 0x1924, 0x18e0,
+    0x189c, 0x1858, 0x1814, 0x17d4, 0x1790, 0x1750, 0x1710, 0x16d0,
+    0x1690, 0x1654, 0x1614, 0x15d8, 0x159c, 0x1560, 0x1524, 0x14ec,
+    0x14b0, 0x1478, 0x1440, 0x1408, 0x13d0, 0x139c, 0x1364, 0x1330,
+    0x12f8, 0x12c4, 0x1290, 0x1260, 0x122c, 0x11f8, 0x11c8, 0x1198,
+    0x1168, 0x1138, 0x1108, 0x10d8, 0x10a8, 0x107c, 0x1050, 0x1020,
+    0x0ff4, 0x0fc8, 0x0f9e, 0x0f72, 0x0f48, 0x0f1e, 0x0ef4, 0x0eca,
+    0x0ea2, 0x0e7a, 0x0e52, 0x0e2a, 0x0e04, 0x0ddc, 0x0db6, 0x0d90,
+    0x0d6a, 0x0d46, 0x0d22, 0x0cfe, 0x0cda, 0x0cb6, 0x0c92, 0x0c70,
+    0x0c4e, 0x0c2c, 0x0c0a, 0x0bea, 0x0bc8, 0x0ba8, 0x0b88, 0x0b68,
+    0x0b48, 0x0b2a, 0x0b0a, 0x0aec, 0x0ace, 0x0ab0, 0x0a92, 0x0a76,
+    0x0a58, 0x0a3c, 0x0a20, 0x0a04, 0x09e8, 0x09ce, 0x09b2, 0x0998,
+    0x097c, 0x0962, 0x0948, 0x0930, 0x0916, 0x08fc, 0x08e4, 0x08cc,
+    0x08b4, 0x089c, 0x0884, 0x086c, 0x0854, 0x083e, 0x0828, 0x0810,
+    0x07fa, 0x07e4, 0x07cf, 0x07b9, 0x07a4, 0x078f, 0x077a, 0x0765,
+    0x0751, 0x073d, 0x0729, 0x0715, 0x0702, 0x06ee, 0x06db, 0x06c8,
+    0x06b5, 0x06a3, 0x0691, 0x067f, 0x066d, 0x065b, 0x0649, 0x0638,
+    0x0627, 0x0616, 0x0605, 0x05f5, 0x05e4, 0x05d4, 0x05c4, 0x05b4,
+    0x05a4, 0x0595, 0x0585, 0x0576, 0x0567, 0x0558, 0x0549, 0x053b,
+    0x052c, 0x051e, 0x0510, 0x0502, 0x04f4, 0x04e7, 0x04d9, 0x04cc,
+    0x04be, 0x04b1, 0x04a4, 0x0498, 0x048b, 0x047e, 0x0472, 0x0466,
+    0x045a, 0x044e, 0x0442, 0x0436, 0x042a, 0x041f, 0x0414, 0x0408,
+    0x03fd, 0x03f2, 0x03e7, 0x03dc, 0x03d2, 0x03c7, 0x03bd, 0x03b2,
+    0x03a8, 0x039e, 0x0394, 0x038a, 0x0381, 0x0377, 0x036d, 0x0364,
+    0x035a, 0x0351, 0x0348, 0x033f, 0x0336, 0x032d, 0x0324, 0x031c,
+    0x0313, 0x030b, 0x0302, 0x02fa, 0x02f2, 0x02ea, 0x02e2, 0x02da,
+    0x02d2, 0x02ca, 0x02c2, 0x02bb, 0x02b3, 0x02ac, 0x02a4, 0x029d,
+    0x0296, 0x028f, 0x0288, 0x0281, 0x027a, 0x0273, 0x026c, 0x0266,
+    0x025f, 0x0258, 0x0252, 0x024c, 0x0245, 0x023f, 0x0239, 0x0233,
+    0x022d, 0x0227, 0x0221, 0x021b, 0x0215, 0x020f, 0x020a, 0x0204,
+    0x01fe, 0x01f9, 0x01f3, 0x01ee, 0x01e9, 0x01e3, 0x01de, 0x01d9,
+    0x01d4, 0x01cf, 0x01ca, 0x01c5, 0x01c0, 0x01bb, 0x01b6, 0x01b2,
+    0x01ad, 0x01a8, 0x01a4, 0x019f, 0x019b, 0x0196, 0x0192, 0x018e,
+    0x0189, 0x0185, 0x0181, 0x017d, 0x0179, 0x0175, 0x0171, 0x016d,
+    0x0169, 0x0165, 0x0161, 0x015d, 0x0159, 0x0156, 0x0152, 0x014e,
+    0x014b, 0x0147, 0x0144, 0x0140, 0x013d, 0x0139, 0x0136, 0x0133,
+    0x012f, 0x012c, 0x0129, 0x0126, 0x0122, 0x011f, 0x011c, 0x0119,
+    0x0116, 0x0113, 0x0110, 0x010d, 0x010a, 0x0107, 0x0105, 0x0102,
+    0x00ff, 0x00fc, 0x00f9, 0x00f7, 0x00f4, 0x00f1, 0x00ef, 0x00ec,
+    0x00ea, 0x00e7, 0x00e5, 0x00e2, 0x00e0, 0x00dd, 0x00db, 0x00d9,
+    0x00d6, 0x00d4, 0x00d2, 0x00cf, 0x00cd, 0x00cb, 0x00c9, 0x00c7,
+    0x00c4, 0x00c2, 0x00c0, 0x00be, 0x00bc, 0x00ba, 0x00b8, 0x00b6,
+    0x00b4, 0x00b2, 0x00b0, 0x00ae, 0x00ac, 0x00ab, 0x00a9, 0x00a7,
+    0x00a5, 0x00a3, 0x00a2, 0x00a0, 0x009e, 0x009c, 0x009b, 0x0099,
+    0x0097, 0x0096, 0x0094, 0x0093, 0x0091, 0x008f, 0x008e, 0x008c,
+    0x008b, 0x0089, 0x0088, 0x0086, 0x0085, 0x0083, 0x0082, 0x0081,
+    0x007f, 0x007e, 0x007c, 0x007b, 0x007a, 0x0078, 0x0077, 0x0076,
+    0x0075, 0x0073, 0x0072, 0x0071, 0x0070, 0x006e, 0x006d, 0x006c,
+    0x006b, 0x006a, 0x0069, 0x0067, 0x0066, 0x0065, 0x0064, 0x0063,
+    0x0062, 0x0061, 0x0060, 0x005f, 0x005e, 0x005d, 0x005c, 0x005b,
+    0x005a, 0x0059, 0x0058, 0x0057, 0x0056, 0x0055, 0x0054, 0x0053,
+    0x0052, 0x0051, 0x0051, 0x0050, 0x004f, 0x004e, 0x004d, 0x004c,
+    0x004b, 0x004b, 0x004a, 0x0049, 0x0048, 0x0047, 0x0047, 0x0046,
+    0x0045, 0x0044, 0x0044, 0x0043, 0x0042, 0x0041, 0x0041, 0x0040,
+    0x003f, 0x003f, 0x003e, 0x003d, 0x003d, 0x003c, 0x003b, 0x003b,
+    0x003a, 0x0039, 0x0039, 0x0038, 0x0038, 0x0037, 0x0036, 0x0036,
+    0x0035, 0x0035, 0x0034, 0x0033, 0x0033, 0x0032, 0x0032, 0x0031,
+    0x0031, 0x0030, 0x0030, 0x002f, 0x002f, 0x002e, 0x002e, 0x002d,
+    0x002d, 0x002c, 0x002c, 0x002b, 0x002b, 0x002a, 0x002a, 0x0029,
+    0x0029, 0x0028, 0x0028, 0x0028, 0x0027, 0x0027, 0x0026, 0x0026,
+    0x0025, 0x0025, 0x0025, 0x0024, 0x0024, 0x0023, 0x0023, 0x0023,
+    0x0022, 0x0022, 0x0022, 0x0021, 0x0021, 0x0020, 0x0020, 0x0020,
+    0x001f, 0x001f, 0x001f, 0x001e, 0x001e, 0x001e, 0x001d, 0x001d,
+    0x001d, 0x001c, 0x001c, 0x001c, 0x001c, 0x001b, 0x001b, 0x001b,
+    0x001a, 0x001a, 0x001a, 0x0019, 0x0019, 0x0019, 0x0019, 0x0018,
+    0x0018, 0x0018, 0x0018, 0x0017, 0x0017, 0x0017, 0x0017, 0x0016,
+    0x0016, 0x0016, 0x0016, 0x0015, 0x0015, 0x0015, 0x0015, 0x0014,
+    0x0014, 0x0014, 0x0014, 0x0014, 0x0013, 0x0013, 0x0013, 0x0013,
+    0x0012, 0x0012, 0x0012, 0x0012, 0x0012, 0x0011, 0x0011, 0x0011,
+    0x0011, 0x0011, 0x0011, 0x0010, 0x0010, 0x0010, 0x0010, 0x0010,
+    0x000f, 0x000f, 0x000f, 0x000f, 0x000f, 0x000f, 0x000e, 0x000e,
+    0x000e, 0x000e, 0x000e, 0x000e, 0x000e, 0x000d, 0x000d, 0x000d,
+    0x000d, 0x000d, 0x000d, 0x000c, 0x000c, 0x000c, 0x000c, 0x000c,
+    0x000c, 0x000c, 0x000c, 0x000b, 0x000b, 0x000b, 0x000b, 0x000b,
+    0x000b, 0x000b, 0x000b, 0x000a, 0x000a, 0x000a, 0x000a, 0x000a,
+    0x000a, 0x000a, 0x000a, 0x000a, 0x0009, 0x0009, 0x0009, 0x0009,
+    0x0009, 0x0009, 0x0009, 0x0009, 0x0009, 0x0008, 0x0008, 0x0008,
+    0x0008, 0x0008, 0x0008, 0x0008, 0x0008, 0x0008, 0x0008, 0x0008,
+    0x0007, 0x0007, 0x0007, 0x0007, 0x0007, 0x0007, 0x0007, 0x0007,
+    0x0007, 0x0007, 0x0007, 0x0007, 0x0007, 0x0006, 0x0006, 0x0006,
+    0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006, 0x0006,
+    0x0006, 0x0006, 0x0006, 0x0005, 0x0005, 0x0005, 0x0005, 0x0005,
+    0x0005, 0x0005, 0x0005, 0x0005, 0x0005, 0x0005, 0x0005, 0x0005,
+    0x0005, 0x0005, 0x0005, 0x0005, 0x0004, 0x0004, 0x0004, 0x0004,
+    0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004,
+    0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004,
+    0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003,
+    0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003,
+    0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003,
+    0x0003, 0x0003, 0x0003, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002,
+    0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002,
+    0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002,
+    0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002,
+    0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+};
+
+static const uint32_t pan_gain_lut[256] = {
+    0x7f007f00, 0x7f007e00, 0x7f007d00, 0x7f007c00, 0x7f007b00, 0x7f007a00, 0x7f007900, 0x7f007800,
+    0x7f007700, 0x7f007600, 0x7f007500, 0x7f007400, 0x7f007300, 0x7f007200, 0x7f007100, 0x7f007000,
+    0x7f006f00, 0x7f006e00, 0x7f006d00, 0x7f006c00, 0x7f006b00, 0x7f006a00, 0x7f006900, 0x7f006800,
+    0x7f006700, 0x7f006600, 0x7f006500, 0x7f006400, 0x7f006300, 0x7f006200, 0x7f006100, 0x7f006000,
+    0x7f005f00, 0x7f005e00, 0x7f005d00, 0x7f005c00, 0x7f005b00, 0x7f005a00, 0x7f005900, 0x7f005800,
+    0x7f005700, 0x7f005600, 0x7f005500, 0x7f005400, 0x7f005300, 0x7f005200, 0x7f005100, 0x7f005000,
+    0x7f004f00, 0x7f004e00, 0x7f004d00, 0x7f004c00, 0x7f004b00, 0x7f004a00, 0x7f004900, 0x7f004800,
+    0x7f004700, 0x7f004600, 0x7f004500, 0x7f004400, 0x7f004300, 0x7f004200, 0x7f004100, 0x7f004000,
+    0x7f003f00, 0x7f003e00, 0x7f003d00, 0x7f003c00, 0x7f003b00, 0x7f003a00, 0x7f003900, 0x7f003800,
+    0x7f003700, 0x7f003600, 0x7f003500, 0x7f003400, 0x7f003300, 0x7f003200, 0x7f003100, 0x7f003000,
+    0x7f002f00, 0x7f002e00, 0x7f002d00, 0x7f002c00, 0x7f002b00, 0x7f002a00, 0x7f002900, 0x7f002800,
+    0x7f002700, 0x7f002600, 0x7f002500, 0x7f002400, 0x7f002300, 0x7f002200, 0x7f002100, 0x7f002000,
+    0x7f001f00, 0x7f001e00, 0x7f001d00, 0x7f001c00, 0x7f001b00, 0x7f001a00, 0x7f001900, 0x7f001800,
+    0x7f001700, 0x7f001600, 0x7f001500, 0x7f001400, 0x7f001300, 0x7f001200, 0x7f001100, 0x7f001000,
+    0x7f000f00, 0x7f000e00, 0x7f000d00, 0x7f000c00, 0x7f000b00, 0x7f000a00, 0x7f000900, 0x7f000800,
+    0x7f000700, 0x7f000600, 0x7f000500, 0x7f000400, 0x7f000300, 0x7f000200, 0x7f000100, 0x7f000000,
+    0x00007f00, 0x00007f00, 0x01007f00, 0x02007f00, 0x03007f00, 0x04007f00, 0x05007f00, 0x06007f00,
+    0x07007f00, 0x08007f00, 0x09007f00, 0x0a007f00, 0x0b007f00, 0x0c007f00, 0x0d007f00, 0x0e007f00,
+    0x0f007f00, 0x10007f00, 0x11007f00, 0x12007f00, 0x13007f00, 0x14007f00, 0x15007f00, 0x16007f00,
+    0x17007f00, 0x18007f00, 0x19007f00, 0x1a007f00, 0x1b007f00, 0x1c007f00, 0x1d007f00, 0x1e007f00,
+    0x1f007f00, 0x20007f00, 0x21007f00, 0x22007f00, 0x23007f00, 0x24007f00, 0x25007f00, 0x26007f00,
+    0x27007f00, 0x28007f00, 0x29007f00, 0x2a007f00, 0x2b007f00, 0x2c007f00, 0x2d007f00, 0x2e007f00,
+    0x2f007f00, 0x30007f00, 0x31007f00, 0x32007f00, 0x33007f00, 0x34007f00, 0x35007f00, 0x36007f00,
+    0x37007f00, 0x38007f00, 0x39007f00, 0x3a007f00, 0x3b007f00, 0x3c007f00, 0x3d007f00, 0x3e007f00,
+    0x3f007f00, 0x40007f00, 0x41007f00, 0x42007f00, 0x43007f00, 0x44007f00, 0x45007f00, 0x46007f00,
+    0x47007f00, 0x48007f00, 0x49007f00, 0x4a007f00, 0x4b007f00, 0x4c007f00, 0x4d007f00, 0x4e007f00,
+    0x4f007f00, 0x50007f00, 0x51007f00, 0x52007f00, 0x53007f00, 0x54007f00, 0x55007f00, 0x56007f00,
+    0x57007f00, 0x58007f00, 0x59007f00, 0x5a007f00, 0x5b007f00, 0x5c007f00, 0x5d007f00, 0x5e007f00,
+    0x5f007f00, 0x60007f00, 0x61007f00, 0x62007f00, 0x63007f00, 0x64007f00, 0x65007f00, 0x66007f00,
+    0x67007f00, 0x68007f00, 0x69007f00, 0x6a007f00, 0x6b007f00, 0x6c007f00, 0x6d007f00, 0x6e007f00,
+    0x6f007f00, 0x70007f00, 0x71007f00, 0x72007f00, 0x73007f00, 0x74007f00, 0x75007f00, 0x76007f00,
+    0x77007f00, 0x78007f00, 0x79007f00, 0x7a007f00, 0x7b007f00, 0x7c007f00, 0x7d007f00, 0x7e007f00,
+};
+
@@ -6,22 +6,150 @@
 
 #include "./hst.h"
 #include "hw.h"
+#include "sys/ply.h"
 #include "sys/sgu.h"
 
+#include <hardware/dma.h>
 #include <hardware/gpio.h>
 #include <hardware/spi.h>
 
 #define SPI_READ_BIT 0x8000
+#define SPI_BULK_BIT 0x4000
+
+#define SPI_BULK_CMD_MASK  0x3F00
+#define SPI_PCM_ADDR_L     0x0000
+#define SPI_PCM_ADDR_H     0x0100
+#define SPI_PCM_BYTE       0x0200
+#define SPI_PCM_HALVES     0x0300
+#define SPI_PLAY_END_L     0x0400
+#define SPI_PLAY_END_H     0x0500
+#define SPI_PLAY_STOP      0x0600
+#define SPI_REG_BURST_MASK 0x3000
+#define SPI_REG_BURST      0x1000
+#define SPI_REG_WORDS      0x007F
+#define SPI_PCM_DATA       0x2000
+#define SPI_PCM_WORDS      0x1FFF
+
+#define HST_BURST_WORDS (SPI_REG_WORDS + 1)
 
 #define SPI_IRQ_NUM(spi) (((spi) == spi0) ? SPI0_IRQ : SPI1_IRQ)
 
+// Single words would sit in the FIFO below the half full mark,
+// the receive timeout takes them.
+#define HST_SPI_IMSC (SPI_SSPIMSC_RXIM_BITS | SPI_SSPIMSC_RTIM_BITS)
+
+static uint16_t hst_pcm_ptr;
+static uint8_t hst_play_end_l;
+static uint16_t hst_pcm_words; // data words the IRQ handler takes itself
+static uint16_t hst_pcm_dma_words;
+static int hst_dma_chan;
+
+// Register burst taken by the DMA
+static uint16_t hst_burst[HST_BURST_WORDS];
+static uint8_t hst_burst_words;
+
+static inline void __attribute__((always_inline))
+hst_pcm_put(uint8_t data)
+{
+    ((uint8_t *)sgu_instance.sgu.pcm)[hst_pcm_ptr++] = data;
+}
+
+static void __not_in_flash_func(hst_burst_write)(void)
+{
+    for (uint i = 0; i < hst_burst_words;)
+    {
+        const uint16_t run = hst_burst[i++];
+        const uint count = ((run >> 8) & 0x3F) + 1;
+        uint8_t reg = run & 0x3F;
+        for (uint n = 0; n < count && i + n / 2 < hst_burst_words; ++n)
+        {
+            const uint16_t data = hst_burst[i + n / 2];
+            sgu_reg_write(reg, (uint8_t)(n & 1 ? data >> 8 : data));
+            reg = (reg + 1) & (SGU_REGS_PER_CH - 1);
+        }
+        i += (count + 1) / 2;
+    }
+    hst_burst_words = 0;
+}
+
+static inline void __attribute__((always_inline))
+hst_dma_start(void *dest, uint16_t words)
+{
+    spi_get_hw(HST_SPI)->imsc = 0;
+    dma_channel_set_write_addr(hst_dma_chan, dest, false);
+    dma_channel_set_trans_count(hst_dma_chan, words, true);
+}
+
+// Returns true when words go by DMA, and the FIFO must be left alone.
+static bool __not_in_flash_func(hst_bulk_command)(uint16_t rcv)
+{
+    if ((rcv & SPI_REG_BURST_MASK) == SPI_REG_BURST)
+    {
+        hst_burst_words = (rcv & SPI_REG_WORDS) + 1;
+        hst_dma_start(hst_burst, hst_burst_words);
+        return true;
+    }
+    if (rcv & SPI_PCM_DATA)
+    {
+        const uint16_t words = (rcv & SPI_PCM_WORDS) + 1;
+        if ((hst_pcm_ptr & 1) || hst_pcm_ptr + words * 2 > SGU_PCM_RAM_SIZE)
+        {
+            hst_pcm_words = words;
+            return false;
+        }
+        hst_pcm_dma_words = words;
+        hst_dma_start(&sgu_instance.sgu.pcm[hst_pcm_ptr], words);
+        return true;
+    }
+    switch (rcv & SPI_BULK_CMD_MASK)
+    {
+    case SPI_PCM_ADDR_L:
+        hst_pcm_ptr = (hst_pcm_ptr & 0xFF00) | (rcv & 0xFF);
+        break;
+    case SPI_PCM_ADDR_H:
+        hst_pcm_ptr = (hst_pcm_ptr & 0x00FF) | (uint16_t)(rcv << 8);
+        break;
+    case SPI_PCM_BYTE:
+        hst_pcm_put((uint8_t)rcv);
+        break;
+    case SPI_PCM_HALVES:
+        spi_get_hw(HST_SPI)->dr = (rcv & 0xFF00)
+                                  | ((rcv & 0x0F) < SGU_CHNS ? sgu_instance.sgu.pcm_halves[rcv & 0x0F]
+                                                             : ply_halves());
+        break;
+    case SPI_PLAY_END_L:
+        hst_play_end_l = (uint8_t)rcv;
+        break;
+    case SPI_PLAY_END_H:
+    {
+        const uint32_t end = (uint32_t)((rcv & 0xFF) << 8 | hst_play_end_l);
+        ply_start(hst_pcm_ptr, end ? end : SGU_PCM_RAM_SIZE);
+    }
+    break;
+    case SPI_PLAY_STOP:
+        ply_stop();
+        break;
+    }
+    return false;
+}
+
 static void __isr __not_in_flash_func(hst_spi_irq_handler)(void)
 {
     spi_hw_t *spi_hw = spi_get_hw(HST_SPI);
+    spi_hw->icr = SPI_SSPICR_RTIC_BITS;
 
     while (spi_is_readable(HST_SPI))
     {
         const uint16_t rcv = (uint16_t)spi_hw->dr;
+
+        if (hst_pcm_words)
+        {
+            hst_pcm_put((uint8_t)rcv);
+            hst_pcm_put((uint8_t)(rcv >> 8));
+            --hst_pcm_words;
+            continue;
+        }
+
         const uint8_t reg = (rcv >> 8) & (SGU_REGS_PER_CH - 1);
 
         if (rcv & SPI_READ_BIT)
@@ -29,6 +157,11 @@ static void __isr __not_in_flash_func(hst_spi_irq_handler)(void)
             // read command - enqueue answer
             spi_hw->dr = (rcv & 0xFF00) | (uint16_t)sgu_reg_read(reg);
         }
+        else if (rcv & SPI_BULK_BIT)
+        {
+            if (hst_bulk_command(rcv))
+                return;
+        }
         else
         {
             // write command
@@ -37,6 +170,17 @@ static void __isr __not_in_flash_func(hst_spi_irq_handler)(void)
     }
 }
 
+static void __isr __not_in_flash_func(hst_dma_irq_handler)(void)
+{
+    dma_hw->ints0 = 1u << hst_dma_chan;
+    if (hst_burst_words)
+        hst_burst_write();
+    else
+        hst_pcm_ptr += hst_pcm_dma_words * 2;
+    // words that came after the data are back to the IRQ handler
+    spi_get_hw(HST_SPI)->imsc = HST_SPI_IMSC;
+}
+
 void hst_init(void)
 {
     // Configure SPI communication
@@ -48,8 +192,26 @@ void hst_init(void)
     gpio_set_function(HST_SPI_TX_PIN, GPIO_FUNC_SPI);
     gpio_set_function(HST_SPI_CS_PIN, GPIO_FUNC_SPI);
 
+    // DMA for register bursts and PCM RAM data
+    hst_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config dma_config = dma_channel_get_default_config(hst_dma_chan);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&dma_config, false);
+    channel_config_set_write_increment(&dma_config, true);
+    channel_config_set_dreq(&dma_config, spi_get_dreq(HST_SPI, false));
+    dma_channel_configure(
+        hst_dma_chan,
+        &dma_config,
+        sgu_instance.sgu.pcm,
+        &spi_get_hw(HST_SPI)->dr,
+        0,
+        false);
+    dma_channel_set_irq0_enabled(hst_dma_chan, true);
+    irq_set_exclusive_handler(HST_DMA_IRQ, hst_dma_irq_handler);
+    irq_set_enabled(HST_DMA_IRQ, true);
+
     // SPI IRQ on RX FIFO
-    spi_get_hw(HST_SPI)->imsc = SPI_SSPIMSC_RXIM_BITS;
+    spi_get_hw(HST_SPI)->imsc = HST_SPI_IMSC;
     irq_set_exclusive_handler(SPI_IRQ_NUM(HST_SPI), hst_spi_irq_handler);
     irq_set_enabled(SPI_IRQ_NUM(HST_SPI), true);
 }
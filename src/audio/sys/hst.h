@@ -8,6 +8,34 @@
 #define _SND_SYS_SPI_H_
 
 /* Host communication over SPI
+ *
+ * 16-bit words, MSB first:
+ *   0 0 RRRRRR DDDDDDDD - write D to register R
+ *   1 x RRRRRR xxxxxxxx - read register R, answered in the next word
+ *   0 1 000000 LLLLLLLL - set PCM RAM pointer bits 7-0
+ *   0 1 000001 HHHHHHHH - set PCM RAM pointer bits 15-8
+ *   0 1 000010 DDDDDDDD - write D to PCM RAM at pointer, advance it
+ *   0 1 000011 xxxxCCCC - read ring halves PCM stream channel C played,
+ *                         modulo 256, answered in the next word; C past
+ *                         the last channel reads the register stream
+ *                         player's
+ *   0 1 000100 LLLLLLLL - set player ring end bits 7-0
+ *   0 1 000101 HHHHHHHH - set player ring end bits 15-8, 0 for the end
+ *                         of PCM RAM, and start it at the PCM RAM pointer
+ *   0 1 000110 xxxxxxxx - stop the register stream player
+ *   0 1 01xxxx xNNNNNNN - N+1 words of register burst follow
+ *   0 1 1NNNNN NNNNNNNN - N+1 words of PCM RAM data follow, low byte
+ *                         first, written at pointer and advancing it
+ *
+ * A register burst is a list of runs, each a header word
+ *   xx CCCCCC xx RRRRRR - C+1 registers from R on
+ * followed by their values, low byte first. Runs go on past register
+ * 0x3F, so a value written there selects the channel the rest go to.
+ *
+ * Bursts and data words go straight from the RX FIFO by DMA, data words
+ * when the pointer is even and they do not wrap past the end of PCM
+ * RAM. The DMA starts in the SPI IRQ, which the core 0 sample interrupt
+ * holds off, so the host pauses after the burst or data command.
  */
 
 #include <stddef.h>
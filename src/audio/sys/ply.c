@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "./ply.h"
+#include "sgr.h"
+#include "sys/sgu.h"
+
+#include <hardware/sync.h>
+#include <pico.h>
+
+// Commands taken in one sample at most, writes past
+// them land on the next one.
+#define PLY_STEPS_PER_SAMPLE 32
+
+// Stream state, owned by the rendering core.
+static bool ply_active;
+static uint32_t ply_start_pos;
+static uint32_t ply_end;
+static uint32_t ply_mid;
+static uint32_t ply_pos;
+static uint32_t ply_wait;
+static uint8_t ply_chan; // channel the stream writes select
+static volatile uint8_t ply_halves_played;
+
+// Start and stop requests from the host side. The sequence is odd
+// while a request is being written, the rendering core takes it
+// when it is even and has moved on from the one taken last.
+static volatile uint32_t ply_req_seq;
+static volatile uint32_t ply_req_taken;
+static volatile bool ply_req_play;
+static volatile uint16_t ply_req_start;
+static volatile uint32_t ply_req_end;
+
+static void ply_request(bool play, uint16_t start, uint32_t end)
+{
+    ++ply_req_seq;
+    __dmb();
+    ply_req_play = play;
+    ply_req_start = start;
+    ply_req_end = end;
+    __dmb();
+    ++ply_req_seq;
+}
+
+void ply_start(uint16_t start, uint32_t end)
+{
+    ply_request(true, start, end);
+}
+
+void ply_stop(void)
+{
+    ply_request(false, 0, 0);
+}
+
+uint8_t ply_halves(void)
+{
+    // A new stream has played nothing until it is taken.
+    if (ply_req_seq != ply_req_taken)
+        return 0;
+    return ply_halves_played;
+}
+
+// Rendering core, at the sample boundary.
+static void __not_in_flash_func(ply_take)(uint32_t seq)
+{
+    __dmb();
+    const bool play = ply_req_play;
+    const uint32_t start = ply_req_start;
+    const uint32_t end = ply_req_end;
+    __dmb();
+    if (ply_req_seq != seq)
+        return; // rewritten meanwhile, next sample
+    ply_active = false;
+    if (play)
+    {
+        ply_start_pos = start;
+        ply_end = end > start ? end : start + 1u;
+        ply_mid = start + (ply_end - start) / 2;
+        ply_pos = start;
+        ply_wait = 0;
+        ply_chan = 0;
+        ply_halves_played = 0;
+        ply_active = true;
+    }
+    __dmb();
+    ply_req_taken = seq;
+}
+
+static inline uint8_t __attribute__((always_inline))
+ply_fetch(void)
+{
+    const uint8_t data = ((const uint8_t *)sgu_instance.sgu.pcm)[ply_pos];
+    if (++ply_pos == ply_end)
+        ply_pos = ply_start_pos;
+    // Entering either half of the ring frees the other one.
+    if (ply_pos == ply_start_pos || ply_pos == ply_mid)
+        ++ply_halves_played;
+    return data;
+}
+
+// Inlined with a known fetch, so the ring reads stay direct.
+static inline bool __attribute__((always_inline))
+ply_run(ply_fetch_fn fetch)
+{
+    if (ply_wait)
+    {
+        --ply_wait;
+        return true;
+    }
+    for (int i = 0; i < PLY_STEPS_PER_SAMPLE; ++i)
+    {
+        const uint8_t cmd = fetch();
+        if (cmd < SGR_WAIT_SHORT)
+        {
+            const uint8_t data = fetch();
+            if (cmd == SGU_REGS_PER_CH - 1)
+                ply_chan = data;
+            else
+                SGU_Write(&sgu_instance.sgu, (uint16_t)((ply_chan % SGU_CHNS) << 6) | cmd, data);
+        }
+        else if (cmd < SGR_WAIT_LONG)
+        {
+            ply_wait = cmd - SGR_WAIT_SHORT;
+            return true;
+        }
+        else if (cmd == SGR_WAIT_LONG)
+        {
+            const uint8_t low = fetch();
+            ply_wait = (uint32_t)low | (uint32_t)fetch() << 8;
+            return true;
+        }
+        else
+            return false;
+    }
+    return true;
+}
+
+bool ply_step(ply_fetch_fn fetch)
+{
+    return ply_run(fetch);
+}
+
+void __not_in_flash_func(ply_tick)(void)
+{
+    const uint32_t seq = ply_req_seq;
+    if (seq != ply_req_taken && !(seq & 1))
+        ply_take(seq);
+    if (ply_active && !ply_run(ply_fetch))
+        ply_active = false;
+}
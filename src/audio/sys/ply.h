@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SND_SYS_PLY_H_
+#define _SND_SYS_PLY_H_
+
+/* Register stream player
+ *
+ * Plays SGR register stream commands (see sgr.h) from a ring of PCM RAM,
+ * stepping before every sample is rendered, so writes land on the sample
+ * they were timed for. Ring halves are counted like a PCM stream
+ * channel's, for the host to refill.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Ring from start up to end, 0x10000 for the end of PCM RAM.
+// The rendering core takes the change over before its next sample.
+void ply_start(uint16_t start, uint32_t end);
+void ply_stop(void);
+
+// Ring halves played, modulo 256.
+uint8_t ply_halves(void);
+
+// Called by the rendering core before every sample.
+void ply_tick(void);
+
+// Next byte of a stream.
+typedef uint8_t (*ply_fetch_fn)(void);
+
+// Writes the commands due on this sample to sgu_instance, taking
+// stream bytes from fetch. False once the stream has ended.
+// Used by ply_tick, and by misc/sgu_play.c on the host.
+bool ply_step(ply_fetch_fn fetch);
+
+#endif /* _SND_SYS_PLY_H_ */
@@ -1,9 +1,12 @@
 #include "./sgu.h"
 #include "hw.h"
 #include "sys/led.h"
+#include "sys/ply.h"
+#include <hardware/clocks.h>
 #include <hardware/irq.h>
 #include <hardware/pio.h>
 #include <hardware/structs/sio.h>
+#include <hardware/structs/systick.h>
 #include <math.h>
 #include <pico/multicore.h>
 #include <pico/rand.h>
@@ -12,10 +15,27 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <tusb.h>
 
-// Channel split: core 1 does 0..(SGU_CORE1_CHNS-1), core 0 does SGU_CORE1_CHNS..(SGU_CHNS-1)
+// Channel split: core 1 does 0..(split-1), core 0 does split..(SGU_CHNS-1).
+// Starts at SGU_CORE1_CHNS and follows the channel costs.
 #define SGU_CORE1_CHNS 5
 
+// Channels are timed one by one every SGU_MEASURE_EVERY samples,
+// the split is recomputed from that every SGU_BALANCE_SAMPLES.
+#define SGU_MEASURE_EVERY   16
+#define SGU_BALANCE_SAMPLES 1024
+#define SGU_MEASURED        (SGU_BALANCE_SAMPLES / SGU_MEASURE_EVERY)
+
+// "go" word to core 0: its first channel, and whether to time channels
+#define SGU_GO_SPLIT   0xFF
+#define SGU_GO_MEASURE 0x100
+
+// Count cycles of every sample and report them once a second.
+#ifndef SGU_PROFILE
+#define SGU_PROFILE 0
+#endif
+
 sgu1_t sgu_instance;
 #define SGU (&sgu_instance)
 
@@ -47,20 +67,106 @@ clamp(int32_t sample)
     return (int16_t)__builtin_arm_ssat(sample, 16);
 }
 
-// Core 0 FIFO IRQ handler — computes channels SGU_CORE1_CHNS..(SGU_CHNS-1)
-// and pushes partial L,R sums back to core 1 via FIFO.
+// SysTick of the calling core, counting down
+static void sgu_systick_init(void)
+{
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M33_SYST_CSR_CLKSOURCE_BITS | M33_SYST_CSR_ENABLE_BITS;
+}
+
+// Cycles of each channel in the timed samples of this block,
+// added up by whichever core renders the channel.
+static uint32_t sgu_ch_cycles[SGU_CHNS];
+
+// Core 1 work around the channels in the timed samples of this block:
+// register stream, global setup, merge and DC-removal HPF.
+static uint32_t sgu_fixed_cycles;
+
+// Only core 1 touches the split, core 0 gets it with every "go".
+static uint8_t sgu_split = SGU_CORE1_CHNS;
+
+// Last block, per core: channel cycles of a sample, and the split
+static volatile uint32_t sgu_core_cycles[2];
+static volatile uint8_t sgu_core_split;
+
+static void __not_in_flash_func(sgu_channels)(uint first, uint end, bool measure, int32_t *l, int32_t *r)
+{
+    if (!measure)
+    {
+        SGU_NextSample_Channels(&SGU->sgu, first, end, l, r);
+        return;
+    }
+
+    int32_t L = 0, R = 0;
+    for (uint ch = first; ch < end; ++ch)
+    {
+        int32_t ch_l, ch_r;
+        const uint32_t start = systick_hw->cvr;
+        SGU_NextSample_Channels(&SGU->sgu, ch, ch + 1, &ch_l, &ch_r);
+        sgu_ch_cycles[ch] += (start - systick_hw->cvr) & 0x00FFFFFF;
+        L += ch_l;
+        R += ch_r;
+    }
+    *l = L;
+    *r = R;
+}
+
+// Core 1, between samples: moves the split to where the busier core has
+// least to do. Core 0 is idle, its last channel costs are in.
+// Core 1 also carries its fixed work, whatever the split.
+static void __not_in_flash_func(sgu_balance)(void)
+{
+    const uint32_t fixed = sgu_fixed_cycles;
+    uint32_t total = 0, core1 = 0;
+    for (uint ch = 0; ch < SGU_CHNS; ++ch)
+    {
+        if (ch < sgu_split)
+            core1 += sgu_ch_cycles[ch];
+        total += sgu_ch_cycles[ch];
+    }
+    sgu_core_cycles[1] = (fixed + core1) / SGU_MEASURED;
+    sgu_core_cycles[0] = (total - core1) / SGU_MEASURED;
+    sgu_core_split = sgu_split;
+
+    uint best_split = sgu_split;
+    const uint32_t busier = fixed + core1 > total - core1 ? fixed + core1 : total - core1;
+    uint32_t best = busier;
+    uint32_t prefix = 0;
+    for (uint split = 0; split <= SGU_CHNS; ++split)
+    {
+        const uint32_t candidate = fixed + prefix > total - prefix ? fixed + prefix : total - prefix;
+        if (candidate < best)
+        {
+            best_split = split;
+            best = candidate;
+        }
+        if (split < SGU_CHNS)
+            prefix += sgu_ch_cycles[split];
+    }
+    // don't flip over noise
+    if (best + (busier >> 4) < busier)
+        sgu_split = (uint8_t)best_split;
+
+    memset(sgu_ch_cycles, 0, sizeof(sgu_ch_cycles));
+    sgu_fixed_cycles = 0;
+}
+
+// Core 0 FIFO IRQ handler — computes channels from the split in the "go"
+// word to SGU_CHNS-1 and pushes partial L,R sums back to core 1 via FIFO.
 static void __isr __not_in_flash_func(core0_audio_isr)(void)
 {
     // Drain the "go" signal and clear IRQ
+    uint32_t go = 0;
     while (multicore_fifo_rvalid())
-        (void)sio_hw->fifo_rd;
+        go = sio_hw->fifo_rd;
     multicore_fifo_clear_irq();
 
-    // Compute channels SGU_CORE1_CHNS .. SGU_CHNS-1
     int32_t l = 0, r = 0;
-    SGU_NextSample_Channels(&SGU->sgu, SGU_CORE1_CHNS, SGU_CHNS, &l, &r);
+    sgu_channels(go & SGU_GO_SPLIT, SGU_CHNS, go & SGU_GO_MEASURE, &l, &r);
 
-    // Send partial sums to core 1
+    // Send partial sums to core 1, channel costs visible before them
+    __dmb();
     multicore_fifo_push_blocking_inline((uint32_t)l);
     multicore_fifo_push_blocking_inline((uint32_t)r);
 }
@@ -68,31 +174,87 @@ static void __isr __not_in_flash_func(core0_audio_isr)(void)
 __force_inline static inline void __attribute__((optimize("O2")))
 _sgu_tick(void)
 {
+    static uint32_t tick;
+    const bool measure = (++tick % SGU_MEASURE_EVERY) == 0;
+    const uint split = sgu_split;
+    const uint32_t fixed_start = systick_hw->cvr;
+
+    // 0. Register stream writes due on this sample
+    ply_tick();
+
     // 1. Global setup (LFO, envelope counters)
     SGU_NextSample_Setup(&SGU->sgu);
 
     // 2. Signal core 0 to start its channel subset
-    multicore_fifo_push_blocking_inline(1);
+    multicore_fifo_push_blocking_inline(split | (measure ? SGU_GO_MEASURE : 0));
+    const uint32_t fixed = (fixed_start - systick_hw->cvr) & 0x00FFFFFF;
 
-    // 3. Compute channels 0..(SGU_CORE1_CHNS-1) on this core
+    // 3. Compute channels 0..(split-1) on this core
     int32_t l1 = 0, r1 = 0;
-    SGU_NextSample_Channels(&SGU->sgu, 0, SGU_CORE1_CHNS, &l1, &r1);
+    sgu_channels(0, split, measure, &l1, &r1);
 
     // 4. Wait for core 0's partial sums
     int32_t l0 = (int32_t)multicore_fifo_pop_blocking_inline();
     int32_t r0 = (int32_t)multicore_fifo_pop_blocking_inline();
 
     // 5. Merge and finalize (DC-removal HPF)
+    const uint32_t merge_start = systick_hw->cvr;
     int32_t l, r;
     SGU_NextSample_Finalize(&SGU->sgu, (int64_t)l1 + l0, (int64_t)r1 + r0, &l, &r);
 
     const int16_t left = clamp(l >> 1);
     const int16_t right = clamp(r >> 1);
     SGU->sample = ((uint32_t)(uint16_t)left << 16) | (uint16_t)right;
+    if (measure)
+        sgu_fixed_cycles += fixed + ((merge_start - systick_hw->cvr) & 0x00FFFFFF);
+
+    if (tick == SGU_BALANCE_SAMPLES)
+    {
+        tick = 0;
+        sgu_balance();
+    }
+}
+
+#if SGU_PROFILE
+// Filled by core 1, a second of samples at a time
+static struct
+{
+    uint32_t cycles;
+    uint32_t worst;
+    uint32_t silent; // channels skipped
+    uint32_t samples;
+} sgu_prof;
+static volatile bool sgu_prof_ready;
+
+static inline void __attribute__((optimize("O2")))
+sgu_prof_sample(uint32_t cycles)
+{
+    static uint32_t total, worst, silent, samples;
+    total += cycles;
+    if (cycles > worst)
+        worst = cycles;
+    for (uint ch = 0; ch < SGU_CHNS; ++ch)
+        silent += SGU->sgu.silent[ch];
+    if (++samples == SGU_CHIP_CLOCK)
+    {
+        if (!sgu_prof_ready)
+        {
+            sgu_prof.cycles = total;
+            sgu_prof.worst = worst;
+            sgu_prof.silent = silent;
+            sgu_prof.samples = samples;
+            __compiler_memory_barrier();
+            sgu_prof_ready = true;
+        }
+        total = worst = silent = samples = 0;
+    }
 }
+#endif
 
 __attribute__((optimize("O2"))) static void __no_inline_not_in_flash_func(sgu_loop)(void)
 {
+    sgu_systick_init();
+
     while (true)
     {
         while (!pio_interrupt_get(AUD_I2S_PIO, AUD_PIO_IRQ))
@@ -103,7 +265,13 @@ __attribute__((optimize("O2"))) static void __no_inline_not_in_flash_func(sgu_lo
 
         static uint32_t tick_start, tick_elapsed;
         tick_start = time_us_32();
+#if SGU_PROFILE
+        const uint32_t cycles_start = systick_hw->cvr;
+#endif
         _sgu_tick();
+#if SGU_PROFILE
+        sgu_prof_sample((cycles_start - systick_hw->cvr) & 0x00FFFFFF);
+#endif
         tick_elapsed = time_us_32() - tick_start;
 
         pio_sm_put_blocking(AUD_I2S_PIO, AUD_I2S_SM, SGU->sample);
@@ -127,6 +295,7 @@ void sgu_init()
     SGU_Init(&SGU->sgu, SGU_PCM_RAM_SIZE);
 
     // Register core 0 FIFO IRQ handler for dual-core audio rendering
+    sgu_systick_init();
     irq_set_exclusive_handler(SIO_IRQ_FIFO, core0_audio_isr);
     irq_set_priority(SIO_IRQ_FIFO, 0); // highest priority — preempts SPI
     irq_set_enabled(SIO_IRQ_FIFO, true);
@@ -135,6 +304,50 @@ void sgu_init()
     multicore_launch_core1(sgu_loop);
 }
 
+static bool sgu_load_requested;
+
+void sgu_load_request(void)
+{
+    sgu_load_requested = true;
+}
+
+void sgu_task(void)
+{
+    // Core loads on the console when they change, checked once a second,
+    // and whenever a key asks for them
+    static absolute_time_t sgu_load_time;
+    static uint32_t sgu_load_shown = UINT32_MAX;
+    if (!tud_cdc_connected())
+        sgu_load_shown = UINT32_MAX; // again on the next connect
+    else if (sgu_load_requested || time_reached(sgu_load_time))
+    {
+        sgu_load_time = make_timeout_time_ms(1000);
+        const uint32_t budget = clock_get_hz(clk_sys) / SGU_CHIP_CLOCK;
+        const uint32_t core1 = sgu_core_cycles[1] * 100 / budget;
+        const uint32_t core0 = sgu_core_cycles[0] * 100 / budget;
+        const uint32_t load = core1 << 16 | core0 << 8 | sgu_core_split;
+        if (sgu_load_requested || load != sgu_load_shown)
+            printf("SGU : core 1 %lu%%, core 0 %lu%%, split at channel %u\n",
+                   (unsigned long)core1, (unsigned long)core0, sgu_core_split);
+        sgu_load_shown = load;
+        sgu_load_requested = false;
+    }
+
+#if SGU_PROFILE
+    if (sgu_prof_ready)
+    {
+        const uint32_t budget = clock_get_hz(clk_sys) / SGU_CHIP_CLOCK;
+        printf("SGU : %lu/%lu cycles per sample, worst %lu, %lu.%lu of %u channels silent\n",
+               (unsigned long)(sgu_prof.cycles / sgu_prof.samples), (unsigned long)budget,
+               (unsigned long)sgu_prof.worst,
+               (unsigned long)(sgu_prof.silent / sgu_prof.samples),
+               (unsigned long)(sgu_prof.silent * 10 / sgu_prof.samples % 10),
+               SGU_CHNS);
+        sgu_prof_ready = false;
+    }
+#endif
+}
+
 void sgu_reset()
 {
     SGU_Reset(&SGU->sgu);
@@ -32,16 +32,20 @@
          ~~~~~~~~~~~~~~~~~~~~                 ~~~~~~~~~~~~~~~~~
     PIO IRQ -> 1. Setup (LFO, envelope)      [main loop: USB,
                                                 LED, SPI ISR]
-               2. Push "go" to FIFO -------> FIFO IRQ fires
-               3. Compute channels 0-4       3'. Compute channels 5-8
+               2. Push "go" + split -------> FIFO IRQ fires
+               3. Compute channels 0..S-1    3'. Compute channels S..8
                      |                              |
                      v                              v
                4. Pop partial L,R <------------- Push partial L,R
                5. Merge + DC-removal HPF
                6. Push to PIO FIFO
 
-    Channel split is 5+4 to balance core 1's setup/merge overhead against
-    core 0's ISR entry cost. Wall time ~4000 cycles (vs ~7000 single-core).
+    Channel split starts at 5+4 to balance core 1's setup/merge overhead
+    against core 0's ISR entry cost. Wall time ~4000 cycles (vs ~7000
+    single-core). Every 16th sample both cores time their channels one by
+    one; every 1024 samples core 1 moves the split S to where the busier
+    core has least to do, and hands it over in the "go" word, so the cores
+    never share it. Core loads are printed on the CDC console.
 
     Ring modulation reads src[ch+1] directly -- cross-core boundary reads
     may see the previous or current frame's value, which is acceptable
@@ -63,6 +67,10 @@ extern sgu1_t sgu_instance;
 
 // initialize a new sgu1_t instance
 void sgu_init(void);
+// report core loads, and per-sample cycles when built with SGU_PROFILE
+void sgu_task(void);
+// report core loads on the next task even if they did not change
+void sgu_load_request(void);
 // reset a sgu1_t instance
 void sgu_reset(void);
 
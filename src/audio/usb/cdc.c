@@ -6,6 +6,7 @@
 
 #include "usb/cdc.h"
 #include "sys/com.h"
+#include "sys/sgu.h"
 #include <tusb.h>
 
 void cdc_task(void)
@@ -26,7 +27,9 @@ void cdc_task(void)
         }
         if (tud_cdc_available())
         {
+            // Any key shows the core loads
             tud_cdc_read_flush();
+            sgu_load_request();
         }
     }
 }
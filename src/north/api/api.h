@@ -86,6 +86,23 @@ uint16_t api_fresult_errno(unsigned fresult);
 #define API_OP_CLK_GET_RES     (0X20)
 #define API_OP_CLK_GET_TIME    (0X21)
 #define API_OP_CLK_SET_TIME    (0X22)
+#define API_OP_SKT_SOCKET      (0x30)
+#define API_OP_SKT_CONNECT     (0x31)
+#define API_OP_SKT_BIND        (0x32)
+#define API_OP_SKT_LISTEN      (0x33)
+#define API_OP_SKT_ACCEPT      (0x34)
+#define API_OP_SKT_SEND        (0x35)
+#define API_OP_SKT_RECV        (0x36)
+#define API_OP_SKT_SENDTO      (0x37)
+#define API_OP_SKT_RECVFROM    (0x38)
+#define API_OP_SKT_POLL        (0x39)
+#define API_OP_SKT_CLOSE       (0x3A)
+#define API_OP_SGU_PCM_LOAD    (0x40)
+#define API_OP_SGU_STREAM      (0x41)
+#define API_OP_SGU_STREAM_FD   (0x42)
+#define API_OP_SGU_PLAY        (0x43)
+#define API_OP_SGU_PLAY_FD     (0x44)
+#define API_OP_SGU_RECORD      (0x45)
 #define API_OP_HALT            (0xFF)
 
 // How to build an API handler:
@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "api/sgu.h"
+#include "api/api.h"
+#include "api/std.h"
+#include "sgr.h"
+#include "sys/mem.h"
+#include "sys/pix.h"
+#include <hardware/sync.h>
+#include <pico/time.h>
+#include <string.h>
+
+#if defined(DEBUG_RIA_API) || defined(DEBUG_RIA_API_SGU)
+#include <stdio.h>
+#define DBG(...) fprintf(stderr, __VA_ARGS__)
+#else
+static inline void DBG(const char *fmt, ...) { (void)fmt; }
+#endif
+
+// Frames sent per API call, the VPU acks each
+// once the SGU-1 has taken it.
+#define SGU_PCM_FRAMES_PER_CALL 16
+
+#define SGU_CHANNELS 9
+
+// The register stream player refills its ring like a PCM stream.
+#define SGU_PLAYER  PIX_SPU_PLAY_CHAN
+#define SGU_STREAMS (SGU_PLAYER + 1)
+
+// Recorded bytes pulled per task call, one PIX request each,
+// and the pause once the VPU has none.
+#define SGU_REC_READS_PER_CALL 32
+#define SGU_REC_POLL_US        1000
+
+// Smallest ring, its halves must outlast a refill round trip.
+#define SGU_STREAM_RING_MIN 64
+
+static uint32_t sgu_pcm_src;
+static uint16_t sgu_pcm_dst;
+static uint32_t sgu_pcm_pending;
+
+// A PCM stream refills the halves of a PCM RAM ring in turn,
+// from PSRAM or an open file, padding with silence past the end.
+// The VPU asks for each half the channel is done playing.
+// The player's register stream pads with its end command instead,
+// or goes on at its loop point.
+typedef struct
+{
+    uint16_t ring;          // PCM RAM offset
+    uint16_t size;          // 0 when not streaming
+    FIL *fp;                // source file, nullptr for PSRAM
+    uint32_t src;           // next PSRAM address
+    uint32_t left;          // PSRAM bytes left
+    uint32_t base;          // PSRAM address or file offset of the start
+    uint32_t len;           // PSRAM bytes from base
+    uint32_t loop;          // offset from base to go on at, SGR_NO_LOOP
+    uint8_t pad;            // past the end
+    volatile uint8_t asked; // halves asked for, by the PIX IRQ
+    uint8_t filled;         // halves refilled
+    uint16_t done;          // bytes of the half being refilled
+} sgu_stream_t;
+
+// Both halves go before the channel starts.
+#define SGU_STREAM_PRIME 2
+
+static sgu_stream_t sgu_streams[SGU_STREAMS];
+static int sgu_stream_wait = -1; // channel the API waits to be primed
+
+// Register stream recording into an open file.
+static FIL *sgu_rec_fp;
+static bool sgu_rec_lost;
+static bool sgu_rec_stopping;
+static uint32_t sgu_rec_time; // of the last poll that found none
+
+void sgu_stop(void)
+{
+    sgu_pcm_pending = 0;
+    for (int i = 0; i < SGU_STREAMS; ++i)
+        sgu_streams[i].size = 0;
+    sgu_stream_wait = -1;
+    // the VPU recorder stops once its ring is full
+    sgu_rec_fp = nullptr;
+    sgu_rec_stopping = false;
+}
+
+void sgu_pcm_request(uint16_t payload)
+{
+    if (PIX_PCM_REQ_CHAN(payload) >= SGU_STREAMS)
+        return;
+    sgu_stream_t *st = &sgu_streams[PIX_PCM_REQ_CHAN(payload)];
+    if (!st->size)
+        return;
+    // halves go in turn, a lost request leaves one to catch up
+    if (PIX_PCM_REQ_HALF(payload) != (st->asked & 1))
+        ++st->asked;
+    ++st->asked;
+}
+
+static uint32_t sgu_stream_fetch(sgu_stream_t *st, uint8_t *buf, uint32_t len)
+{
+    uint32_t got = 0;
+    if (st->fp)
+    {
+        UINT br;
+        if (f_read(st->fp, buf, len, &br) == FR_OK)
+            got = br;
+    }
+    else
+    {
+        got = len < st->left ? len : st->left;
+        mem_read(buf, st->src, got);
+        st->src = (st->src + got) & 0xFFFFFF;
+        st->left -= got;
+    }
+    return got;
+}
+
+static void sgu_stream_read(sgu_stream_t *st, uint8_t *buf, uint32_t len)
+{
+    uint32_t got = sgu_stream_fetch(st, buf, len);
+    while (got < len && st->loop != SGR_NO_LOOP)
+    {
+        if (st->fp)
+        {
+            if (f_lseek(st->fp, st->base + st->loop) != FR_OK)
+                break;
+        }
+        else
+        {
+            st->src = (st->base + st->loop) & 0xFFFFFF;
+            st->left = st->len - st->loop;
+        }
+        const uint32_t more = sgu_stream_fetch(st, &buf[got], len - got);
+        if (!more)
+            break;
+        got += more;
+    }
+    // past the end the file is the CPU's again
+    if (got < len)
+    {
+        st->fp = nullptr;
+        st->loop = SGR_NO_LOOP;
+    }
+    memset(&buf[got], st->pad, len - got);
+}
+
+// Returns true while the half being refilled has frames to go.
+static bool sgu_stream_step(sgu_stream_t *st)
+{
+    const uint8_t half = st->filled & 1;
+    const uint16_t start = half ? st->size / 2 : 0;
+    const uint16_t len = half ? st->size - st->size / 2 : st->size / 2;
+    uint8_t msg[3 + PIX_SPU_PCM_WRITE_MAX];
+    msg[0] = PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_PCM_WRITE);
+    for (int i = 0; i < SGU_PCM_FRAMES_PER_CALL && st->done < len; ++i)
+    {
+        const uint16_t dst = st->ring + start + st->done;
+        const uint32_t run = len - st->done < PIX_SPU_PCM_WRITE_MAX ? len - st->done : PIX_SPU_PCM_WRITE_MAX;
+        msg[1] = (uint8_t)(dst & 0xFF);
+        msg[2] = (uint8_t)(dst >> 8);
+        sgu_stream_read(st, &msg[3], run);
+        pix_send_request(PIX_DEV_CMD, 3 + run, msg, nullptr);
+        st->done += run;
+    }
+    if (st->done < len)
+        return true;
+    st->done = 0;
+    ++st->filled;
+    return false;
+}
+
+// Blocks for the VPU's answer, requests from it
+// come in place of an ACK.
+static bool sgu_send_cmd(uint8_t len, const uint8_t *msg)
+{
+    pix_response_t resp = {0};
+    pix_send_request(PIX_DEV_CMD, len, msg, &resp);
+    while (!resp.status)
+        tight_loop_contents();
+    const uint8_t code = PIX_REPLY_CODE(resp.reply);
+    return code == PIX_ACK || code == PIX_DMA_REQ || code == PIX_PCM_REQ;
+}
+
+// Pulls recorded bytes into the file, returns true while more wait.
+static bool sgu_rec_drain(void)
+{
+    uint8_t buf[SGU_REC_READS_PER_CALL];
+    uint32_t n = 0;
+    bool more = true;
+    while (n < SGU_REC_READS_PER_CALL)
+    {
+        pix_response_t resp = {0};
+        pix_send_request(PIX_DEV_CMD, 1,
+                         (uint8_t[]) {PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_REC_READ)},
+                         &resp);
+        while (!resp.status)
+            tight_loop_contents();
+        const uint16_t payload = PIX_REPLY_PAYLOAD(resp.reply);
+        if (PIX_REPLY_CODE(resp.reply) != PIX_DEV_DATA || !(payload & PIX_SPU_REC_BYTE))
+        {
+            if (PIX_REPLY_CODE(resp.reply) != PIX_DEV_DATA || (payload & PIX_SPU_REC_LOST))
+                sgu_rec_lost = true;
+            more = false;
+            break;
+        }
+        buf[n++] = (uint8_t)payload;
+    }
+    UINT bw;
+    if (n && (f_write(sgu_rec_fp, buf, n, &bw) != FR_OK || bw != n))
+        sgu_rec_lost = true;
+    return more;
+}
+
+void sgu_task(void)
+{
+    for (int i = 0; i < SGU_STREAMS; ++i)
+    {
+        sgu_stream_t *st = &sgu_streams[i];
+        if (st->size && st->asked != st->filled && sgu_stream_step(st))
+            return;
+    }
+    if (sgu_rec_fp && time_us_32() - sgu_rec_time >= SGU_REC_POLL_US
+        && !sgu_rec_drain())
+        sgu_rec_time = time_us_32();
+}
+
+bool sgu_fil_busy(const FIL *fp)
+{
+    for (int i = 0; i < SGU_STREAMS; ++i)
+        if (sgu_streams[i].size && sgu_streams[i].fp == fp)
+            return true;
+    return sgu_rec_fp == fp;
+}
+
+void sgu_close_fil(FIL *fp)
+{
+    // the rest of the ring plays out, then silence or the end command
+    for (int i = 0; i < SGU_STREAMS; ++i)
+    {
+        sgu_stream_t *st = &sgu_streams[i];
+        if (st->fp == fp)
+        {
+            st->fp = nullptr;
+            st->left = 0;
+            st->loop = SGR_NO_LOOP;
+        }
+    }
+    if (sgu_rec_fp == fp)
+    {
+        // what the VPU still holds is lost, the file gets its end
+        sgu_send_cmd(2, (uint8_t[]) {PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_REC), 0});
+        const uint8_t end = SGR_END;
+        UINT bw;
+        f_write(sgu_rec_fp, &end, 1, &bw);
+        sgu_rec_fp = nullptr;
+        sgu_rec_stopping = false;
+    }
+}
+
+static bool sgu_stream_open(uint8_t chan, uint16_t ring, uint16_t size,
+                            FIL *fp, uint32_t src, uint32_t len)
+{
+    if (chan >= SGU_STREAMS
+        || size < SGU_STREAM_RING_MIN
+        || (uint32_t)ring + size > 0x10000)
+        return false;
+    sgu_stream_t *st = &sgu_streams[chan];
+    // out of the PIX IRQ's way until set up
+    st->size = 0;
+    __dmb();
+    st->ring = ring;
+    st->fp = fp;
+    st->src = src;
+    st->left = len;
+    st->base = src;
+    st->len = len;
+    st->loop = SGR_NO_LOOP;
+    st->pad = 0;
+    st->asked = SGU_STREAM_PRIME;
+    st->filled = 0;
+    st->done = 0;
+    __dmb();
+    st->size = size;
+    sgu_stream_wait = chan;
+    DBG("SGU stream %u, ring %04X+%04X\n", chan, ring, size);
+    return true;
+}
+
+static bool sgu_play_cmd(uint16_t ring, uint16_t size)
+{
+    return sgu_send_cmd(5, (uint8_t[]) {
+                               PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_PLAY),
+                               (uint8_t)(ring & 0xFF),
+                               (uint8_t)(ring >> 8),
+                               (uint8_t)(size & 0xFF),
+                               (uint8_t)(size >> 8),
+                           });
+}
+
+static bool sgu_stream_primed(void)
+{
+    const sgu_stream_t *st = &sgu_streams[sgu_stream_wait];
+    if (st->filled != SGU_STREAM_PRIME)
+        return api_working();
+    // the player starts on its own, channels when the CPU sets them up
+    const bool player = sgu_stream_wait == SGU_PLAYER;
+    sgu_stream_wait = -1;
+    if (player && !sgu_play_cmd(st->ring, st->size))
+        return api_return_errno(API_EIO);
+    return api_return_ax(0);
+}
+
+// Stops the player, or starts its stream once the header checks out.
+static bool sgu_play_open(uint16_t ring, uint16_t size, FIL *fp,
+                          uint32_t src, uint32_t len, const uint8_t *header)
+{
+    uint32_t loop;
+    if (!size)
+    {
+        sgu_streams[SGU_PLAYER].size = 0;
+        return sgu_play_cmd(0, 0) ? api_return_ax(0) : api_return_errno(API_EIO);
+    }
+    if (!sgr_header_loop(header, &loop)
+        || (!fp && loop != SGR_NO_LOOP && loop >= len)
+        || !sgu_stream_open(SGU_PLAYER, ring, size, fp, src, len))
+        return api_return_errno(API_EINVAL);
+    sgu_streams[SGU_PLAYER].loop = loop;
+    sgu_streams[SGU_PLAYER].pad = SGR_END;
+    return sgu_stream_primed();
+}
+
+bool sgu_api_pcm_stream(void)
+{
+    if (sgu_stream_wait < 0)
+    {
+        uint16_t ring, size;
+        uint32_t src, len;
+        if (!api_pop_uint16(&ring)
+            || !api_pop_uint16(&size)
+            || !api_pop_uint32(&src)
+            || !api_pop_uint32(&len)
+            || API_A >= SGU_CHANNELS
+            || !sgu_stream_open(API_A, ring, size, nullptr, src & 0xFFFFFF, len))
+            return api_return_errno(API_EINVAL);
+    }
+    return sgu_stream_primed();
+}
+
+bool sgu_api_pcm_stream_fd(void)
+{
+    if (sgu_stream_wait < 0)
+    {
+        uint16_t ring, size;
+        uint8_t fd;
+        FIL *fp;
+        if (!api_pop_uint16(&ring)
+            || !api_pop_uint16(&size)
+            || !api_pop_uint8(&fd)
+            || !(fp = std_fd_fil(fd))
+            || sgu_fil_busy(fp)
+            || API_A >= SGU_CHANNELS
+            || !sgu_stream_open(API_A, ring, size, fp, 0, 0))
+            return api_return_errno(API_EINVAL);
+    }
+    return sgu_stream_primed();
+}
+
+bool sgu_api_play(void)
+{
+    if (sgu_stream_wait >= 0)
+        return sgu_stream_primed();
+    uint16_t ring, size;
+    uint32_t src, len;
+    uint8_t header[SGR_HEADER_SIZE] = {0};
+    if (!api_pop_uint16(&ring)
+        || !api_pop_uint16(&size)
+        || !api_pop_uint32(&src)
+        || !api_pop_uint32(&len)
+        || (size && len < SGR_HEADER_SIZE))
+        return api_return_errno(API_EINVAL);
+    src &= 0xFFFFFF;
+    if (size)
+        for (int i = 0; i < SGR_HEADER_SIZE; ++i)
+            header[i] = mem_read_ram((src + i) & 0xFFFFFF);
+    return sgu_play_open(ring, size, nullptr, (src + SGR_HEADER_SIZE) & 0xFFFFFF,
+                         len - SGR_HEADER_SIZE, header);
+}
+
+bool sgu_api_play_fd(void)
+{
+    if (sgu_stream_wait >= 0)
+        return sgu_stream_primed();
+    uint16_t ring, size;
+    uint8_t fd;
+    FIL *fp = nullptr;
+    uint8_t header[SGR_HEADER_SIZE] = {0};
+    UINT br;
+    if (!api_pop_uint16(&ring)
+        || !api_pop_uint16(&size)
+        || !api_pop_uint8(&fd)
+        || (size && (!(fp = std_fd_fil(fd)) || sgu_fil_busy(fp))))
+        return api_return_errno(API_EINVAL);
+    if (fp && (f_read(fp, header, SGR_HEADER_SIZE, &br) != FR_OK || br != SGR_HEADER_SIZE))
+        return api_return_errno(API_EIO);
+    return sgu_play_open(ring, size, fp, fp ? (uint32_t)f_tell(fp) : 0, 0, header);
+}
+
+bool sgu_api_record(void)
+{
+    if (API_A != 0xFF)
+    {
+        FIL *fp = std_fd_fil(API_A);
+        uint8_t header[SGR_HEADER_SIZE];
+        UINT bw;
+        if (sgu_rec_fp || !fp || sgu_fil_busy(fp))
+            return api_return_errno(API_EINVAL);
+        sgr_header(header, SGR_NO_LOOP);
+        if (f_write(fp, header, SGR_HEADER_SIZE, &bw) != FR_OK || bw != SGR_HEADER_SIZE)
+            return api_return_errno(API_EIO);
+        if (!sgu_send_cmd(2, (uint8_t[]) {PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_REC), 1}))
+            return api_return_errno(API_EIO);
+        sgu_rec_fp = fp;
+        sgu_rec_lost = false;
+        sgu_rec_time = time_us_32() - SGU_REC_POLL_US;
+        return api_return_ax(0);
+    }
+
+    // stop, then take what is left
+    if (!sgu_rec_fp)
+        return api_return_errno(API_EINVAL);
+    if (!sgu_rec_stopping)
+    {
+        sgu_rec_stopping = true;
+        if (!sgu_send_cmd(2, (uint8_t[]) {PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_REC), 0}))
+            sgu_rec_lost = true;
+    }
+    if (!sgu_rec_lost && sgu_rec_drain())
+        return api_working();
+    const uint8_t end = SGR_END;
+    UINT bw;
+    if (f_write(sgu_rec_fp, &end, 1, &bw) != FR_OK || bw != 1)
+        sgu_rec_lost = true;
+    sgu_rec_fp = nullptr;
+    sgu_rec_stopping = false;
+    return sgu_rec_lost ? api_return_errno(API_EIO) : api_return_ax(0);
+}
+
+bool sgu_api_pcm_load(void)
+{
+    if (!sgu_pcm_pending)
+    {
+        uint16_t src_low16;
+        uint8_t src_high8;
+        if (!api_pop_uint16(&sgu_pcm_dst)
+            || !api_pop_uint16(&src_low16)
+            || !api_pop_uint8(&src_high8))
+            return api_return_errno(API_EINVAL);
+        sgu_pcm_src = ((uint32_t)src_high8 << 16) | src_low16;
+        sgu_pcm_pending = API_AX ? API_AX : 0x10000;
+        DBG("SGU PCM %06lX -> %04X, %lu bytes\n",
+            (unsigned long)sgu_pcm_src, sgu_pcm_dst, (unsigned long)sgu_pcm_pending);
+    }
+
+    uint8_t msg[3 + PIX_SPU_PCM_WRITE_MAX];
+    msg[0] = PIX_DEVICE_CMD(PIX_DEV_SPU, PIX_SPU_CMD_PCM_WRITE);
+    for (int i = 0; i < SGU_PCM_FRAMES_PER_CALL && sgu_pcm_pending; ++i)
+    {
+        const uint32_t run = sgu_pcm_pending < PIX_SPU_PCM_WRITE_MAX ? sgu_pcm_pending : PIX_SPU_PCM_WRITE_MAX;
+        msg[1] = (uint8_t)(sgu_pcm_dst & 0xFF);
+        msg[2] = (uint8_t)(sgu_pcm_dst >> 8);
+        mem_read(&msg[3], sgu_pcm_src, run);
+        sgu_pcm_src = (sgu_pcm_src + run) & 0xFFFFFF;
+        sgu_pcm_dst += run;
+        sgu_pcm_pending -= run;
+        if (sgu_pcm_pending)
+        {
+            pix_send_request(PIX_DEV_CMD, 3 + run, msg, nullptr);
+            continue;
+        }
+        // The last ack tells whether the VPU took them all.
+        pix_response_t resp = {0};
+        pix_send_request(PIX_DEV_CMD, 3 + run, msg, &resp);
+        while (!resp.status)
+            tight_loop_contents();
+        // requests from the VPU come in place of an ACK
+        const uint8_t code = PIX_REPLY_CODE(resp.reply);
+        if (code != PIX_ACK && code != PIX_DMA_REQ && code != PIX_PCM_REQ)
+            return api_return_errno(API_EIO);
+    }
+
+    return sgu_pcm_pending ? api_working() : api_return_ax(0);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _RIA_API_SGU_H_
+#define _RIA_API_SGU_H_
+
+/* SGU-1 PCM RAM upload from PSRAM.
+ * Sample data goes over PIX in full frames, the VPU passes
+ * it on to the SGU-1 in bulk SPI transfers.
+ *
+ * PCM streams keep a ring of PCM RAM filled from PSRAM or a file
+ * in the background. Once the API call returns, point the channel
+ * pcmpos and pcmrst at the ring, pcmbnd past its end, and set PCM
+ * in flags0 and the PCM stream flag in flags1. Clearing the flag
+ * stops the refills, past the end of the source the ring plays
+ * silence.
+ *
+ * Register streams play from a ring the same way, only the SGU-1
+ * player takes the place of the channel and starts once primed.
+ */
+
+#include "fatfs/ff.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Main events
+ */
+
+void sgu_task(void);
+void sgu_stop(void);
+
+// A stream, the player or the recording uses the open file.
+// The CPU may not read, write or seek it meanwhile.
+bool sgu_fil_busy(const FIL *fp);
+
+// The CPU closes the file, whatever uses it stops first.
+void sgu_close_fil(FIL *fp);
+
+// PIX_PCM_REQ from the VPU, called from the PIX IRQ.
+void sgu_pcm_request(uint16_t payload);
+
+// API copies AX bytes (0 for 64 KB) of PSRAM to PCM RAM.
+// Pops PCM RAM offset, source address low 16 bits and bank.
+bool sgu_api_pcm_load(void);
+
+// API streams PSRAM through a PCM RAM ring, channel in A.
+// Pops ring offset, ring size, source address and length.
+bool sgu_api_pcm_stream(void);
+
+// API streams an open file through a PCM RAM ring, channel in A.
+// Pops ring offset, ring size and file descriptor. The file is
+// the stream's until it runs out or the CPU closes it.
+bool sgu_api_pcm_stream_fd(void);
+
+// API plays an SGU-1 register stream (see sgr.h) from PSRAM through
+// a PCM RAM ring, timed to the sample by the SGU-1 itself.
+// Pops ring offset, ring size (0 stops playing), source address
+// and length, header included.
+bool sgu_api_play(void);
+
+// API plays a register stream from an open file through a PCM RAM ring.
+// Pops ring offset, ring size (0 stops playing) and file descriptor.
+// The file is the player's until it runs out or the CPU closes it.
+bool sgu_api_play_fd(void);
+
+// API records the register writes to the SGU-1 as a register stream
+// into the open file descriptor in A, 0xFF stops and finishes it.
+// Closing the file stops it too, dropping what the VPU still holds.
+bool sgu_api_record(void);
+
+#endif /* _RIA_API_SGU_H_ */
@@ -6,6 +6,7 @@
 
 #include "api/std.h"
 #include "api/api.h"
+#include "api/sgu.h"
 #include "fatfs/ff.h"
 #include "net/mdm.h"
 #include "sys/com.h"
@@ -89,6 +90,14 @@ bool std_api_open(void)
     return api_return_ax(fd + STD_FIL_OFFS);
 }
 
+FIL *std_fd_fil(int fd)
+{
+    if (fd < STD_FIL_OFFS || fd >= STD_FIL_MAX + STD_FIL_OFFS
+        || !std_fil[fd - STD_FIL_OFFS].obj.fs)
+        return nullptr;
+    return &std_fil[fd - STD_FIL_OFFS];
+}
+
 bool std_api_close(void)
 {
     int fd = API_A;
@@ -102,6 +111,8 @@ bool std_api_close(void)
     if (fd < STD_FIL_OFFS || fd >= STD_FIL_MAX + STD_FIL_OFFS)
         return api_return_errno(API_EINVAL);
     FIL *fp = &std_fil[fd - STD_FIL_OFFS];
+    // Background streams and recording let go of it first.
+    sgu_close_fil(fp);
     FRESULT fresult = f_close(fp);
     if (fresult != FR_OK)
         return api_return_fresult(fresult);
@@ -207,6 +218,8 @@ bool std_api_read_xstack(void)
             return api_working();
         }
         FIL *fp = &std_fil[fd - STD_FIL_OFFS];
+        if (sgu_fil_busy(fp))
+            return api_return_errno(API_EBUSY);
         UINT br;
         FRESULT fresult = f_read(fp, buf, count, &br);
         std_count_moved = br;
@@ -289,6 +302,8 @@ bool std_api_read_xram(void)
     // if (std_buf_ptr + count > (char *)xram + 0x10000)
     //     return api_return_errno(API_EINVAL);
     FIL *fp = &std_fil[fd - STD_FIL_OFFS];
+    if (sgu_fil_busy(fp))
+        return api_return_errno(API_EBUSY);
     UINT br;
     FRESULT fresult = f_read(fp, std_buf_ptr, count, &br);
     if (fresult == FR_OK)
@@ -358,6 +373,8 @@ bool std_api_write_xstack(void)
         return api_working();
     }
     FIL *fp = &std_fil[fd - STD_FIL_OFFS];
+    if (sgu_fil_busy(fp))
+        return api_return_errno(API_EBUSY);
     UINT bw;
     FRESULT fresult = f_write(fp, std_buf_ptr, count, &bw);
     if (fresult != FR_OK)
@@ -396,6 +413,8 @@ bool std_api_write_xram(void)
         return api_working();
     }
     FIL *fp = &std_fil[fd - STD_FIL_OFFS];
+    if (sgu_fil_busy(fp))
+        return api_return_errno(API_EBUSY);
     UINT bw;
     FRESULT fresult = f_write(fp, std_buf_ptr, count, &bw);
     if (fresult != FR_OK)
@@ -415,6 +434,8 @@ static bool std_api_lseek(int set, int cur, int end)
         || !api_pop_int32_end(&ofs))
         return api_return_errno(API_EINVAL);
     FIL *fp = &std_fil[fd - STD_FIL_OFFS];
+    if (sgu_fil_busy(fp))
+        return api_return_errno(API_EBUSY);
     if (whence == set)
         ; /* noop */
     else if (whence == cur)
@@ -10,6 +10,7 @@
 /* Provides STDIO to the CPU.
  */
 
+#include "fatfs/ff.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -34,4 +35,7 @@ bool std_api_lseek_llvm(void);
 bool std_api_syncfs(void);
 bool std_api_stdin_opt(void);
 
+// Open file behind a CPU file descriptor, nullptr when none.
+FIL *std_fd_fil(int fd);
+
 #endif /* _RIA_API_STD_H_ */
@@ -50,6 +50,7 @@
 // monitor console UART
 #define COM_UART           uart0
 #define COM_UART_BAUD_RATE 115200
+#define COM_DMA_IRQ_INDEX  1
 
 // CPU bus handling
 #define CPU_BUS_PIO_SPEED_KHZ 100000U
@@ -10,6 +10,8 @@
 #define MEM_SIZE                    (4 * 1024)
 #define MEMP_NUM_TCP_SEG            16
 #define PBUF_POOL_SIZE              16
+#define MEMP_NUM_TCP_PCB            10 // telnet + native sockets
+#define MEMP_NUM_UDP_PCB            12 // ntp, dns, dhcp + native sockets
 #define LWIP_ARP                    1
 #define LWIP_ETHERNET               1
 #define LWIP_ICMP                   1
@@ -11,19 +11,24 @@
 #include "api/dir.h"
 #include "api/oem.h"
 #include "api/rng.h"
+#include "api/sgu.h"
 #include "api/std.h"
 #include "hid/kbd.h"
 #include "hid/mou.h"
 #include "hid/pad.h"
 #include "mon/fil.h"
+#include "mon/hex.h"
 #include "mon/mon.h"
 #include "mon/ram.h"
 #include "mon/rom.h"
+#include "mon/xfr.h"
 #include "net/ble.h"
 #include "net/cyw.h"
 #include "net/mdm.h"
 #include "net/ntp.h"
+#include "net/skt.h"
 #include "net/wfi.h"
+#include "sys/blt.h"
 #include "sys/cfg.h"
 #include "sys/cia.h"
 #include "sys/com.h"
@@ -116,6 +121,9 @@ static void task(void)
     rln_task();
     fil_task();
     rom_task();
+    xfr_task();
+    hex_task();
+    sgu_task();
 }
 
 // Event to start running the CPU.
@@ -138,6 +146,7 @@ static void stop(void)
     vpu_stop(); // Must be before ria
     com_stop();
     api_stop();
+    blt_stop(); // Must be before ria
     ria_stop();
     pix_stop();
     oem_stop();
@@ -147,6 +156,8 @@ static void stop(void)
     mou_stop();
     pad_stop();
     mdm_stop();
+    skt_stop();
+    sgu_stop();
 }
 
 // Event for CTRL-ALT-DEL and UART breaks.
@@ -157,6 +168,8 @@ static void break_(void) // break is keyword
     mon_break();
     ram_break();
     rom_break();
+    xfr_break();
+    hex_break();
     vpu_break();
     rln_break();
 }
@@ -248,6 +261,40 @@ bool main_api(uint8_t operation)
         return dir_api_getlabel();
     case 0x2E:
         return dir_api_getfree();
+    case API_OP_SKT_SOCKET:
+        return skt_api_socket();
+    case API_OP_SKT_CONNECT:
+        return skt_api_connect();
+    case API_OP_SKT_BIND:
+        return skt_api_bind();
+    case API_OP_SKT_LISTEN:
+        return skt_api_listen();
+    case API_OP_SKT_ACCEPT:
+        return skt_api_accept();
+    case API_OP_SKT_SEND:
+        return skt_api_send();
+    case API_OP_SKT_RECV:
+        return skt_api_recv();
+    case API_OP_SKT_SENDTO:
+        return skt_api_sendto();
+    case API_OP_SKT_RECVFROM:
+        return skt_api_recvfrom();
+    case API_OP_SKT_POLL:
+        return skt_api_poll();
+    case API_OP_SKT_CLOSE:
+        return skt_api_close();
+    case API_OP_SGU_PCM_LOAD:
+        return sgu_api_pcm_load();
+    case API_OP_SGU_STREAM:
+        return sgu_api_pcm_stream();
+    case API_OP_SGU_STREAM_FD:
+        return sgu_api_pcm_stream_fd();
+    case API_OP_SGU_PLAY:
+        return sgu_api_play();
+    case API_OP_SGU_PLAY_FD:
+        return sgu_api_play_fd();
+    case API_OP_SGU_RECORD:
+        return sgu_api_record();
     }
     return api_return_errno(API_ENOSYS);
 }
@@ -0,0 +1,299 @@
+/*
+ * blitter.c  Check the RIA blitter on the host and estimate its speed
+ *
+ * gcc blitter.c ../sys/blt.c -O2 -o blitter -Wall -Ihost -I..
+ *
+ * ./blitter [-n blits] [-s seed]
+ *
+ * Runs random blits through sys/blt.c over a 16 MB RAM model and
+ * compares RAM with a plain byte loop. The VPU side applies the PIX
+ * messages the blits send to its own copy, which has to match too.
+ *
+ * Timings are estimates: 32-bit PSRAM accesses through the XIP
+ * window, PIX bus bytes and replies as below. Per-byte mirroring
+ * is what the CPU writing each byte costs on the PIX bus alone.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../pix.h"
+#include "../sys/blt.h"
+#include "../sys/mem.h"
+#include "../sys/ria.h"
+
+#define RAM_SIZE 0x1000000
+
+// Model timings
+#define PSRAM_READ_NS  196 // QPI 32-bit read at 112 MHz, incl. command
+#define PSRAM_WRITE_NS 143 // QPI 32-bit write
+#define PIX_BYTE_NS    190 // handshaken byte at 42 MHz PIO clock
+#define PIX_FRAME_NS   1000 // reply and VPU interrupt per message
+
+volatile uint8_t regs[0x40];
+
+static uint8_t *ram;  // PSRAM
+static uint8_t *vram; // what the VPU saw
+static uint8_t *ref;  // expected RAM
+
+static uint64_t psram_words;
+static uint64_t psram_write_words;
+static uint64_t pix_bytes;
+static uint64_t pix_frames;
+static uint8_t irq_state;
+
+void ria_set_irq(uint8_t source)
+{
+    irq_state |= source;
+}
+
+void ria_clear_irq(uint8_t source)
+{
+    irq_state &= ~source;
+}
+
+static void check_blk(uint32_t addr24, size_t len)
+{
+    if (!len || (addr24 & 0xFFFF) + len > 0x10000 || addr24 >= RAM_SIZE)
+    {
+        fprintf(stderr, "block %06X+%zu crosses a bank\n", addr24, len);
+        exit(1);
+    }
+}
+
+static uint64_t words(uint32_t addr24, size_t len)
+{
+    return ((addr24 + len + 3) >> 2) - (addr24 >> 2);
+}
+
+static void pix_frame(size_t len)
+{
+    pix_bytes += 1 + len;
+    ++pix_frames;
+}
+
+void mem_read_blk(uint32_t addr24, uint8_t *buf, size_t len)
+{
+    check_blk(addr24, len);
+    memcpy(buf, &ram[addr24], len);
+    psram_words += words(addr24, len);
+}
+
+void mem_write_blk(uint32_t addr24, const uint8_t *buf, size_t len)
+{
+    check_blk(addr24, len);
+    memcpy(&ram[addr24], buf, len);
+    psram_write_words += words(addr24, len);
+    for (size_t off = 0; off < len; off += PIX_MEM_WRITE_MAX)
+    {
+        const size_t run = len - off < PIX_MEM_WRITE_MAX ? len - off : PIX_MEM_WRITE_MAX;
+        memcpy(&vram[addr24 + off], buf + off, run);
+        pix_frame(3 + run);
+    }
+}
+
+void mem_fill_blk(uint32_t addr24, uint8_t data, size_t len)
+{
+    check_blk(addr24, len);
+    memset(&ram[addr24], data, len);
+    psram_write_words += words(addr24, len);
+    memset(&vram[addr24], data, len);
+    pix_frame(6);
+}
+
+static void set_regs(uint32_t src, uint32_t dst, uint8_t fill, uint8_t mask,
+                     uint32_t width, uint32_t height, int sstride, int dstride)
+{
+    regs[BLT_REG_SRC & 0x3F] = src;
+    regs[(BLT_REG_SRC + 1) & 0x3F] = src >> 8;
+    regs[(BLT_REG_SRC + 2) & 0x3F] = src >> 16;
+    regs[BLT_REG_FILL & 0x3F] = fill;
+    regs[BLT_REG_DST & 0x3F] = dst;
+    regs[(BLT_REG_DST + 1) & 0x3F] = dst >> 8;
+    regs[(BLT_REG_DST + 2) & 0x3F] = dst >> 16;
+    regs[BLT_REG_MASK & 0x3F] = mask;
+    regs[BLT_REG_WIDTH & 0x3F] = width;
+    regs[(BLT_REG_WIDTH + 1) & 0x3F] = width >> 8;
+    regs[BLT_REG_HEIGHT & 0x3F] = height;
+    regs[BLT_REG_SSTRIDE & 0x3F] = sstride;
+    regs[(BLT_REG_SSTRIDE + 1) & 0x3F] = sstride >> 8;
+    regs[BLT_REG_DSTRIDE & 0x3F] = dstride;
+    regs[(BLT_REG_DSTRIDE + 1) & 0x3F] = dstride >> 8;
+}
+
+static uint64_t run_blit(uint8_t op)
+{
+    uint64_t steps = 0;
+    blt_start(BLT_CTRL_START | BLT_CTRL_IRQ | op);
+    while (blt_active())
+    {
+        blt_step();
+        ++steps;
+    }
+    const uint8_t irq = irq_state;
+    const uint8_t status = blt_status();
+    if (!(status & BLT_STAT_DONE) || (status & BLT_STAT_BUSY) || !(irq & RIA_IRQ_SOURCE_BLT))
+    {
+        fprintf(stderr, "bad status %02X, irq %02X\n", status, irq);
+        exit(1);
+    }
+    if ((blt_status() & BLT_STAT_DONE) || irq_state)
+    {
+        fprintf(stderr, "status read did not acknowledge\n");
+        exit(1);
+    }
+    return steps;
+}
+
+// What the blit means, reading all sources before writing.
+static void ref_blit(uint8_t op, uint32_t src, uint32_t dst, uint8_t fill, uint8_t mask,
+                     uint32_t width, uint32_t height, int sstride, int dstride)
+{
+    static uint8_t snapshot[RAM_SIZE];
+    memcpy(snapshot, ref, RAM_SIZE);
+    for (uint32_t r = 0; r < height; ++r)
+        for (uint32_t c = 0; c < width; ++c)
+        {
+            const uint32_t s = (src + r * sstride + c) & 0xFFFFFF;
+            const uint32_t d = (dst + r * dstride + c) & 0xFFFFFF;
+            switch (op)
+            {
+            case BLT_OP_COPY:
+                ref[d] = snapshot[s];
+                break;
+            case BLT_OP_FILL:
+                ref[d] = fill;
+                break;
+            case BLT_OP_MASK:
+                ref[d] = (snapshot[s] & mask) | (snapshot[d] & ~mask);
+                break;
+            case BLT_OP_KEY:
+                ref[d] = snapshot[s] == fill ? snapshot[d] : snapshot[s];
+                break;
+            }
+        }
+}
+
+static uint32_t rnd(uint32_t n)
+{
+    return (uint32_t)random() % n;
+}
+
+static void check(int n)
+{
+    if (memcmp(ram, ref, RAM_SIZE))
+    {
+        fprintf(stderr, "blit %d: RAM differs\n", n);
+        exit(1);
+    }
+    if (memcmp(vram, ref, RAM_SIZE))
+    {
+        fprintf(stderr, "blit %d: VPU copy differs\n", n);
+        exit(1);
+    }
+}
+
+static void test(int n)
+{
+    const uint8_t op = rnd(4);
+    uint32_t width = 1 + rnd(rnd(4) ? 300 : 70000);
+    uint32_t height = 1 + rnd(width > 1000 ? 2 : 40);
+    int sstride, dstride;
+    uint32_t src, dst;
+    if (op == BLT_OP_COPY && rnd(2))
+    {
+        // overlapping copy, rows must not overlap each other
+        if (height > 1)
+            width = width % 200 + 1;
+        else if (width > 0xFFFF)
+            width = 0x10000;
+        sstride = dstride = height > 1 ? (int)(width + rnd(50)) : 0;
+        src = 0x100000 + rnd(RAM_SIZE - 0x200000);
+        dst = src + rnd(2 * width + 1) - width;
+    }
+    else
+    {
+        // separate banks, destination rows must not overlap each other
+        if (width > 0xFFFF)
+            width = 0x10000;
+        if (width > 0x4000)
+            height = 1;
+        sstride = (int)rnd(1200) - 600;
+        dstride = (int)(width + rnd(600)) * (rnd(2) ? 1 : -1);
+        src = rnd(RAM_SIZE / 2);
+        dst = RAM_SIZE / 2 + rnd(RAM_SIZE / 2);
+    }
+    const uint8_t fill = rnd(4) ? rnd(256) : 0;
+    const uint8_t mask = rnd(256);
+
+    set_regs(src, dst, fill, mask, width & 0xFFFF, height & 0xFF, sstride, dstride);
+    run_blit(op);
+    ref_blit(op, src, dst, fill, mask, width, height, sstride, dstride);
+    check(n);
+}
+
+static void bench(const char *name, uint8_t op, uint32_t src, uint32_t dst,
+                  uint32_t width, uint32_t height, int sstride, int dstride)
+{
+    psram_words = psram_write_words = pix_bytes = pix_frames = 0;
+    set_regs(src, dst, 0, 0x0F, width & 0xFFFF, height & 0xFF, sstride, dstride);
+    const uint64_t steps = run_blit(op);
+    const uint64_t bytes = (uint64_t)width * height;
+    const double psram_us = (psram_words * PSRAM_READ_NS + psram_write_words * PSRAM_WRITE_NS) / 1000.;
+    const double pix_us = (pix_bytes * PIX_BYTE_NS + pix_frames * PIX_FRAME_NS) / 1000.;
+    const double us = psram_us + pix_us;
+    const double cpu_pix_us = bytes * (5 * PIX_BYTE_NS + PIX_FRAME_NS) / 1000.;
+    printf("%-22s %7llu B %6llu steps %9.0f us %6.2f B/us  PIX %7llu B, per-byte %8llu B, %5.1fx\n",
+           name, (unsigned long long)bytes, (unsigned long long)steps, us, bytes / us,
+           (unsigned long long)pix_bytes, (unsigned long long)bytes * 5, cpu_pix_us / pix_us);
+}
+
+int main(int argc, char *argv[])
+{
+    int blits = 2000;
+    unsigned seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            blits = atoi(optarg);
+            break;
+        case 's':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n blits] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ram = malloc(RAM_SIZE);
+    vram = malloc(RAM_SIZE);
+    ref = malloc(RAM_SIZE);
+    if (!ram || !vram || !ref)
+        return 1;
+    srandom(seed);
+    for (uint32_t i = 0; i < RAM_SIZE; ++i)
+        ram[i] = random();
+    memcpy(vram, ram, RAM_SIZE);
+    memcpy(ref, ram, RAM_SIZE);
+
+    for (int n = 0; n < blits; ++n)
+        test(n);
+    printf("%d blits match\n", blits);
+
+    bench("fill 64 KB bank", BLT_OP_FILL, 0, 0x010000, 0x10000, 1, 0, 0);
+    bench("copy 64 KB bank", BLT_OP_COPY, 0x020000, 0x010000, 0x10000, 1, 0, 0);
+    bench("scroll 40x25 up 1 row", BLT_OP_COPY, 0x010028, 0x010000, 40 * 24, 1, 0, 0);
+    bench("masked 320x200 4bpp", BLT_OP_MASK, 0x020000, 0x010000, 160, 200, 160, 160);
+    bench("keyed 32x32 sprite", BLT_OP_KEY, 0x020000, 0x011000, 32, 32, 32, 320);
+    return 0;
+}
@@ -0,0 +1,342 @@
+/*
+ * hex.c  Check the monitor HEX loader on the host
+ *
+ * gcc hex.c ../mon/hex.c -O2 -o hex -Wall -Ihost -I..
+ *
+ * ./hex
+ *
+ * Feeds Intel HEX and Motorola S-record files through mon/hex.c as
+ * the console would and compares a 16 MB RAM model with what the
+ * records say. Block writes have to stay within a bank and clear of
+ * the RIA registers, which take their bytes one at a time.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../mon/hex.h"
+#include "../mon/mon.h"
+#include "../sys/mem.h"
+#include "../sys/ria.h"
+#include <pico/stdlib.h>
+
+#define RAM_SIZE 0x1000000
+
+uint8_t mbuf[MBUF_SIZE];
+size_t mbuf_len;
+
+static uint8_t *ram; // PSRAM
+static uint8_t *ref; // expected RAM
+static uint8_t ria_regs[0x40];
+static uint32_t ria_writes;
+
+static uint64_t now_us;
+static char input[0x40000];
+static size_t input_len;
+static size_t input_pos;
+
+static char response[256];
+static unsigned long records;
+static unsigned long bytes;
+static unsigned long errors;
+static unsigned long first_error;
+
+/* Pico SDK and firmware stand-ins
+ */
+
+absolute_time_t get_absolute_time(void)
+{
+    return now_us;
+}
+
+absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return now_us + (uint64_t)ms * 1000;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t)(to - from);
+}
+
+int stdio_getchar_timeout_us(uint32_t timeout_us)
+{
+    (void)timeout_us;
+    if (input_pos == input_len)
+        return PICO_ERROR_TIMEOUT;
+    return (unsigned char)input[input_pos++];
+}
+
+void stdio_flush(void)
+{
+    fflush(stdout);
+}
+
+int str_xdigit_to_int(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    return ch - 'a' + 10;
+}
+
+void mem_write_blk(uint32_t addr24, const uint8_t *buf, size_t len)
+{
+    if (!len || (addr24 & 0xFFFF) + len > 0x10000 || addr24 + len > RAM_SIZE)
+    {
+        fprintf(stderr, "block %06X+%zu crosses a bank\n", addr24, len);
+        exit(1);
+    }
+    if (addr24 < 0x10000 && addr24 + len > 0xFFC0)
+    {
+        fprintf(stderr, "block %06X+%zu covers the RIA registers\n", addr24, len);
+        exit(1);
+    }
+    memcpy(&ram[addr24], buf, len);
+}
+
+void ria_write_mem(uint32_t addr24, uint8_t data)
+{
+    if (addr24 < 0xFFC0 || addr24 > 0xFFFF)
+    {
+        fprintf(stderr, "register write to %06X\n", addr24);
+        exit(1);
+    }
+    ria_regs[addr24 & 0x3F] = data;
+    ram[addr24] = data;
+    ++ria_writes;
+}
+
+void mon_add_response_str(const char *str)
+{
+    snprintf(response, sizeof(response), "%s", str);
+}
+
+void mon_add_response_fn(mon_response_fn fn)
+{
+    char buf[128];
+    response[0] = 0;
+    for (int state = 0; state >= 0;)
+    {
+        state = fn(buf, sizeof(buf), state);
+        strncat(response, buf, sizeof(response) - strlen(response) - 1);
+    }
+    errors = first_error = 0;
+    const char *err = strchr(response, '?');
+    if (sscanf(response, "%lu records, %lu bytes", &records, &bytes) != 2 ||
+        (err && sscanf(err, "?%lu bad records, first on line %lu", &errors, &first_error) != 2))
+    {
+        fprintf(stderr, "bad stats: %s", response);
+        exit(1);
+    }
+}
+
+/* Record writers
+ */
+
+static void line(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    input_len += vsnprintf(&input[input_len], sizeof(input) - input_len, fmt, ap);
+    va_end(ap);
+}
+
+static void intel(uint8_t type, uint16_t addr, const uint8_t *data, uint8_t len, uint8_t bad)
+{
+    uint8_t sum = len + (addr >> 8) + addr + type;
+    line(":%02X%04X%02X", len, addr, type);
+    for (int i = 0; i < len; i++)
+    {
+        line("%02X", data[i]);
+        sum += data[i];
+    }
+    line("%02X\r\n", (uint8_t)(-sum + bad));
+}
+
+static void intel_base(uint8_t type, uint16_t base)
+{
+    const uint8_t data[2] = {base >> 8, base & 0xFF};
+    intel(type, 0, data, 2, 0);
+}
+
+static void srec(char type, uint32_t addr, const uint8_t *data, uint8_t len, uint8_t bad)
+{
+    const int addr_len = type == '2' || type == '8' ? 3 : type == '3' || type == '7' ? 4 : 2;
+    uint8_t sum = len + addr_len + 1;
+    line("S%c%02X", type, len + addr_len + 1);
+    for (int i = addr_len - 1; i >= 0; i--)
+    {
+        line("%02X", (addr >> i * 8) & 0xFF);
+        sum += addr >> i * 8;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        line("%02X", data[i]);
+        sum += data[i];
+    }
+    line("%02X\n", (uint8_t)(~sum + bad));
+}
+
+// Random data in the record, which the load has to land in RAM.
+static const uint8_t *fill(uint32_t addr, uint8_t len)
+{
+    static uint8_t data[255];
+    for (int i = 0; i < len; i++)
+        data[i] = ref[addr + i] = rand();
+    return data;
+}
+
+/* Cases
+ */
+
+static int failed;
+
+static void run(const char *name, unsigned long want_records, unsigned long want_errors,
+                unsigned long want_first_error)
+{
+    printf("%-28s", name);
+    hex_mon_hex("", 0);
+    input_pos = 0;
+    records = bytes = errors = first_error = 0;
+    response[0] = 0;
+    while (hex_active())
+    {
+        hex_task();
+        now_us += 1000;
+    }
+    size_t diff = 0;
+    while (diff < RAM_SIZE && ram[diff] == ref[diff])
+        ++diff;
+    if (diff < RAM_SIZE)
+        printf("RAM differs at %06zX: %02X, expected %02X\n", diff, ram[diff], ref[diff]);
+    else if (records != want_records || errors != want_errors || first_error != want_first_error)
+        printf("%lu records, %lu errors on line %lu, expected %lu, %lu on %lu\n", records,
+               errors, first_error, want_records, want_errors, want_first_error);
+    else if (input_pos != input_len)
+        printf("stopped at %zu of %zu\n", input_pos, input_len);
+    else
+    {
+        printf("ok, %lu bytes\n", bytes);
+        input_len = 0;
+        return;
+    }
+    ++failed;
+    input_len = 0;
+    memcpy(ram, ref, RAM_SIZE);
+}
+
+static void reset_vector(uint16_t addr)
+{
+    ref[0xFFFC] = addr & 0xFF;
+    ref[0xFFFD] = addr >> 8;
+}
+
+int main(void)
+{
+    ram = calloc(RAM_SIZE, 1);
+    ref = calloc(RAM_SIZE, 1);
+    if (!ram || !ref)
+        return 1;
+    srand(1);
+
+    // Records as printed in the format descriptions.
+    line(":10010000214601360121470136007EFE09D2190140\n");
+    line(":100110002146017E17C20001FF5F16002148011928\n");
+    line(":00000001FF\n");
+    memcpy(&ref[0x100], "\x21\x46\x01\x36\x01\x21\x47\x01\x36\x00\x7E\xFE\x09\xD2\x19\x01"
+                        "\x21\x46\x01\x7E\x17\xC2\x00\x01\xFF\x5F\x16\x00\x21\x48\x01\x19",
+           32);
+    run("intel sample", 3, 0, 0);
+
+    line("S00F000068656C6C6F202020202000003C\n");
+    line("S11F00007C0802A6900100049421FFF07C6C1B787C8C23783C6000003863000026\n");
+    line("S11F001C4BFFFFE5398000007D83637880010014382100107C0803A64E800020E9\n");
+    line("S111003848656C6C6F20776F726C642E0A0042\n");
+    line("S5030003F9\n");
+    line("S9030000FC\n");
+    memcpy(&ref[0x00], "\x7C\x08\x02\xA6\x90\x01\x00\x04\x94\x21\xFF\xF0\x7C\x6C\x1B\x78"
+                       "\x7C\x8C\x23\x78\x3C\x60\x00\x00\x38\x63\x00\x00",
+           28);
+    memcpy(&ref[0x1C], "\x4B\xFF\xFF\xE5\x39\x80\x00\x00\x7D\x83\x63\x78\x80\x01\x00\x14"
+                       "\x38\x21\x00\x10\x7C\x08\x03\xA6\x4E\x80\x00\x20",
+           28);
+    memcpy(&ref[0x38], "Hello world.\n", 14);
+    reset_vector(0x0000);
+    run("srec sample", 6, 0, 0);
+
+    // Every address record, a run across banks and the registers.
+    intel(0, 0x0200, fill(0x0200, 16), 16, 0);
+    intel_base(2, 0x1000);
+    intel(0, 0x0010, fill(0x10010, 32), 32, 0);
+    intel_base(4, 0x0002);
+    for (uint32_t addr = 0xFF00; addr < 0x10000; addr += 32)
+        intel(0, addr, fill(0x20000 + addr, 32), 32, 0);
+    intel_base(4, 0x0003);
+    intel(0, 0x0000, fill(0x30000, 32), 32, 0);
+    intel_base(4, 0x0000);
+    intel(0, 0xFFB0, fill(0xFFB0, 32), 32, 0);
+    intel(5, 0, (const uint8_t[]){0x00, 0x00, 0x12, 0x34}, 4, 0);
+    reset_vector(0x1234);
+    intel(1, 0, NULL, 0, 0);
+    run("intel records", 18, 0, 0);
+
+    srec('0', 0, (const uint8_t *)"hdr", 3, 0);
+    srec('1', 0x0400, fill(0x0400, 64), 64, 0);
+    srec('2', 0x05FFE0, fill(0x05FFE0, 64), 64, 0);
+    srec('3', 0x00FFF0, fill(0xFFF0, 16), 16, 0);
+    srec('3', 0xFFFFF0, fill(0xFFFFF0, 16), 16, 0);
+    srec('5', 4, NULL, 0, 0);
+    srec('7', 0x00C000, NULL, 0, 0);
+    reset_vector(0xC000);
+    run("srec records", 7, 0, 0);
+
+    srec('8', 0x00D000, NULL, 0, 0);
+    reset_vector(0xD000);
+    run("srec S8 end", 1, 0, 0);
+
+    // Contiguous data longer than mbuf, flushed more than once.
+    for (uint32_t addr = 0x1000; addr < 0x1000 + 3 * MBUF_SIZE + 100; addr += 200)
+        srec('1', addr, fill(addr, 200), 200, 0);
+    run("srec runs past mbuf", 16, 0, 0);
+
+    // Bad records load nothing and count once each.
+    intel(0, 0x3000, fill(0x3000, 16), 16, 0);
+    intel(0, 0x3010, (const uint8_t[16]){0xEE}, 16, 1);
+    intel(6, 0x0000, NULL, 0, 0);
+    intel(2, 0x0000, (const uint8_t[]){0x10}, 1, 0);
+    line(":0000000G01\n");
+    line(":00000001F\n");
+    line("X0000\n");
+    intel(0, 0x3020, fill(0x3020, 16), 16, 0);
+    intel(1, 0, NULL, 0, 0);
+    run("intel bad records", 3, 6, 2);
+
+    srec('1', 0x4000, fill(0x4000, 8), 8, 0);
+    srec('1', 0x4008, (const uint8_t[8]){0xEE}, 8, 0x10);
+    srec('4', 0x4010, (const uint8_t[8]){0xEE}, 8, 0);
+    line("S10200FD\n");
+    line("S10300\n");
+    srec('3', 0xFFFFFC, (const uint8_t[8]){0xEE}, 8, 0);
+    line("S1%0600d\n", 0);
+    srec('9', 0x0000, NULL, 0, 0);
+    reset_vector(0x0000);
+    run("srec bad records", 2, 6, 2);
+
+    // A file without an end record loads when the console goes quiet.
+    intel(0, 0x5000, fill(0x5000, 16), 16, 0);
+    line(":10501000");
+    for (int i = 0; i < 16; i++)
+        line("%02X", ref[0x5010 + i] = i);
+    line("%02X", (uint8_t)-(0x10 + 0x50 + 0x10 + 120));
+    run("timeout", 2, 0, 0);
+
+    return failed ? 1 : 0;
+}
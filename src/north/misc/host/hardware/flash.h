@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_FLASH_H_
+#define _HOST_HARDWARE_FLASH_H_
+
+// Only the page size is used, to size littlefs file buffers.
+
+#define FLASH_PAGE_SIZE (1u << 8)
+
+#endif /* _HOST_HARDWARE_FLASH_H_ */
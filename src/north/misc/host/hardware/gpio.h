@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_GPIO_H_
+#define _HOST_HARDWARE_GPIO_H_
+
+#include "pico.h"
+
+// Pins go nowhere on the host.
+
+static inline void gpio_put(uint gpio, bool value)
+{
+    (void)gpio, (void)value;
+}
+
+#endif /* _HOST_HARDWARE_GPIO_H_ */
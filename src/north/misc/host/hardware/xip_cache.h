@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_XIP_CACHE_H_
+#define _HOST_HARDWARE_XIP_CACHE_H_
+
+// PSRAM is a plain array on the host, nothing is cached.
+
+static inline void xip_cache_clean_all(void)
+{
+}
+
+static inline void xip_cache_invalidate_all(void)
+{
+}
+
+#endif /* _HOST_HARDWARE_XIP_CACHE_H_ */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_LITTLEFS_LFS_H_
+#define _HOST_LITTLEFS_LFS_H_
+
+/* The littlefs API mon/xfr.c uses, see misc/xfr.c.
+ * There is no file system on the host, the tool fails every call.
+ */
+
+#include <stdint.h>
+
+#ifndef LFS_NAME_MAX
+#define LFS_NAME_MAX 255
+#endif
+
+enum lfs_open_flags {
+    LFS_O_RDONLY = 1,
+    LFS_O_WRONLY = 2,
+    LFS_O_RDWR = 3,
+    LFS_O_CREAT = 0x0100,
+    LFS_O_EXCL = 0x0200,
+    LFS_O_TRUNC = 0x0400,
+    LFS_O_APPEND = 0x0800,
+};
+
+typedef int32_t lfs_ssize_t;
+typedef uint32_t lfs_size_t;
+
+typedef struct lfs
+{
+    int unused;
+} lfs_t;
+
+typedef struct lfs_file
+{
+    int unused;
+} lfs_file_t;
+
+struct lfs_file_config
+{
+    void *buffer;
+};
+
+int lfs_file_opencfg(lfs_t *lfs, lfs_file_t *file, const char *path, int flags,
+                     const struct lfs_file_config *config);
+lfs_ssize_t lfs_file_write(lfs_t *lfs, lfs_file_t *file, const void *buffer, lfs_size_t size);
+int lfs_file_close(lfs_t *lfs, lfs_file_t *file);
+
+#endif /* _HOST_LITTLEFS_LFS_H_ */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_LITTLEFS_LFS_UTIL_H_
+#define _HOST_LITTLEFS_LFS_UTIL_H_
+
+#include "lfs.h"
+#include <stddef.h>
+
+// Same CRC-32 as littlefs, without the final inversion.
+uint32_t lfs_crc(uint32_t crc, const void *buffer, size_t size);
+
+#endif /* _HOST_LITTLEFS_LFS_UTIL_H_ */
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_PICO_H_
+#define _HOST_PICO_H_
+
+/* Just enough of the Pico SDK to build sys/blt.c and mon/hex.c on a Linux box,
+ * see misc/blitter.c and misc/hex.c. Memory the models keep is defined there.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define PICO_SDK_VERSION_MAJOR 2
+
+#define __force_inline                 inline __attribute__((always_inline))
+#define __not_in_flash_func(func_name) func_name
+
+#endif /* _HOST_PICO_H_ */
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_PICO_STDLIB_H_
+#define _HOST_PICO_STDLIB_H_
+
+/* Time and console for mon/hex.c on the host, see misc/hex.c.
+ * The tool owns the clock and the input.
+ */
+
+#include "pico.h"
+
+#define __in_flash(group)
+
+#define PICO_ERROR_TIMEOUT (-1)
+
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time(void);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+
+int stdio_getchar_timeout_us(uint32_t timeout_us);
+void stdio_flush(void);
+
+#endif /* _HOST_PICO_STDLIB_H_ */
@@ -0,0 +1,245 @@
+/*
+ * vpack.c  Measure packed VRAM cache transfers on the host
+ *
+ * gcc vpack.c ../../pix_pack.c -O2 -o vpack -Wall -I../..
+ *
+ * ./vpack [bank.bin ...]
+ *
+ * Packs each 64 KB bank the way pix_dma_scan() does for a full
+ * transfer, unpacks the frames into a VPU cache slot and checks it.
+ * Without files it uses a few generated banks: empty, text screen
+ * with attributes, tile map, bitmap and noise.
+ *
+ * Bus time is estimated as in blitter.c. Decode cycles are a model of
+ * the VPU at 1 cycle per 4 bytes copied or filled plus 12 per token;
+ * host decode time is measured.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pix.h"
+#include "pix_pack.h"
+
+#define PIX_BYTE_NS  190  // handshaken byte at 42 MHz PIO clock
+#define PIX_FRAME_NS 1000 // reply and VPU interrupt per message
+
+#define DECODE_TOKEN_CYCLES 12
+
+typedef struct
+{
+    uint8_t data[32];
+    uint8_t len;
+} frame_t;
+
+static frame_t frames[0x10000 / PIX_VCACHE_ROW_SIZE * 2];
+static size_t frame_count;
+static uint64_t decode_cycles;
+
+static void send(const uint8_t *data, size_t len)
+{
+    memcpy(frames[frame_count].data, data, len);
+    frames[frame_count++].len = len;
+}
+
+// Full transfer of bank, as pix_dma_scan() and pix_dma_step() send it.
+static void pack_bank(const uint8_t *bank)
+{
+    static uint8_t queue[PIX_PACK_FRAME_MAX + 3 + PIX_VCACHE_BLOCK_SIZE];
+    size_t queue_len = 0;
+    frame_count = 0;
+    for (uint32_t block = 0; block < 0x10000; block += PIX_VCACHE_BLOCK_SIZE)
+    {
+        const size_t packed = pix_pack(&bank[block], PIX_VCACHE_BLOCK_SIZE,
+                                       &queue[queue_len], PIX_VCACHE_BLOCK_SIZE - 1);
+        if (packed)
+            queue_len += packed;
+        else
+        {
+            // raw rows follow, flush the queue first
+            while (queue_len)
+            {
+                const size_t len = pix_pack_frame(queue, queue_len);
+                send(queue, len);
+                queue_len -= len;
+                memmove(queue, &queue[len], queue_len);
+            }
+            for (uint32_t row = 0; row < PIX_VCACHE_BLOCK_SIZE; row += PIX_VCACHE_ROW_SIZE)
+                send(&bank[block + row], PIX_VCACHE_ROW_SIZE);
+        }
+        while (queue_len >= PIX_PACK_FRAME_MAX || (queue_len && block + PIX_VCACHE_BLOCK_SIZE == 0x10000))
+        {
+            const size_t len = pix_pack_frame(queue, queue_len);
+            send(queue, len);
+            queue_len -= len;
+            memmove(queue, &queue[len], queue_len);
+        }
+    }
+}
+
+static int unpack_bank(uint8_t *slot)
+{
+    uint8_t *dest = slot;
+    for (size_t i = 0; i < frame_count; ++i)
+    {
+        const frame_t *f = &frames[i];
+        if (f->len == PIX_VCACHE_ROW_SIZE)
+        {
+            memcpy(dest, f->data, PIX_VCACHE_ROW_SIZE);
+            dest += PIX_VCACHE_ROW_SIZE;
+            continue;
+        }
+        dest = pix_unpack(slot, dest, f->data, f->len);
+        if (!dest)
+            return -1;
+    }
+    return 0;
+}
+
+static void count_decode(void)
+{
+    decode_cycles = 0;
+    for (size_t i = 0; i < frame_count; ++i)
+    {
+        const frame_t *f = &frames[i];
+        if (f->len == PIX_VCACHE_ROW_SIZE)
+        {
+            decode_cycles += PIX_VCACHE_ROW_SIZE / 4;
+            continue;
+        }
+        for (size_t n = 0; n < f->len;)
+        {
+            const uint8_t c = f->data[n];
+            decode_cycles += DECODE_TOKEN_CYCLES;
+            if (c < PIX_PACK_SEEK)
+            {
+                decode_cycles += (c + 1u + 3) / 4;
+                n += c + 2u;
+            }
+            else if (c == PIX_PACK_SEEK)
+                n += 3;
+            else
+            {
+                const size_t len = (c & 0x3Fu) + PIX_PACK_RUN_MIN;
+                // short distance copies go byte by byte
+                decode_cycles += c >= PIX_PACK_COPY && f->data[n + 1] + 1u < len ? len : (len + 3) / 4;
+                n += 2;
+            }
+        }
+    }
+}
+
+static double bus_us(uint64_t bytes, uint64_t count)
+{
+    return (bytes * PIX_BYTE_NS + count * PIX_FRAME_NS) / 1000.;
+}
+
+static void measure(const char *name, const uint8_t *bank)
+{
+    static uint8_t slot[0x10000];
+    pack_bank(bank);
+    memset(slot, 0xA5, sizeof(slot));
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    const int err = unpack_bank(slot);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (err || memcmp(slot, bank, sizeof(slot)))
+    {
+        fprintf(stderr, "%s: slot differs after unpacking\n", name);
+        exit(1);
+    }
+    count_decode();
+
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < frame_count; ++i)
+        bytes += 1 + frames[i].len;
+    const uint64_t raw_frames = 0x10000 / PIX_VCACHE_ROW_SIZE;
+    const uint64_t raw_bytes = raw_frames * (1 + PIX_VCACHE_ROW_SIZE);
+    const double raw_us = bus_us(raw_bytes, raw_frames);
+    const double us = bus_us(bytes, frame_count);
+    const double host_us = (t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3;
+    printf("%-12s %5zu frames %6llu B  ratio %6.2f  bus %6.0f us (raw %6.0f, %5.1fx)  decode %6llu cycles, host %6.1f us\n",
+           name, frame_count, (unsigned long long)bytes, (double)raw_bytes / bytes,
+           us, raw_us, raw_us / us, (unsigned long long)decode_cycles, host_us);
+}
+
+static void make_bank(int kind, uint8_t *bank)
+{
+    memset(bank, 0, 0x10000);
+    switch (kind)
+    {
+    case 1: // 40x25 text, screen codes, colors, empty rest
+        for (int i = 0; i < 40 * 25; ++i)
+        {
+            bank[i] = i % 40 < 20 + (i / 40 * 7) % 20 ? 0x41 + (i * 7 + i / 40) % 26 : 0x20;
+            bank[0x1000 + i] = i / 40 < 2 ? 0x71 : 0x0E;
+        }
+        memset(&bank[0x2000], 0, 0x800); // font lives elsewhere
+        for (int i = 0x3000; i < 0x3800; ++i)
+            bank[i] = ((i >> 3) * 0x9E) ^ (i & 7 ? 0 : 0x3C);
+        break;
+    case 2: // 64x64 tile map, repeated floor, walls and a few props
+        for (int y = 0; y < 64; ++y)
+            for (int x = 0; x < 64; ++x)
+            {
+                uint8_t t = ((x ^ y) & 1) ? 0x10 : 0x11;
+                if (x == 0 || y == 0 || x == 63 || y == 63 || (y % 16 == 8 && x % 12 != 6))
+                    t = 0x20 + (x & 3);
+                if ((x * 31 + y * 17) % 97 == 0)
+                    t = 0x40 + (x + y) % 8;
+                bank[y * 64 + x] = t;
+            }
+        for (int i = 0x4000; i < 0x6000; ++i)
+            bank[i] = (uint8_t)(i * 37 >> 3); // tile graphics
+        break;
+    case 3: // 320x200 4bpp, gradient sky, hills
+        for (int y = 0; y < 200; ++y)
+            for (int x = 0; x < 160; ++x)
+            {
+                const int ground = 120 + ((x * x / 40 + x * 3) % 40);
+                const uint8_t c = y < ground ? (uint8_t)(y / 16) : (uint8_t)(8 + ((x + y) & 3));
+                bank[y * 160 + x] = c << 4 | c;
+            }
+        break;
+    case 4: // noise
+        srand(1);
+        for (int i = 0; i < 0x10000; ++i)
+            bank[i] = rand();
+        break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t bank[0x10000];
+    static const char *const kinds[] = {"empty", "text", "tilemap", "bitmap", "noise"};
+    if (argc < 2)
+    {
+        for (int k = 0; k < 5; ++k)
+        {
+            make_bank(k, bank);
+            measure(kinds[k], bank);
+        }
+        return 0;
+    }
+    for (int i = 1; i < argc; ++i)
+    {
+        FILE *f = fopen(argv[i], "rb");
+        if (!f)
+        {
+            perror(argv[i]);
+            return 1;
+        }
+        memset(bank, 0, sizeof(bank));
+        fread(bank, 1, sizeof(bank), f);
+        fclose(f);
+        measure(argv[i], bank);
+    }
+    return 0;
+}
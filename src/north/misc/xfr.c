@@ -0,0 +1,578 @@
+/*
+ * xfr.c  Send a file to the RIA monitor with the XFER command
+ *
+ * gcc xfr.c ../mon/xfr.c ../mon/str.c -O2 -o xfr -Wall -Ihost -I.. -I../.. \
+ *     -DLFS_NAME_MAX=16
+ *
+ * ./xfr /dev/ttyACM0 115200 file.bin RAM 0x10000
+ * ./xfr /dev/ttyACM0 115200 file.bin LFS ROMNAME
+ * ./xfr /dev/ttyACM0 115200 file.bin FAT path/on/drive.bin
+ * ./xfr -l file.bin [drop %] [corrupt %]
+ *
+ * With -l the file goes over a socket pair to mon/xfr.c running in a
+ * child process with a RAM model, across a 64K bank boundary. The sender
+ * drops and corrupts frames, 10% of each unless given, and the transfer
+ * has to recover with NAKs and resends and leave the file in RAM.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../mon/mon.h"
+#include "../mon/xfr.h"
+#include "../sys/com.h"
+#include "../sys/lfs.h"
+#include <fatfs/ff.h>
+#include <littlefs/lfs_util.h>
+#include <pico/stdlib.h>
+
+// Resend the oldest unacknowledged block after this long.
+#define RESEND_MS 500
+// Give up after this many resends of the same block.
+#define MAX_RESENDS 10
+
+// Loopback RAM address, the first block crosses into the next bank.
+#define LOOPBACK_ADDR 0x1FE00
+
+// Loopback faults in percent of frames sent.
+static int drop_pct;
+static int corrupt_pct;
+static uint32_t drops;
+static uint32_t corrupts;
+static uint32_t naks;
+static uint32_t timeouts;
+
+static uint32_t crc_table[256];
+
+static void crc_init(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+        crc_table[i] = c;
+    }
+}
+
+uint32_t lfs_crc(uint32_t crc, const void *buffer, size_t size)
+{
+    const uint8_t *buf = buffer;
+    while (size--)
+        crc = crc_table[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static uint32_t crc32(const uint8_t *buf, size_t len)
+{
+    return ~lfs_crc(~0, buf, len);
+}
+
+static long now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static speed_t baud_speed(long baud)
+{
+    switch (baud)
+    {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+#ifdef B460800
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 2000000: return B2000000;
+    case 3000000: return B3000000;
+#endif
+    }
+    return 0;
+}
+
+static int serial_open(const char *path, long baud)
+{
+    speed_t speed = baud_speed(baud);
+    if (!speed)
+    {
+        fprintf(stderr, "unsupported baud rate %ld\n", baud);
+        return -1;
+    }
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        perror(path);
+        return -1;
+    }
+    struct termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+// Read one byte, -1 on timeout.
+static int serial_getc(int fd, int timeout_ms)
+{
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(fd, &set);
+    struct timeval tv = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    uint8_t ch;
+    if (select(fd + 1, &set, NULL, NULL, &tv) > 0 && read(fd, &ch, 1) == 1)
+        return ch;
+    return -1;
+}
+
+static void serial_write(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    while (len)
+    {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno != EINTR && errno != EAGAIN)
+        {
+            perror("write");
+            exit(1);
+        }
+        if (n > 0)
+            p += n, len -= n;
+    }
+}
+
+// Copy monitor output to stdout until the prompt or a quiet line.
+static int serial_echo_until(int fd, char prompt, int timeout_ms)
+{
+    int ch;
+    while ((ch = serial_getc(fd, timeout_ms)) >= 0)
+    {
+        if (ch == prompt)
+            return ch;
+        if (ch != '\r')
+            putchar(ch);
+    }
+    return -1;
+}
+
+static void send_block(int fd, const uint8_t *data, uint32_t size, uint16_t seq)
+{
+    uint32_t offset = (uint32_t)seq * XFR_BLOCK_SIZE;
+    uint16_t len = size - offset < XFR_BLOCK_SIZE ? size - offset : XFR_BLOCK_SIZE;
+    uint8_t frame[6 + XFR_BLOCK_SIZE + 4];
+    frame[0] = XFR_STX;
+    frame[1] = seq & 0xFF;
+    frame[2] = seq >> 8;
+    frame[3] = len & 0xFF;
+    frame[4] = len >> 8;
+    frame[5] = (frame[1] + frame[2] + frame[3] + frame[4]) ^ 0xFF;
+    memcpy(&frame[6], &data[offset], len);
+    uint32_t crc = crc32(&data[offset], len);
+    for (int i = 0; i < 4; i++)
+        frame[6 + len + i] = crc >> (8 * i);
+    if (rand() % 100 < drop_pct)
+    {
+        drops++;
+        return;
+    }
+    if (rand() % 100 < corrupt_pct)
+    {
+        corrupts++;
+        frame[1 + rand() % (6 + len + 4 - 1)] ^= 1 << rand() % 8;
+    }
+    serial_write(fd, frame, 6 + len + 4);
+}
+
+// Send with the XFER protocol. Returns XFR_EOT when the RIA has it all.
+static int send_file(int fd, const char *dest, const char *arg,
+                     const uint8_t *data, uint32_t size)
+{
+    uint32_t blocks = (size + XFR_BLOCK_SIZE - 1) / XFR_BLOCK_SIZE;
+    char cmd[512];
+    if (!strcasecmp(dest, "FAT"))
+        snprintf(cmd, sizeof(cmd), "XFER FAT %u %s\r", size, arg);
+    else
+        snprintf(cmd, sizeof(cmd), "XFER %s %s %u\r", dest, arg, size);
+    serial_write(fd, cmd, strlen(cmd));
+    if (serial_echo_until(fd, '}', 1000) < 0)
+    {
+        fprintf(stderr, "no transfer prompt\n");
+        return -1;
+    }
+
+    // Per block: 0 unsent, 1 in flight, 2 acknowledged.
+    uint8_t *state = calloc(blocks, 1);
+    uint32_t base = 0, next = 0, resends = 0, retries = 0;
+    long sent_at = now_ms();
+    int result = -1;
+    while (result < 0)
+    {
+        while (next < blocks && next < base + XFR_WINDOW)
+        {
+            if (next == base)
+                sent_at = now_ms();
+            send_block(fd, data, size, next);
+            state[next++] = 1;
+        }
+        int code = serial_getc(fd, RESEND_MS);
+        if (code == XFR_EOT || code == XFR_CAN)
+        {
+            result = code;
+            break;
+        }
+        if (code == XFR_ACK || code == XFR_NAK)
+        {
+            int lo = serial_getc(fd, RESEND_MS);
+            int hi = serial_getc(fd, RESEND_MS);
+            if (lo < 0 || hi < 0)
+                continue;
+            uint16_t seq = lo | hi << 8;
+            if (seq >= blocks)
+                continue;
+            if (code == XFR_NAK)
+            {
+                naks++;
+                retries++;
+                send_block(fd, data, size, seq);
+                continue;
+            }
+            state[seq] = 2;
+            while (base < blocks && state[base] == 2)
+            {
+                base++;
+                resends = 0;
+                sent_at = now_ms();
+            }
+            continue;
+        }
+        if (now_ms() - sent_at >= RESEND_MS && base < blocks)
+        {
+            if (++resends > MAX_RESENDS)
+            {
+                fprintf(stderr, "block %u not acknowledged\n", base);
+                free(state);
+                return -1;
+            }
+            timeouts++;
+            retries++;
+            for (uint32_t seq = base; seq < next; seq++)
+                if (state[seq] != 2)
+                    send_block(fd, data, size, seq);
+            sent_at = now_ms();
+        }
+    }
+    free(state);
+    // Consume the trailing sequence number.
+    serial_getc(fd, RESEND_MS);
+    serial_getc(fd, RESEND_MS);
+    serial_echo_until(fd, ']', 1000);
+    fprintf(stderr, "%u blocks, %u resends\n", blocks, retries);
+    return result;
+}
+
+/* The RIA end of the loopback, mon/xfr.c over a RAM model.
+ * Its console is the socket, on stdin and stdout.
+ */
+
+volatile uint8_t com_tx_buf[COM_TX_BUF_SIZE];
+volatile size_t com_tx_tail;
+volatile size_t com_tx_head;
+lfs_t lfs_volume;
+
+static uint8_t *ria_ram;
+static uint8_t rx_buf[4096];
+static size_t rx_len;
+static size_t rx_pos;
+
+absolute_time_t get_absolute_time(void)
+{
+    return (absolute_time_t)now_ms() * 1000;
+}
+
+absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return get_absolute_time() + (uint64_t)ms * 1000;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t)(to - from);
+}
+
+int stdio_getchar_timeout_us(uint32_t timeout_us)
+{
+    (void)timeout_us;
+    if (rx_pos == rx_len)
+        return PICO_ERROR_TIMEOUT;
+    return rx_buf[rx_pos++];
+}
+
+void stdio_flush(void)
+{
+    fflush(stdout);
+}
+
+void mem_write_blk(uint32_t addr24, const uint8_t *buf, size_t len)
+{
+    if (!len || (addr24 & 0xFFFF) + len > 0x10000 || addr24 + len > 0x1000000)
+    {
+        fprintf(stderr, "block %06X+%zu crosses a bank\n", addr24, len);
+        exit(1);
+    }
+    memcpy(&ria_ram[addr24], buf, len);
+}
+
+void mon_add_response_str(const char *str)
+{
+    fputs(str, stdout);
+}
+
+void mon_add_response_fn(mon_response_fn fn)
+{
+    char buf[128];
+    for (int state = 0; state >= 0;)
+    {
+        state = fn(buf, sizeof(buf), state);
+        fputs(buf, stdout);
+    }
+}
+
+void mon_add_response_lfs(int result)
+{
+    (void)result;
+}
+
+void mon_add_response_fatfs(int fresult)
+{
+    (void)fresult;
+}
+
+int lfs_file_opencfg(lfs_t *lfs, lfs_file_t *file, const char *path, int flags,
+                     const struct lfs_file_config *config)
+{
+    (void)lfs, (void)file, (void)path, (void)flags, (void)config;
+    return -1;
+}
+
+lfs_ssize_t lfs_file_write(lfs_t *lfs, lfs_file_t *file, const void *buffer, lfs_size_t size)
+{
+    (void)lfs, (void)file, (void)buffer, (void)size;
+    return -1;
+}
+
+int lfs_file_close(lfs_t *lfs, lfs_file_t *file)
+{
+    (void)lfs, (void)file;
+    return -1;
+}
+
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode)
+{
+    (void)fp, (void)path, (void)mode;
+    return FR_NOT_READY;
+}
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw)
+{
+    (void)fp, (void)buff, (void)btw, (void)bw;
+    return FR_NOT_READY;
+}
+
+FRESULT f_close(FIL *fp)
+{
+    (void)fp;
+    return FR_NOT_READY;
+}
+
+static bool ria_rx(void)
+{
+    if (rx_pos < rx_len)
+        return true;
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(STDIN_FILENO, &set);
+    struct timeval tv = {0, 1000};
+    rx_pos = rx_len = 0;
+    if (select(STDIN_FILENO + 1, &set, NULL, NULL, &tv) > 0)
+    {
+        ssize_t n = read(STDIN_FILENO, rx_buf, sizeof(rx_buf));
+        if (n <= 0)
+            exit(1); // sender is gone
+        rx_len = n;
+    }
+    return rx_len > 0;
+}
+
+// Replies go out before the monitor responses that follow them.
+static void ria_tx(void)
+{
+    while (com_tx_tail != com_tx_head)
+    {
+        com_tx_tail = (com_tx_tail + 1) % COM_TX_BUF_SIZE;
+        const uint8_t ch = com_tx_buf[com_tx_tail];
+        serial_write(STDOUT_FILENO, &ch, 1);
+    }
+    fflush(stdout);
+}
+
+static int loopback_ria(const uint8_t *data, uint32_t size)
+{
+    ria_ram = calloc(0x1000000, 1);
+    char cmd[128];
+    size_t cmd_len = 0;
+    while (cmd_len < sizeof(cmd))
+    {
+        if (!ria_rx())
+            continue;
+        const char ch = rx_buf[rx_pos++];
+        if (ch == '\r')
+            break;
+        cmd[cmd_len++] = ch;
+    }
+    if (cmd_len < 5 || strncasecmp(cmd, "XFER ", 5))
+        return 1;
+    xfr_mon_xfer(cmd + 5, cmd_len - 5);
+    while (xfr_active())
+    {
+        ria_rx();
+        xfr_task();
+        ria_tx();
+    }
+    putchar(']');
+    ria_tx();
+    if (memcmp(&ria_ram[LOOPBACK_ADDR], data, size))
+    {
+        fprintf(stderr, "RAM differs from the file\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int loopback(const uint8_t *data, uint32_t size)
+{
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0)
+    {
+        perror("socketpair");
+        return 1;
+    }
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        return 1;
+    }
+    if (!pid)
+    {
+        close(sv[0]);
+        dup2(sv[1], STDIN_FILENO);
+        dup2(sv[1], STDOUT_FILENO);
+        exit(loopback_ria(data, size));
+    }
+    close(sv[1]);
+    char addr[16];
+    snprintf(addr, sizeof(addr), "0x%X", LOOPBACK_ADDR);
+    int result = send_file(sv[0], "RAM", addr, data, size);
+    close(sv[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    fprintf(stderr, "%u dropped, %u corrupted, %u NAKs, %u timeouts\n",
+            drops, corrupts, naks, timeouts);
+    if (result != XFR_EOT || !WIFEXITED(status) || WEXITSTATUS(status))
+        return 1;
+    if ((corrupt_pct && !naks) || (drop_pct && !timeouts))
+    {
+        fprintf(stderr, "faults were not recovered from\n");
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t *load(const char *path, uint32_t *size)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        perror(path);
+        return NULL;
+    }
+    struct stat st;
+    fstat(fileno(file), &st);
+    *size = st.st_size;
+    uint8_t *data = malloc(*size ? *size : 1);
+    if (!data || fread(data, 1, *size, file) != *size)
+    {
+        perror(path);
+        return NULL;
+    }
+    fclose(file);
+    uint32_t blocks = (*size + XFR_BLOCK_SIZE - 1) / XFR_BLOCK_SIZE;
+    if (!*size || blocks > UINT16_MAX)
+    {
+        fprintf(stderr, "%s: unsupported size %u\n", path, *size);
+        return NULL;
+    }
+    return data;
+}
+
+int main(int argc, char *argv[])
+{
+    crc_init();
+    uint32_t size;
+    uint8_t *data;
+
+    if (argc >= 3 && argc <= 5 && !strcmp(argv[1], "-l"))
+    {
+        drop_pct = argc > 3 ? atoi(argv[3]) : 10;
+        corrupt_pct = argc > 4 ? atoi(argv[4]) : 10;
+        if (!(data = load(argv[2], &size)))
+            return 1;
+        if (LOOPBACK_ADDR + size > 0x1000000)
+        {
+            fprintf(stderr, "%s: unsupported size %u\n", argv[2], size);
+            return 1;
+        }
+        srand(time(NULL));
+        return loopback(data, size);
+    }
+
+    if (argc != 6)
+    {
+        fprintf(stderr, "usage: %s port baud file RAM|LFS|FAT addr|rom|path\n", argv[0]);
+        fprintf(stderr, "       %s -l file [drop %%] [corrupt %%]\n", argv[0]);
+        return 1;
+    }
+    if (!(data = load(argv[3], &size)))
+        return 1;
+
+    int fd = serial_open(argv[1], strtol(argv[2], NULL, 0));
+    if (fd < 0)
+        return 1;
+
+    return send_file(fd, argv[4], argv[5], data, size) == XFR_EOT ? 0 : 1;
+}
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mon/hex.h"
+#include "mon/mon.h"
+#include "mon/str.h"
+#include "sys/mem.h"
+#include "sys/ria.h"
+#include <pico/stdlib.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(DEBUG_RIA_MON) || defined(DEBUG_RIA_MON_HEX)
+#include <stdio.h>
+#define DBG(...) fprintf(stderr, __VA_ARGS__)
+#else
+static inline void DBG(const char *fmt, ...)
+{
+    (void)fmt;
+}
+#endif
+
+#define X(name, value) \
+    static const char __in_flash(STRINGIFY(name)) name[] = value;
+
+X(STR_ERR_INVALID_ARGUMENT, "?Invalid argument\n")
+X(STR_ERR_RX_TIMEOUT, "?RX timeout\n")
+X(STR_HEX_STATS, "%lu records, %lu bytes in %lu ms, %lu bytes/s\n")
+X(STR_HEX_ERRORS, "?%lu bad records, first on line %lu\n")
+#undef X
+
+// Loading ends when the console goes quiet this long.
+#define HEX_TIMEOUT_MS 2000
+
+// Longest record is S3 with 255 byte count, plus slack.
+#define HEX_LINE_SIZE 528
+
+static enum {
+    HEX_IDLE,
+    HEX_LOADING,
+} hex_state;
+
+static char hex_line[HEX_LINE_SIZE];
+static size_t hex_line_len;
+static bool hex_line_overflow;
+static uint8_t hex_rec[HEX_LINE_SIZE / 2];
+
+static uint32_t hex_base;
+static uint32_t hex_lines;
+static uint32_t hex_records;
+static uint32_t hex_bytes;
+static uint32_t hex_errors;
+static uint32_t hex_first_error;
+static bool hex_started;
+static absolute_time_t hex_start;
+static uint32_t hex_elapsed_ms;
+static absolute_time_t hex_timer;
+
+// Contiguous data accumulates in mbuf until a gap forces a write.
+static uint32_t hex_run_addr;
+
+static void hex_flush(void)
+{
+    uint32_t addr = hex_run_addr;
+    const uint8_t *buf = mbuf;
+    for (size_t len = mbuf_len; len;)
+    {
+        // The RIA registers overlay $FFC0-$FFFF.
+        if (addr >= 0xFFC0 && addr <= 0xFFFF)
+        {
+            ria_write_mem(addr++, *buf++);
+            len--;
+            continue;
+        }
+        size_t run = len;
+        if (addr < 0xFFC0 && run > 0xFFC0 - addr)
+            run = 0xFFC0 - addr;
+        mem_cpy(addr, buf, run);
+        addr += run, buf += run, len -= run;
+    }
+    mbuf_len = 0;
+}
+
+static void hex_data(uint32_t addr, const uint8_t *data, size_t len)
+{
+    hex_bytes += len;
+    while (len)
+    {
+        if (mbuf_len && (addr != hex_run_addr + mbuf_len || mbuf_len == MBUF_SIZE))
+            hex_flush();
+        if (!mbuf_len)
+            hex_run_addr = addr;
+        size_t run = MBUF_SIZE - mbuf_len;
+        if (run > len)
+            run = len;
+        memcpy(&mbuf[mbuf_len], data, run);
+        mbuf_len += run;
+        addr += run, data += run, len -= run;
+    }
+}
+
+static void hex_reset_vector(uint16_t addr)
+{
+    const uint8_t vec[2] = {addr & 0xFF, addr >> 8};
+    hex_data(0xFFFC, vec, sizeof(vec));
+}
+
+static int hex_stats_response(char *buf, size_t buf_size, int state)
+{
+    if (state < 0)
+        return state;
+    uint32_t ms = hex_elapsed_ms;
+    if (state == 0)
+    {
+        snprintf(buf, buf_size, STR_HEX_STATS,
+                 (unsigned long)hex_records, (unsigned long)hex_bytes, (unsigned long)ms,
+                 (unsigned long)(ms ? (uint64_t)hex_bytes * 1000 / ms : hex_bytes));
+        return hex_errors ? 1 : -1;
+    }
+    snprintf(buf, buf_size, STR_HEX_ERRORS,
+             (unsigned long)hex_errors, (unsigned long)hex_first_error);
+    return -1;
+}
+
+static void hex_finish(void)
+{
+    hex_flush();
+    hex_elapsed_ms = hex_started
+                         ? absolute_time_diff_us(hex_start, get_absolute_time()) / 1000
+                         : 0;
+    hex_state = HEX_IDLE;
+    mon_add_response_fn(hex_stats_response);
+}
+
+static void hex_error(void)
+{
+    if (!hex_errors++)
+        hex_first_error = hex_lines;
+    DBG("HEX error line %lu\n", (unsigned long)hex_lines);
+}
+
+// Decode hex pairs into hex_rec. Returns byte count or -1.
+static int hex_decode(const char *str, size_t len)
+{
+    if (len % 2)
+        return -1;
+    for (size_t i = 0; i < len; i += 2)
+    {
+        if (!isxdigit((unsigned char)str[i]) ||
+            !isxdigit((unsigned char)str[i + 1]))
+            return -1;
+        hex_rec[i / 2] = str_xdigit_to_int(str[i]) * 16 +
+                         str_xdigit_to_int(str[i + 1]);
+    }
+    return len / 2;
+}
+
+// Returns true on the end of file record.
+static bool hex_intel(const char *str, size_t len)
+{
+    int count = hex_decode(str, len);
+    if (count < 5 || hex_rec[0] != count - 5)
+        return hex_error(), false;
+    uint8_t sum = 0;
+    for (int i = 0; i < count; i++)
+        sum += hex_rec[i];
+    if (sum)
+        return hex_error(), false;
+    const uint8_t *data = &hex_rec[4];
+    uint8_t dlen = hex_rec[0];
+    uint32_t addr = hex_rec[1] << 8 | hex_rec[2];
+    switch (hex_rec[3])
+    {
+    case 0: // Data
+        addr += hex_base;
+        if (addr + dlen > 0x1000000)
+            return hex_error(), false;
+        hex_data(addr, data, dlen);
+        break;
+    case 1: // End of file
+        hex_records++;
+        return true;
+    case 2: // Extended segment address
+        if (dlen != 2)
+            return hex_error(), false;
+        hex_base = data[0] * 0x1000 + data[1] * 0x10;
+        break;
+    case 4: // Extended linear address
+        if (dlen != 2)
+            return hex_error(), false;
+        hex_base = data[0] * 0x1000000 + data[1] * 0x10000;
+        break;
+    case 3: // Start segment address
+    case 5: // Start linear address
+        if (dlen != 4)
+            return hex_error(), false;
+        hex_reset_vector(data[2] << 8 | data[3]);
+        break;
+    default:
+        return hex_error(), false;
+    }
+    hex_records++;
+    return false;
+}
+
+// Returns true on a termination record.
+static bool hex_srec(char type, const char *str, size_t len)
+{
+    int count = hex_decode(str, len);
+    if (count < 3 || hex_rec[0] != count - 1)
+        return hex_error(), false;
+    uint8_t sum = 0;
+    for (int i = 0; i < count; i++)
+        sum += hex_rec[i];
+    if (sum != 0xFF)
+        return hex_error(), false;
+    size_t addr_len;
+    switch (type)
+    {
+    case '0': // Header
+    case '5': // Record count
+    case '6':
+        hex_records++;
+        return false;
+    case '1':
+    case '9':
+        addr_len = 2;
+        break;
+    case '2':
+    case '8':
+        addr_len = 3;
+        break;
+    case '3':
+    case '7':
+        addr_len = 4;
+        break;
+    default:
+        return hex_error(), false;
+    }
+    if ((size_t)count < 2 + addr_len)
+        return hex_error(), false;
+    uint32_t addr = 0;
+    for (size_t i = 0; i < addr_len; i++)
+        addr = addr << 8 | hex_rec[1 + i];
+    const uint8_t *data = &hex_rec[1 + addr_len];
+    size_t dlen = count - 2 - addr_len;
+    if (type >= '7')
+    {
+        hex_records++;
+        hex_reset_vector(addr);
+        return true;
+    }
+    if (addr > 0xFFFFFF || addr + dlen > 0x1000000)
+        return hex_error(), false;
+    hex_records++;
+    hex_data(addr, data, dlen);
+    return false;
+}
+
+static void hex_line_rx(void)
+{
+    hex_lines++;
+    const char *str = hex_line;
+    size_t len = hex_line_len;
+    while (len && str[len - 1] == ' ')
+        len--;
+    if (hex_line_overflow)
+        return hex_error();
+    if (!len)
+        return;
+    bool done = false;
+    if (str[0] == ':')
+        done = hex_intel(str + 1, len - 1);
+    else if (len >= 2 && (str[0] == 'S' || str[0] == 's'))
+        done = hex_srec(str[1], str + 2, len - 2);
+    else
+        hex_error();
+    if (done)
+        hex_finish();
+}
+
+static void hex_rx(char ch)
+{
+    if (ch == '\r' || ch == '\n')
+    {
+        if (hex_line_len || hex_line_overflow)
+            hex_line_rx();
+        hex_line_len = 0;
+        hex_line_overflow = false;
+        return;
+    }
+    if (hex_line_len < HEX_LINE_SIZE)
+        hex_line[hex_line_len++] = ch;
+    else
+        hex_line_overflow = true;
+}
+
+void hex_mon_hex(const char *args, size_t len)
+{
+    (void)args;
+    if (len)
+        return mon_add_response_str(STR_ERR_INVALID_ARGUMENT);
+    hex_base = 0;
+    hex_lines = 0;
+    hex_records = 0;
+    hex_bytes = 0;
+    hex_errors = 0;
+    hex_first_error = 0;
+    hex_started = false;
+    hex_line_len = 0;
+    hex_line_overflow = false;
+    mbuf_len = 0;
+    hex_state = HEX_LOADING;
+    hex_timer = make_timeout_time_ms(HEX_TIMEOUT_MS);
+    putchar('}');
+    stdio_flush();
+}
+
+void hex_task(void)
+{
+    if (hex_state != HEX_LOADING)
+        return;
+    int ch = stdio_getchar_timeout_us(0);
+    if (ch != PICO_ERROR_TIMEOUT)
+    {
+        if (!hex_started)
+        {
+            hex_started = true;
+            hex_start = get_absolute_time();
+        }
+        while (hex_state == HEX_LOADING && ch != PICO_ERROR_TIMEOUT)
+        {
+            hex_rx(ch);
+            ch = stdio_getchar_timeout_us(0);
+        }
+        hex_timer = make_timeout_time_ms(HEX_TIMEOUT_MS);
+    }
+    if (hex_state == HEX_LOADING &&
+        absolute_time_diff_us(get_absolute_time(), hex_timer) < 0)
+    {
+        // A file without an end record is loaded in full on timeout.
+        if (hex_line_len)
+            hex_line_rx();
+        if (hex_state == HEX_LOADING)
+            hex_finish();
+        if (!hex_records)
+            mon_add_response_str(STR_ERR_RX_TIMEOUT);
+    }
+}
+
+bool hex_active(void)
+{
+    return hex_state != HEX_IDLE;
+}
+
+void hex_break(void)
+{
+    mbuf_len = 0;
+    hex_state = HEX_IDLE;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _RIA_MON_HEX_H_
+#define _RIA_MON_HEX_H_
+
+/* Batch loader for Intel HEX and Motorola S-record files.
+ * Records stream straight from the console without a prompt per
+ * line and contiguous data is written to RAM in bulk.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Main events
+ */
+
+void hex_task(void);
+void hex_break(void);
+
+// True when more work is pending.
+bool hex_active(void);
+
+/* Monitor commands
+ */
+
+void hex_mon_hex(const char *args, size_t len);
+
+#endif /* _RIA_MON_HEX_H_ */
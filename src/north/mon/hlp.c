@@ -51,6 +51,8 @@ X(STR_RESET, "RESET")
 X(STR_UPLOAD, "UPLOAD")
 X(STR_UNLINK, "UNLINK")
 X(STR_BINARY, "BINARY")
+X(STR_XFER, "XFER")
+X(STR_HEX, "HEX")
 X(STR_PHI2, "PHI2")
 X(STR_BOOT, "BOOT")
 X(STR_TZ, "TZ")
@@ -97,6 +99,8 @@ X(STR_HELP_HELP,
   "UNLINK file|dir     - Delete a file or empty directory.\n"
   "UPLOAD file         - Write file. Binary chunks follow.\n"
   "BINARY addr len crc - Write memory. Binary data follows.\n"
+  "XFER RAM|LFS|FAT    - Windowed binary transfer. Frames follow.\n"
+  "HEX                 - Load Intel HEX or S-record file. Records follow.\n"
   "MEMTEST             - Test PSRAM memory.\n"
   "0000 (00 00 ...)    - Read or write memory.\n")
 
@@ -223,6 +227,25 @@ X(STR_HELP_BINARY,
   "bytes and the CRC-32 calculated with a zip library. Then send the binary.\n"
   "You will return to a \"]\" prompt on success or \"?\" error on failure.\n")
 
+X(STR_HELP_XFER,
+  "XFER sends large binaries with several CRC-32 protected blocks in flight.\n"
+  "Unlike UPLOAD and BINARY it recovers from lost or corrupted data, so it is\n"
+  "suitable for long transfers at high baud rates. Choose the destination:\n"
+  "]XFER RAM addr len\n"
+  "]XFER LFS rom len\n"
+  "]XFER FAT len file\n"
+  "The system will respond with a \"}\" prompt or an error message starting with\n"
+  "a \"?\". Framing is described in mon/xfr.h and implemented by the misc/xfr\n"
+  "sender tool. You will return to a \"]\" prompt with transfer statistics.\n")
+
+X(STR_HELP_HEX,
+  "HEX loads a whole Intel HEX or Motorola S-record file into RAM. After the\n"
+  "\"}\" prompt send the file as is. There is no prompt between records, so the\n"
+  "file may be pasted or streamed at full line speed. Loading ends with the end\n"
+  "of file record (:00000001FF or S7/S8/S9) or after two quiet seconds. Start\n"
+  "address records set the reset vector. Records with a bad checksum are\n"
+  "skipped and counted. You will return to a \"]\" prompt with statistics.\n")
+
 X(STR_HELP_STATUS,
   "STATUS will show the status of all hardware in and connected to the RIA.\n")
 
@@ -314,6 +337,8 @@ __in_flash("hlp_commands") static struct
     {STR_UPLOAD, STR_HELP_UPLOAD, NULL},
     {STR_UNLINK, STR_HELP_UNLINK, NULL},
     {STR_BINARY, STR_HELP_BINARY, NULL},
+    {STR_XFER, STR_HELP_XFER, NULL},
+    {STR_HEX, STR_HELP_HEX, NULL},
 };
 static const size_t COMMANDS_COUNT = sizeof HLP_COMMANDS / sizeof *HLP_COMMANDS;
 
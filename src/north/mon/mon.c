@@ -6,12 +6,14 @@
 
 #include "main.h"
 #include "mon/fil.h"
+#include "mon/hex.h"
 #include "mon/hlp.h"
 #include "mon/mon.h"
 #include "mon/ram.h"
 #include "mon/rom.h"
 #include "mon/set.h"
 #include "mon/tst.h"
+#include "mon/xfr.h"
 #include "net/cyw.h"
 #include "mon/str.h"
 #include "sys/com.h"
@@ -55,6 +57,8 @@ X(STR_RESET, "RESET")
 X(STR_UPLOAD, "UPLOAD")
 X(STR_UNLINK, "UNLINK")
 X(STR_BINARY, "BINARY")
+X(STR_XFER, "XFER")
+X(STR_HEX, "HEX")
 X(STR_MEMTEST, "MEMTEST")
 
 X(STR_ERR_MONITOR_RESPONSE_OVERFLOW, "?Monitor response overflow\n")
@@ -156,6 +160,8 @@ __in_flash("mon_commands") static struct
     {STR_UPLOAD, fil_mon_upload},
     {STR_UNLINK, fil_mon_unlink},
     {STR_BINARY, ram_mon_binary},
+    {STR_XFER, xfr_mon_xfer},
+    {STR_HEX, hex_mon_hex},
     {STR_MEMTEST, tst_mon_memtest},
 };
 static const size_t MON_COMMANDS_COUNT = sizeof MON_COMMANDS / sizeof *MON_COMMANDS;
@@ -558,7 +564,9 @@ void mon_task(void)
     // These can run the 6502 multiple times
     if (ram_active() ||
         rom_active() ||
-        fil_active())
+        fil_active() ||
+        xfr_active() ||
+        hex_active())
         return;
     // The monitor has control
     if (mon_needs_prompt)
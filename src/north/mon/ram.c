@@ -281,11 +281,7 @@ static void sys_com_rx_mbuf(bool timeout, const char *buf, size_t length)
         mon_add_response_str(STR_ERR_CRC);
         return;
     }
-    uint32_t addr = ram_rw_addr;
-    while (length--)
-    {
-        mem_write_ram(addr++, *(buf++));
-    }
+    mem_cpy(ram_rw_addr, buf, length);
 }
 
 void ram_mon_binary(const char *args, size_t len)
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mon/xfr.h"
+#include "mon/mon.h"
+#include "mon/str.h"
+#include "sys/com.h"
+#include "sys/lfs.h"
+#include "sys/mem.h"
+#include <fatfs/ff.h>
+#include <littlefs/lfs_util.h>
+#include <pico/stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(DEBUG_RIA_MON) || defined(DEBUG_RIA_MON_XFR)
+#include <stdio.h>
+#define DBG(...) fprintf(stderr, __VA_ARGS__)
+#else
+static inline void DBG(const char *fmt, ...)
+{
+    (void)fmt;
+}
+#endif
+
+#define X(name, value) \
+    static const char __in_flash(STRINGIFY(name)) name[] = value;
+
+X(STR_RAM, "RAM")
+X(STR_LFS, "LFS")
+X(STR_FAT, "FAT")
+X(STR_ERR_INVALID_ARGUMENT, "?Invalid argument\n")
+X(STR_ERR_RX_TIMEOUT, "?RX timeout\n")
+X(STR_ERR_ROM_NAME_INVALID, "?ROM name invalid\n")
+X(STR_XFR_STATS, "%lu bytes in %lu ms, %lu bytes/s, %lu retries\n")
+#undef X
+
+// Abort when the host goes quiet.
+#define XFR_TIMEOUT_MS 2000
+// Drop a partial frame after an inter-byte gap this long.
+#define XFR_FRAME_TIMEOUT_MS 50
+
+#define XFR_HEADER_SIZE 6
+#define XFR_CRC_SIZE    4
+
+static enum {
+    XFR_IDLE,
+    XFR_RECEIVING,
+} xfr_state;
+
+static enum {
+    XFR_DEST_RAM,
+    XFR_DEST_LFS,
+    XFR_DEST_FAT,
+} xfr_dest;
+
+static uint32_t xfr_addr;
+static uint32_t xfr_len;
+static uint16_t xfr_blocks;
+static uint16_t xfr_base;
+static uint32_t xfr_retries;
+static absolute_time_t xfr_start;
+static uint32_t xfr_elapsed_ms;
+static absolute_time_t xfr_timer;
+static absolute_time_t xfr_frame_timer;
+
+static FIL xfr_fat_fil;
+static bool xfr_lfs_file_open;
+static lfs_file_t xfr_lfs_file;
+LFS_FILE_CONFIG(xfr_lfs_file_config, static);
+
+// Received blocks waiting to be written in order.
+static uint8_t xfr_window[XFR_WINDOW][XFR_BLOCK_SIZE]
+    __attribute__((aligned(4)));
+static uint16_t xfr_window_len[XFR_WINDOW];
+
+// Frame parser
+static uint8_t xfr_header[XFR_HEADER_SIZE];
+static uint8_t xfr_crc[XFR_CRC_SIZE];
+static size_t xfr_pos;
+static uint16_t xfr_seq;
+static uint16_t xfr_frame_len;
+static uint8_t *xfr_frame_buf;
+
+static uint16_t xfr_block_len(uint16_t seq)
+{
+    if (seq + 1 < xfr_blocks)
+        return XFR_BLOCK_SIZE;
+    return xfr_len - (uint32_t)seq * XFR_BLOCK_SIZE;
+}
+
+// Replies must not get newline expansion.
+static void xfr_reply(uint8_t code, uint16_t seq)
+{
+    // A dropped reply is recovered by the host timeout.
+    const uint8_t reply[3] = {code, seq & 0xFF, seq >> 8};
+    for (size_t i = 0; i < sizeof(reply); i++)
+        if (com_tx_writable())
+            com_tx_write(reply[i]);
+}
+
+static void xfr_close(void)
+{
+    if (xfr_fat_fil.obj.fs)
+    {
+        FRESULT result = f_close(&xfr_fat_fil);
+        mon_add_response_fatfs(result);
+    }
+    if (xfr_lfs_file_open)
+    {
+        int lfsresult = lfs_file_close(&lfs_volume, &xfr_lfs_file);
+        mon_add_response_lfs(lfsresult);
+        xfr_lfs_file_open = false;
+    }
+}
+
+static void xfr_abort(const char *str)
+{
+    xfr_reply(XFR_CAN, xfr_base);
+    xfr_state = XFR_IDLE;
+    xfr_close();
+    if (str)
+        mon_add_response_str(str);
+}
+
+static int xfr_stats_response(char *buf, size_t buf_size, int state)
+{
+    if (state < 0)
+        return state;
+    uint32_t ms = xfr_elapsed_ms;
+    snprintf(buf, buf_size, STR_XFR_STATS,
+             (unsigned long)xfr_len, (unsigned long)ms,
+             (unsigned long)(ms ? (uint64_t)xfr_len * 1000 / ms : xfr_len),
+             (unsigned long)xfr_retries);
+    return -1;
+}
+
+static bool xfr_write(const uint8_t *buf, uint16_t len)
+{
+    uint32_t offset = (uint32_t)xfr_base * XFR_BLOCK_SIZE;
+    switch (xfr_dest)
+    {
+    case XFR_DEST_RAM:
+        mem_cpy(xfr_addr + offset, buf, len);
+        return true;
+    case XFR_DEST_LFS:
+    {
+        lfs_ssize_t lfsresult = lfs_file_write(&lfs_volume, &xfr_lfs_file, buf, len);
+        mon_add_response_lfs(lfsresult);
+        return lfsresult == len;
+    }
+    case XFR_DEST_FAT:
+    {
+        UINT bytes_written;
+        FRESULT result = f_write(&xfr_fat_fil, buf, len, &bytes_written);
+        mon_add_response_fatfs(result);
+        return result == FR_OK && bytes_written == len;
+    }
+    }
+    return false;
+}
+
+// Write out every block that is next in order.
+static void xfr_flush(void)
+{
+    while (xfr_state == XFR_RECEIVING)
+    {
+        const size_t slot = xfr_base % XFR_WINDOW;
+        if (!xfr_window_len[slot])
+            return;
+        if (!xfr_write(xfr_window[slot], xfr_window_len[slot]))
+            return xfr_abort(NULL);
+        xfr_window_len[slot] = 0;
+        if (++xfr_base == xfr_blocks)
+        {
+            xfr_reply(XFR_EOT, xfr_base);
+            xfr_elapsed_ms = absolute_time_diff_us(xfr_start, get_absolute_time()) / 1000;
+            xfr_state = XFR_IDLE;
+            xfr_close();
+            mon_add_response_fn(xfr_stats_response);
+        }
+    }
+}
+
+static void xfr_header_rx(void)
+{
+    const uint8_t *h = xfr_header;
+    xfr_seq = h[1] | h[2] << 8;
+    xfr_frame_len = h[3] | h[4] << 8;
+    if ((uint8_t)((h[1] + h[2] + h[3] + h[4]) ^ 0xFF) != h[5]
+        || !xfr_frame_len || xfr_frame_len > XFR_BLOCK_SIZE)
+    {
+        // Corrupt header, hunt for the next STX.
+        xfr_pos = 0;
+        return;
+    }
+    // Only blocks inside the window that we still need are kept.
+    // Everything else is parsed and discarded to stay in sync.
+    xfr_frame_buf = NULL;
+    if (xfr_seq >= xfr_base && xfr_seq < xfr_base + XFR_WINDOW
+        && xfr_seq < xfr_blocks
+        && !xfr_window_len[xfr_seq % XFR_WINDOW])
+        xfr_frame_buf = xfr_window[xfr_seq % XFR_WINDOW];
+}
+
+static void xfr_frame_rx(void)
+{
+    xfr_pos = 0;
+    if (xfr_seq < xfr_base
+        || (xfr_seq < xfr_base + XFR_WINDOW && xfr_window_len[xfr_seq % XFR_WINDOW]))
+    {
+        // Our ACK was lost.
+        xfr_retries++;
+        return xfr_reply(XFR_ACK, xfr_seq);
+    }
+    if (!xfr_frame_buf)
+        return; // beyond window, host will resend
+    uint32_t crc = xfr_crc[0] | xfr_crc[1] << 8 | xfr_crc[2] << 16 | (uint32_t)xfr_crc[3] << 24;
+    if (xfr_frame_len != xfr_block_len(xfr_seq)
+        || ~lfs_crc(~0, xfr_frame_buf, xfr_frame_len) != crc)
+    {
+        DBG("XFR NAK %u\n", xfr_seq);
+        xfr_retries++;
+        return xfr_reply(XFR_NAK, xfr_seq);
+    }
+    xfr_window_len[xfr_seq % XFR_WINDOW] = xfr_frame_len;
+    xfr_reply(XFR_ACK, xfr_seq);
+    xfr_flush();
+}
+
+static void xfr_rx(uint8_t ch)
+{
+    if (xfr_pos == 0)
+    {
+        if (ch == XFR_STX)
+            xfr_header[xfr_pos++] = ch;
+        return;
+    }
+    if (xfr_pos < XFR_HEADER_SIZE)
+    {
+        xfr_header[xfr_pos++] = ch;
+        if (xfr_pos == XFR_HEADER_SIZE)
+            xfr_header_rx();
+        return;
+    }
+    size_t data_pos = xfr_pos - XFR_HEADER_SIZE;
+    if (data_pos < xfr_frame_len)
+    {
+        if (xfr_frame_buf)
+            xfr_frame_buf[data_pos] = ch;
+        xfr_pos++;
+        return;
+    }
+    xfr_crc[data_pos - xfr_frame_len] = ch;
+    if (++xfr_pos == XFR_HEADER_SIZE + xfr_frame_len + XFR_CRC_SIZE)
+        xfr_frame_rx();
+}
+
+void xfr_mon_xfer(const char *args, size_t len)
+{
+    char name[LFS_NAME_MAX + 1];
+    const char *dest = args;
+    while (len && *args != ' ')
+        args++, len--;
+    size_t dest_len = args - dest;
+    while (len && *args == ' ')
+        args++, len--;
+    if (dest_len == 3 && !strncasecmp(dest, STR_RAM, 3))
+    {
+        // XFER RAM addr len
+        if (!str_parse_uint32(&args, &len, &xfr_addr)
+            || !str_parse_uint32(&args, &len, &xfr_len)
+            || !str_parse_end(args, len)
+            || xfr_addr > 0xFFFFFF
+            || xfr_addr + xfr_len > 0x1000000)
+            return mon_add_response_str(STR_ERR_INVALID_ARGUMENT);
+        xfr_dest = XFR_DEST_RAM;
+    }
+    else if (dest_len == 3 && !strncasecmp(dest, STR_LFS, 3))
+    {
+        // XFER LFS name len
+        if (!str_parse_rom_name(&args, &len, name))
+            return mon_add_response_str(STR_ERR_ROM_NAME_INVALID);
+        if (!str_parse_uint32(&args, &len, &xfr_len)
+            || !str_parse_end(args, len))
+            return mon_add_response_str(STR_ERR_INVALID_ARGUMENT);
+        xfr_dest = XFR_DEST_LFS;
+    }
+    else if (dest_len == 3 && !strncasecmp(dest, STR_FAT, 3))
+    {
+        // XFER FAT len file
+        if (!str_parse_uint32(&args, &len, &xfr_len) || !len)
+            return mon_add_response_str(STR_ERR_INVALID_ARGUMENT);
+        xfr_dest = XFR_DEST_FAT;
+    }
+    else
+        return mon_add_response_str(STR_ERR_INVALID_ARGUMENT);
+    if (!xfr_len || xfr_len > (uint32_t)UINT16_MAX * XFR_BLOCK_SIZE)
+        return mon_add_response_str(STR_ERR_INVALID_ARGUMENT);
+    if (xfr_dest == XFR_DEST_LFS)
+    {
+        int lfsresult = lfs_file_opencfg(&lfs_volume, &xfr_lfs_file, name,
+                                         LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC,
+                                         &xfr_lfs_file_config);
+        mon_add_response_lfs(lfsresult);
+        if (lfsresult < 0)
+            return;
+        xfr_lfs_file_open = true;
+    }
+    if (xfr_dest == XFR_DEST_FAT)
+    {
+        FRESULT result = f_open(&xfr_fat_fil, args, FA_CREATE_ALWAYS | FA_WRITE);
+        mon_add_response_fatfs(result);
+        if (result != FR_OK)
+            return;
+    }
+    xfr_blocks = (xfr_len + XFR_BLOCK_SIZE - 1) / XFR_BLOCK_SIZE;
+    xfr_base = 0;
+    xfr_pos = 0;
+    xfr_retries = 0;
+    memset(xfr_window_len, 0, sizeof(xfr_window_len));
+    xfr_state = XFR_RECEIVING;
+    xfr_start = get_absolute_time();
+    xfr_timer = make_timeout_time_ms(XFR_TIMEOUT_MS);
+    xfr_frame_timer = make_timeout_time_ms(XFR_FRAME_TIMEOUT_MS);
+    putchar('}');
+    stdio_flush();
+}
+
+void xfr_task(void)
+{
+    if (xfr_state != XFR_RECEIVING)
+    {
+        // Close file after reset or error condition
+        xfr_close();
+        return;
+    }
+    int ch = stdio_getchar_timeout_us(0);
+    if (ch != PICO_ERROR_TIMEOUT)
+    {
+        if (xfr_pos && absolute_time_diff_us(get_absolute_time(), xfr_frame_timer) < 0)
+            xfr_pos = 0;
+        while (xfr_state == XFR_RECEIVING && ch != PICO_ERROR_TIMEOUT)
+        {
+            xfr_rx(ch);
+            ch = stdio_getchar_timeout_us(0);
+        }
+        xfr_timer = make_timeout_time_ms(XFR_TIMEOUT_MS);
+        xfr_frame_timer = make_timeout_time_ms(XFR_FRAME_TIMEOUT_MS);
+    }
+    if (xfr_state == XFR_RECEIVING
+        && absolute_time_diff_us(get_absolute_time(), xfr_timer) < 0)
+        xfr_abort(STR_ERR_RX_TIMEOUT);
+}
+
+bool xfr_active(void)
+{
+    return xfr_state != XFR_IDLE;
+}
+
+void xfr_break(void)
+{
+    xfr_state = XFR_IDLE;
+}
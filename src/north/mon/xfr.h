@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _RIA_MON_XFR_H_
+#define _RIA_MON_XFR_H_
+
+/* Windowed binary transfer for the monitor.
+ * Several CRC protected blocks are kept in flight so throughput is
+ * bound by the link speed instead of console round trips.
+ * This header is also used by the host sender in misc/xfr.c.
+ *
+ * After "XFER RAM|LFS|FAT ..." the RIA replies "}" and expects frames:
+ *   STX seq_lo seq_hi len_lo len_hi check data[len] crc32[4]
+ * check is the sum of the four preceding header bytes xor 0xFF and
+ * crc32 is the zlib CRC-32 of data, little endian. Blocks are
+ * XFR_BLOCK_SIZE bytes, except the last, and numbered from 0.
+ * The RIA replies to every frame with:
+ *   ACK seq_lo seq_hi - block stored, also sent again for duplicates
+ *   NAK seq_lo seq_hi - bad length or CRC, send block again
+ * Blocks may arrive in any order within XFR_WINDOW of the oldest
+ * unacknowledged block. When all blocks are written the RIA sends
+ * EOT and returns to the monitor. CAN aborts, followed by an error.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define XFR_BLOCK_SIZE 1024
+#define XFR_WINDOW     4
+
+#define XFR_STX 0x02
+#define XFR_EOT 0x04
+#define XFR_ACK 0x06
+#define XFR_NAK 0x15
+#define XFR_CAN 0x18
+
+/* Main events
+ */
+
+void xfr_task(void);
+void xfr_break(void);
+
+// True when more work is pending.
+bool xfr_active(void);
+
+/* Monitor commands
+ */
+
+void xfr_mon_xfer(const char *args, size_t len);
+
+#endif /* _RIA_MON_XFR_H_ */
@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef RP6502_RIA_W
+#include "api/api.h"
+#include "net/skt.h"
+void skt_stop(void) {}
+bool skt_api_socket(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_connect(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_bind(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_listen(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_accept(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_send(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_recv(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_sendto(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_recvfrom(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_poll(void) { return api_return_errno(API_ENOSYS); }
+bool skt_api_close(void) { return api_return_errno(API_ENOSYS); }
+#else
+
+#include "api/api.h"
+#include "net/skt.h"
+#include "sys/mem.h"
+#include <lwip/dns.h>
+#include <lwip/pbuf.h>
+#include <lwip/tcp.h>
+#include <lwip/udp.h>
+
+#if defined(DEBUG_RIA_NET) || defined(DEBUG_RIA_NET_SKT)
+#include <stdio.h>
+#define DBG(...) fprintf(stderr, __VA_ARGS__)
+#else
+static inline void DBG(const char *fmt, ...) { (void)fmt; }
+#endif
+
+// Pending datagrams per UDP socket and
+// pending connections per listening TCP socket.
+#define SKT_QUEUE_SIZE 4
+
+typedef enum
+{
+    skt_state_free,
+    skt_state_open,
+    skt_state_dns_lookup,
+    skt_state_connecting,
+    skt_state_connected,
+    skt_state_listening,
+    skt_state_closed, // by peer or error, rx may still hold data
+} skt_state_t;
+
+typedef struct
+{
+    skt_state_t state;
+    uint8_t type;
+    uint8_t gen; // bumped on every alloc, stale DNS replies are dropped
+    err_t err;
+    u16_t port;
+    union
+    {
+        struct tcp_pcb *tcp;
+        struct udp_pcb *udp;
+    } pcb;
+    struct pbuf *rx; // TCP stream
+    uint8_t queue_head;
+    uint8_t queue_tail;
+    union
+    {
+        struct
+        {
+            struct pbuf *p;
+            ip_addr_t addr;
+            u16_t port;
+        } udp[SKT_QUEUE_SIZE];
+        int8_t tcp[SKT_QUEUE_SIZE]; // accepted socket numbers
+    } queue;
+} skt_t;
+
+static skt_t skt_sockets[SKT_MAX];
+
+// Socket being waited on by connect.
+static int skt_pending = -1;
+
+static api_errno skt_errno(err_t err)
+{
+    switch (err)
+    {
+    case ERR_MEM:
+    case ERR_BUF:
+        return API_ENOMEM;
+    case ERR_INPROGRESS:
+    case ERR_WOULDBLOCK:
+        return API_EAGAIN;
+    case ERR_USE:
+    case ERR_ALREADY:
+    case ERR_ISCONN:
+        return API_EBUSY;
+    case ERR_RTE: // includes DNS failures
+        return API_ENOENT;
+    case ERR_IF:
+        return API_ENODEV;
+    case ERR_VAL:
+    case ERR_ARG:
+        return API_EINVAL;
+    default:
+        return API_EIO;
+    }
+}
+
+static bool skt_queue_empty(const skt_t *skt)
+{
+    return skt->queue_head == skt->queue_tail;
+}
+
+static bool skt_queue_full(const skt_t *skt)
+{
+    return (skt->queue_head + 1) % SKT_QUEUE_SIZE == skt->queue_tail;
+}
+
+static skt_t *skt_get(int sd)
+{
+    if (sd < 0 || sd >= SKT_MAX || skt_sockets[sd].state == skt_state_free)
+        return NULL;
+    return &skt_sockets[sd];
+}
+
+static int skt_alloc(uint8_t type)
+{
+    for (int sd = 0; sd < SKT_MAX; sd++)
+        if (skt_sockets[sd].state == skt_state_free)
+        {
+            skt_t *skt = &skt_sockets[sd];
+            uint8_t gen = skt->gen + 1;
+            memset(skt, 0, sizeof(skt_t));
+            skt->gen = gen;
+            skt->state = skt_state_open;
+            skt->type = type;
+            return sd;
+        }
+    return -1;
+}
+
+static void skt_free(int sd)
+{
+    skt_t *skt = &skt_sockets[sd];
+    if (skt_pending == sd)
+        skt_pending = -1;
+    if (skt->type == SKT_TYPE_UDP)
+    {
+        if (skt->pcb.udp)
+            udp_remove(skt->pcb.udp);
+        while (!skt_queue_empty(skt))
+        {
+            pbuf_free(skt->queue.udp[skt->queue_tail].p);
+            skt->queue_tail = (skt->queue_tail + 1) % SKT_QUEUE_SIZE;
+        }
+    }
+    else
+    {
+        // Accepted but never claimed connections go with the listener.
+        if (skt->state == skt_state_listening)
+            while (!skt_queue_empty(skt))
+            {
+                skt_free(skt->queue.tcp[skt->queue_tail]);
+                skt->queue_tail = (skt->queue_tail + 1) % SKT_QUEUE_SIZE;
+            }
+        if (skt->pcb.tcp)
+        {
+            tcp_arg(skt->pcb.tcp, NULL);
+            if (skt->state != skt_state_listening)
+            {
+                tcp_recv(skt->pcb.tcp, NULL);
+                tcp_err(skt->pcb.tcp, NULL);
+            }
+            else
+                tcp_accept(skt->pcb.tcp, NULL);
+            if (tcp_close(skt->pcb.tcp) != ERR_OK)
+            {
+                DBG("NET SKT tcp_close failed\n");
+                tcp_abort(skt->pcb.tcp);
+            }
+        }
+        if (skt->rx)
+            pbuf_free(skt->rx);
+    }
+    skt->pcb.tcp = NULL;
+    skt->rx = NULL;
+    skt->state = skt_state_free;
+}
+
+static err_t skt_tcp_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    (void)tpcb;
+    (void)err;
+    skt_t *skt = arg;
+    if (!skt)
+    {
+        if (p)
+            pbuf_free(p);
+        return ERR_OK;
+    }
+    if (!p)
+    {
+        DBG("NET SKT peer closed\n");
+        skt->state = skt_state_closed;
+        return ERR_OK;
+    }
+    if (skt->rx)
+        pbuf_cat(skt->rx, p);
+    else
+        skt->rx = p;
+    return ERR_OK;
+}
+
+static void skt_tcp_err(void *arg, err_t err)
+{
+    skt_t *skt = arg;
+    DBG("NET SKT tcp_err %d\n", err);
+    if (!skt)
+        return;
+    // The pcb is already freed by lwIP.
+    skt->pcb.tcp = NULL;
+    skt->err = err;
+    skt->state = skt_state_closed;
+}
+
+static void skt_tcp_callbacks(skt_t *skt)
+{
+    tcp_arg(skt->pcb.tcp, skt);
+    tcp_recv(skt->pcb.tcp, skt_tcp_recv);
+    tcp_err(skt->pcb.tcp, skt_tcp_err);
+}
+
+static err_t skt_tcp_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
+{
+    (void)tpcb;
+    skt_t *skt = arg;
+    DBG("NET SKT TCP connected %d\n", err);
+    if (skt)
+        skt->state = skt_state_connected;
+    return ERR_OK;
+}
+
+static err_t skt_tcp_accept(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+    skt_t *listener = arg;
+    if (err != ERR_OK || !newpcb)
+        return ERR_VAL;
+    int sd = -1;
+    if (listener && !skt_queue_full(listener))
+        sd = skt_alloc(SKT_TYPE_TCP);
+    if (sd < 0)
+    {
+        DBG("NET SKT accept dropped\n");
+        tcp_abort(newpcb);
+        return ERR_ABRT;
+    }
+    // Claim the connection now so no data is lost before accept.
+    skt_t *skt = &skt_sockets[sd];
+    skt->pcb.tcp = newpcb;
+    skt->state = skt_state_connected;
+    skt_tcp_callbacks(skt);
+    tcp_nagle_disable(newpcb);
+    listener->queue.tcp[listener->queue_head] = sd;
+    listener->queue_head = (listener->queue_head + 1) % SKT_QUEUE_SIZE;
+    return ERR_OK;
+}
+
+static void skt_udp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+                         const ip_addr_t *addr, u16_t port)
+{
+    (void)pcb;
+    skt_t *skt = arg;
+    if (!skt || skt_queue_full(skt))
+    {
+        pbuf_free(p);
+        return;
+    }
+    skt->queue.udp[skt->queue_head].p = p;
+    ip_addr_copy(skt->queue.udp[skt->queue_head].addr, *addr);
+    skt->queue.udp[skt->queue_head].port = port;
+    skt->queue_head = (skt->queue_head + 1) % SKT_QUEUE_SIZE;
+}
+
+// The lookup can outlive its socket, so arg names the socket
+// and its generation instead of pointing at it.
+static void *skt_dns_arg(int sd)
+{
+    return (void *)(uintptr_t)(sd << 8 | skt_sockets[sd].gen);
+}
+
+static void skt_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
+{
+    (void)name;
+    const uintptr_t id = (uintptr_t)arg;
+    skt_t *skt = skt_get(id >> 8);
+    if (!skt || skt->gen != (uint8_t)id || skt->state != skt_state_dns_lookup)
+        return;
+    if (!ipaddr)
+    {
+        DBG("NET SKT DNS did not resolve\n");
+        skt->err = ERR_RTE;
+        skt->state = skt_state_closed;
+        return;
+    }
+    skt->state = skt_state_connecting;
+    err_t err = tcp_connect(skt->pcb.tcp, ipaddr, skt->port, skt_tcp_connected);
+    if (err != ERR_OK)
+    {
+        DBG("NET SKT tcp_connect failed %d\n", err);
+        skt->err = err;
+        skt->state = skt_state_closed;
+    }
+}
+
+// int socket(int type);
+bool skt_api_socket(void)
+{
+    uint8_t type = API_A;
+    if (type != SKT_TYPE_TCP && type != SKT_TYPE_UDP)
+        return api_return_errno(API_EINVAL);
+    int sd = skt_alloc(type);
+    if (sd < 0)
+        return api_return_errno(API_EMFILE);
+    skt_t *skt = &skt_sockets[sd];
+    if (type == SKT_TYPE_UDP)
+    {
+        skt->pcb.udp = udp_new();
+        if (skt->pcb.udp)
+            udp_recv(skt->pcb.udp, skt_udp_recv, skt);
+    }
+    else
+    {
+        skt->pcb.tcp = tcp_new();
+        if (skt->pcb.tcp)
+        {
+            skt_tcp_callbacks(skt);
+            tcp_nagle_disable(skt->pcb.tcp);
+        }
+    }
+    if (!skt->pcb.tcp)
+    {
+        skt->state = skt_state_free;
+        return api_return_errno(API_ENOMEM);
+    }
+    return api_return_ax(sd);
+}
+
+// int connect(const char *host, uint16_t port, int sd);
+bool skt_api_connect(void)
+{
+    if (skt_pending < 0)
+    {
+        int sd = API_A;
+        skt_t *skt = skt_get(sd);
+        if (!skt)
+            return api_return_errno(API_EBADF);
+        if (skt->type != SKT_TYPE_TCP || skt->state != skt_state_open
+            || !api_pop_uint16(&skt->port))
+            return api_return_errno(API_EINVAL);
+        const char *host = (const char *)&xstack[xstack_ptr];
+        xstack_ptr = XSTACK_SIZE;
+        ip_addr_t ipaddr;
+        skt->state = skt_state_dns_lookup;
+        err_t err = dns_gethostbyname(host, &ipaddr, skt_dns_found, skt_dns_arg(sd));
+        if (err == ERR_OK)
+            skt_dns_found(host, &ipaddr, skt_dns_arg(sd));
+        else if (err != ERR_INPROGRESS)
+        {
+            DBG("NET SKT dns_gethostbyname (%d)\n", err);
+            skt->state = skt_state_open;
+            return api_return_errno(skt_errno(err));
+        }
+        skt_pending = sd;
+    }
+    skt_t *skt = &skt_sockets[skt_pending];
+    switch (skt->state)
+    {
+    case skt_state_dns_lookup:
+    case skt_state_connecting:
+        return api_working();
+    case skt_state_connected:
+        skt_pending = -1;
+        return api_return_ax(0);
+    default:
+        skt_pending = -1;
+        return api_return_errno(skt_errno(skt->err));
+    }
+}
+
+// int bind(uint16_t port, int sd);
+bool skt_api_bind(void)
+{
+    uint16_t port;
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->state != skt_state_open || !api_pop_uint16_end(&port))
+        return api_return_errno(API_EINVAL);
+    err_t err;
+    if (skt->type == SKT_TYPE_UDP)
+        err = udp_bind(skt->pcb.udp, IP_ANY_TYPE, port);
+    else
+        err = tcp_bind(skt->pcb.tcp, IP_ANY_TYPE, port);
+    if (err != ERR_OK)
+        return api_return_errno(skt_errno(err));
+    return api_return_ax(0);
+}
+
+// int listen(int sd);
+bool skt_api_listen(void)
+{
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->type != SKT_TYPE_TCP || skt->state != skt_state_open)
+        return api_return_errno(API_EINVAL);
+    struct tcp_pcb *pcb = tcp_listen_with_backlog(skt->pcb.tcp, SKT_QUEUE_SIZE - 1);
+    if (!pcb)
+        return api_return_errno(API_ENOMEM);
+    skt->pcb.tcp = pcb;
+    skt->state = skt_state_listening;
+    tcp_arg(pcb, skt);
+    tcp_accept(pcb, skt_tcp_accept);
+    return api_return_ax(0);
+}
+
+// int accept(int sd);
+bool skt_api_accept(void)
+{
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->state != skt_state_listening)
+        return api_return_errno(API_EINVAL);
+    if (skt_queue_empty(skt))
+        return api_return_errno(API_EAGAIN);
+    int sd = skt->queue.tcp[skt->queue_tail];
+    skt->queue_tail = (skt->queue_tail + 1) % SKT_QUEUE_SIZE;
+    return api_return_ax(sd);
+}
+
+// int send(uint32_t addr24, uint16_t count, int sd);
+bool skt_api_send(void)
+{
+    uint16_t count;
+    uint32_t addr24;
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->type != SKT_TYPE_TCP
+        || !api_pop_uint16(&count)
+        || !api_pop_uint32_end(&addr24))
+        return api_return_errno(API_EINVAL);
+    if (skt->state != skt_state_connected || !skt->pcb.tcp)
+        return api_return_errno(skt->err ? skt_errno(skt->err) : API_EIO);
+    size_t len = tcp_sndbuf(skt->pcb.tcp);
+    if (len > count)
+        len = count;
+    if (len > MBUF_SIZE)
+        len = MBUF_SIZE;
+    if (!len && count)
+        return api_return_errno(API_EAGAIN);
+    mem_read(mbuf, addr24, len);
+    err_t err = tcp_write(skt->pcb.tcp, mbuf, len, TCP_WRITE_FLAG_COPY);
+    if (err == ERR_OK)
+        err = tcp_output(skt->pcb.tcp);
+    if (err != ERR_OK)
+        return api_return_errno(skt_errno(err));
+    return api_return_ax(len);
+}
+
+// int recv(uint32_t addr24, uint16_t count, int sd);
+bool skt_api_recv(void)
+{
+    uint16_t count;
+    uint32_t addr24;
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->type != SKT_TYPE_TCP
+        || !api_pop_uint16(&count)
+        || !api_pop_uint32_end(&addr24))
+        return api_return_errno(API_EINVAL);
+    if (!skt->rx)
+    {
+        if (skt->state == skt_state_connected)
+            return api_return_errno(API_EAGAIN);
+        if (skt->state == skt_state_closed && !skt->err)
+            return api_return_ax(0); // EOF
+        return api_return_errno(skt->err ? skt_errno(skt->err) : API_EINVAL);
+    }
+    if (count > 0x7FFF)
+        count = 0x7FFF;
+    uint16_t moved = 0;
+    while (skt->rx && moved < count)
+    {
+        size_t len = count - moved;
+        if (len > MBUF_SIZE)
+            len = MBUF_SIZE;
+        len = pbuf_copy_partial(skt->rx, mbuf, len, 0);
+        mem_cpy(addr24 + moved, mbuf, len);
+        skt->rx = pbuf_free_header(skt->rx, len);
+        if (skt->pcb.tcp)
+            tcp_recved(skt->pcb.tcp, len);
+        moved += len;
+    }
+    return api_return_ax(moved);
+}
+
+// int sendto(uint32_t addr24, uint16_t count, uint32_t ip, uint16_t port, int sd);
+// The IPv4 address is in network byte order.
+bool skt_api_sendto(void)
+{
+    uint16_t port;
+    uint32_t ip;
+    uint16_t count;
+    uint32_t addr24;
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->type != SKT_TYPE_UDP
+        || !api_pop_uint16(&port)
+        || !api_pop_uint32(&ip)
+        || !api_pop_uint16(&count)
+        || !api_pop_uint32_end(&addr24)
+        || count > MBUF_SIZE)
+        return api_return_errno(API_EINVAL);
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, count, PBUF_RAM);
+    if (!p)
+        return api_return_errno(API_ENOMEM);
+    mem_read(mbuf, addr24, count);
+    pbuf_take(p, mbuf, count);
+    ip_addr_t ipaddr;
+    ip_addr_set_ip4_u32(&ipaddr, ip);
+    err_t err = udp_sendto(skt->pcb.udp, p, &ipaddr, port);
+    pbuf_free(p);
+    if (err != ERR_OK)
+        return api_return_errno(skt_errno(err));
+    return api_return_ax(count);
+}
+
+// int recvfrom(uint32_t addr24, uint16_t count, int sd);
+// Pushes the sender port then IPv4 address for the CPU to pop.
+// Datagrams longer than count are truncated.
+bool skt_api_recvfrom(void)
+{
+    uint16_t count;
+    uint32_t addr24;
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    if (skt->type != SKT_TYPE_UDP
+        || !api_pop_uint16(&count)
+        || !api_pop_uint32_end(&addr24))
+        return api_return_errno(API_EINVAL);
+    if (skt_queue_empty(skt))
+        return api_return_errno(API_EAGAIN);
+    struct pbuf *p = skt->queue.udp[skt->queue_tail].p;
+    uint32_t ip = ip4_addr_get_u32(ip_2_ip4(&skt->queue.udp[skt->queue_tail].addr));
+    uint16_t port = skt->queue.udp[skt->queue_tail].port;
+    skt->queue_tail = (skt->queue_tail + 1) % SKT_QUEUE_SIZE;
+    if (count > MBUF_SIZE)
+        count = MBUF_SIZE;
+    count = pbuf_copy_partial(p, mbuf, count, 0);
+    pbuf_free(p);
+    mem_cpy(addr24, mbuf, count);
+    api_push_uint16(&port);
+    api_push_uint32(&ip);
+    return api_return_ax(count);
+}
+
+// int poll(int sd);
+bool skt_api_poll(void)
+{
+    skt_t *skt = skt_get(API_A);
+    if (!skt)
+        return api_return_errno(API_EBADF);
+    uint16_t events = 0;
+    if (skt->type == SKT_TYPE_UDP)
+    {
+        events |= SKT_POLLOUT;
+        if (!skt_queue_empty(skt))
+            events |= SKT_POLLIN;
+    }
+    else
+        switch (skt->state)
+        {
+        case skt_state_connected:
+            if (skt->rx)
+                events |= SKT_POLLIN;
+            if (skt->pcb.tcp && tcp_sndbuf(skt->pcb.tcp))
+                events |= SKT_POLLOUT;
+            break;
+        case skt_state_listening:
+            if (!skt_queue_empty(skt))
+                events |= SKT_POLLIN;
+            break;
+        case skt_state_closed:
+            events |= SKT_POLLIN | SKT_POLLHUP;
+            if (skt->err)
+                events |= SKT_POLLERR;
+            break;
+        default:
+            break;
+        }
+    return api_return_ax(events);
+}
+
+// int close(int sd);
+bool skt_api_close(void)
+{
+    int sd = API_A;
+    if (!skt_get(sd))
+        return api_return_errno(API_EBADF);
+    skt_free(sd);
+    return api_return_ax(0);
+}
+
+void skt_stop(void)
+{
+    for (int sd = 0; sd < SKT_MAX; sd++)
+        if (skt_sockets[sd].state != skt_state_free)
+            skt_free(sd);
+    skt_pending = -1;
+}
+
+#endif /* RP6502_RIA_W */
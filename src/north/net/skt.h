@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _RIA_NET_SKT_H_
+#define _RIA_NET_SKT_H_
+
+/* Native TCP/UDP sockets for the CPU.
+ * Built directly on lwIP raw API, bypassing the modem emulation.
+ * All calls are non-blocking except connect, which waits for
+ * DNS and the TCP handshake to finish.
+ * Payloads move between lwIP pbufs and PSRAM in bulk.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SKT_MAX 8
+
+#define SKT_TYPE_TCP 0
+#define SKT_TYPE_UDP 1
+
+// Bits returned by skt_api_poll. Same values as POSIX poll().
+#define SKT_POLLIN  0x01
+#define SKT_POLLOUT 0x04
+#define SKT_POLLERR 0x08
+#define SKT_POLLHUP 0x10
+
+/* Main events
+ */
+
+void skt_stop(void);
+
+/* The API implementation for sockets.
+ */
+
+bool skt_api_socket(void);
+bool skt_api_connect(void);
+bool skt_api_bind(void);
+bool skt_api_listen(void);
+bool skt_api_accept(void);
+bool skt_api_send(void);
+bool skt_api_recv(void);
+bool skt_api_sendto(void);
+bool skt_api_recvfrom(void);
+bool skt_api_poll(void);
+bool skt_api_close(void);
+
+#endif /* _RIA_NET_SKT_H_ */
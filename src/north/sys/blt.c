@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "sys/blt.h"
+#include "sys/mem.h"
+#include "sys/ria.h"
+#include <string.h>
+
+#if defined(DEBUG_RIA_SYS) || defined(DEBUG_RIA_SYS_BLT)
+#include <stdio.h>
+#define DBG(...) fprintf(stderr, __VA_ARGS__)
+#else
+static inline void DBG(const char *fmt, ...)
+{
+    (void)fmt;
+}
+#endif
+
+// Bytes moved per blt_step(). CPU bus cycles wait while it runs.
+#define BLT_STEP_COPY 64
+#define BLT_STEP_FILL 256
+
+static struct
+{
+    uint32_t src; // start of current row
+    uint32_t dst;
+    int32_t src_stride;
+    int32_t dst_stride;
+    uint32_t width;
+    uint32_t done; // bytes of current row moved
+    uint32_t rows; // rows left, including current
+    uint8_t op;
+    uint8_t fill;
+    uint8_t mask;
+    bool backwards; // copy to a higher address, last byte first
+    bool irq;
+} blt;
+
+volatile bool blt_busy;
+static volatile bool blt_done;
+
+static uint8_t blt_src_buf[BLT_STEP_COPY];
+static uint8_t blt_dst_buf[BLT_STEP_COPY];
+
+void blt_start(uint8_t ctrl)
+{
+    if (blt_busy)
+        DBG("BLT aborted, %lu rows left\n", (unsigned long)blt.rows);
+    blt_busy = false;
+    if (!(ctrl & BLT_CTRL_START))
+        return;
+
+    blt.op = ctrl & BLT_CTRL_OP;
+    blt.irq = ctrl & BLT_CTRL_IRQ;
+    blt.src = REGSDW(BLT_REG_SRC) & 0xFFFFFF;
+    blt.fill = REGS(BLT_REG_FILL);
+    blt.dst = REGSDW(BLT_REG_DST) & 0xFFFFFF;
+    blt.mask = REGS(BLT_REG_MASK);
+    blt.width = REGSW(BLT_REG_WIDTH) ? REGSW(BLT_REG_WIDTH) : 0x10000;
+    blt.rows = REGS(BLT_REG_HEIGHT) ? REGS(BLT_REG_HEIGHT) : 256;
+    blt.src_stride = (int16_t)(REGS(BLT_REG_SSTRIDE) | REGS(BLT_REG_SSTRIDE + 1) << 8);
+    blt.dst_stride = (int16_t)(REGS(BLT_REG_DSTRIDE) | REGS(BLT_REG_DSTRIDE + 1) << 8);
+    blt.done = 0;
+
+    // Overlapping copies must not read what they already wrote.
+    blt.backwards = blt.op != BLT_OP_FILL && blt.dst > blt.src;
+    if (blt.backwards)
+    {
+        blt.src = (blt.src + (blt.rows - 1) * blt.src_stride) & 0xFFFFFF;
+        blt.dst = (blt.dst + (blt.rows - 1) * blt.dst_stride) & 0xFFFFFF;
+    }
+
+    blt_done = false;
+    ria_clear_irq(RIA_IRQ_SOURCE_BLT);
+    DBG("BLT op %u %06lX -> %06lX, %lu x %lu\n", blt.op,
+        (unsigned long)blt.src, (unsigned long)blt.dst,
+        (unsigned long)blt.width, (unsigned long)blt.rows);
+    blt_busy = true;
+}
+
+uint8_t blt_status(void)
+{
+    uint8_t status = blt.op;
+    if (blt_busy)
+        status |= BLT_STAT_BUSY;
+    if (blt_done)
+    {
+        status |= BLT_STAT_DONE;
+        blt_done = false;
+        ria_clear_irq(RIA_IRQ_SOURCE_BLT);
+    }
+    return status;
+}
+
+// Bytes from addr24 to the end of its bank
+static inline uint32_t blt_bank_left(uint32_t addr24)
+{
+    return 0x10000 - (addr24 & 0xFFFF);
+}
+
+void __not_in_flash_func(blt_step)(void)
+{
+    uint32_t len = blt.width - blt.done;
+    const uint32_t step = blt.op == BLT_OP_FILL ? BLT_STEP_FILL : BLT_STEP_COPY;
+    if (len > step)
+        len = step;
+
+    // Blocks stay within a bank on both sides.
+    uint32_t src, dst;
+    if (!blt.backwards)
+    {
+        src = (blt.src + blt.done) & 0xFFFFFF;
+        dst = (blt.dst + blt.done) & 0xFFFFFF;
+        if (blt.op != BLT_OP_FILL && len > blt_bank_left(src))
+            len = blt_bank_left(src);
+        if (len > blt_bank_left(dst))
+            len = blt_bank_left(dst);
+    }
+    else
+    {
+        const uint32_t left = blt.width - blt.done;
+        src = (blt.src + left - 1) & 0xFFFFFF;
+        dst = (blt.dst + left - 1) & 0xFFFFFF;
+        if (len > (src & 0xFFFF) + 1)
+            len = (src & 0xFFFF) + 1;
+        if (len > (dst & 0xFFFF) + 1)
+            len = (dst & 0xFFFF) + 1;
+        src = (src - len + 1) & 0xFFFFFF;
+        dst = (dst - len + 1) & 0xFFFFFF;
+    }
+
+    switch (blt.op)
+    {
+    case BLT_OP_COPY:
+        mem_read_blk(src, blt_src_buf, len);
+        mem_write_blk(dst, blt_src_buf, len);
+        break;
+    case BLT_OP_FILL:
+        mem_fill_blk(dst, blt.fill, len);
+        break;
+    case BLT_OP_MASK:
+        mem_read_blk(src, blt_src_buf, len);
+        mem_read_blk(dst, blt_dst_buf, len);
+        for (uint32_t i = 0; i < len; ++i)
+            blt_src_buf[i] = (blt_src_buf[i] & blt.mask) | (blt_dst_buf[i] & ~blt.mask);
+        mem_write_blk(dst, blt_src_buf, len);
+        break;
+    case BLT_OP_KEY:
+        mem_read_blk(src, blt_src_buf, len);
+        mem_read_blk(dst, blt_dst_buf, len);
+        for (uint32_t i = 0; i < len; ++i)
+            if (blt_src_buf[i] == blt.fill)
+                blt_src_buf[i] = blt_dst_buf[i];
+        mem_write_blk(dst, blt_src_buf, len);
+        break;
+    }
+
+    blt.done += len;
+    if (blt.done < blt.width)
+        return;
+
+    // Next row
+    blt.done = 0;
+    if (--blt.rows)
+    {
+        const int32_t dir = blt.backwards ? -1 : 1;
+        blt.src = (blt.src + dir * blt.src_stride) & 0xFFFFFF;
+        blt.dst = (blt.dst + dir * blt.dst_stride) & 0xFFFFFF;
+        return;
+    }
+
+    blt_busy = false;
+    blt_done = true;
+    if (blt.irq)
+        ria_set_irq(RIA_IRQ_SOURCE_BLT);
+}
+
+void blt_stop(void)
+{
+    blt_busy = false;
+    blt_done = false;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _RIA_SYS_BLT_H_
+#define _RIA_SYS_BLT_H_
+
+/* Blitter - RAM copy, fill and masked copy run by the RIA.
+ * Blocks move in PSRAM bursts and reach the VPU as block writes,
+ * between CPU bus cycles, so the CPU keeps running meanwhile.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Registers in the RIA window, multi-byte values are little endian.
+#define BLT_REG_SRC     0xFFD0 // 24-bit source address
+#define BLT_REG_FILL    0xFFD3 // fill value, transparent value for BLT_OP_KEY
+#define BLT_REG_DST     0xFFD4 // 24-bit destination address
+#define BLT_REG_MASK    0xFFD7 // destination bits BLT_OP_MASK writes
+#define BLT_REG_WIDTH   0xFFD8 // 16-bit bytes per row, 0 for 64 KB
+#define BLT_REG_HEIGHT  0xFFDA // rows, 0 for 256
+#define BLT_REG_SSTRIDE 0xFFDB // signed 16-bit source row stride
+#define BLT_REG_DSTRIDE 0xFFDD // signed 16-bit destination row stride, rows must not overlap
+#define BLT_REG_CTRL    0xFFDF // write control, read status
+
+// Control. Writing without BLT_CTRL_START aborts a running blit.
+#define BLT_CTRL_OP    0b00000011
+#define BLT_CTRL_IRQ   0b01000000 // raise IRQ when done
+#define BLT_CTRL_START 0b10000000
+
+#define BLT_OP_COPY 0 // dst = src
+#define BLT_OP_FILL 1 // dst = fill
+#define BLT_OP_MASK 2 // dst = src & mask | dst & ~mask
+#define BLT_OP_KEY  3 // dst = src, unless src == fill
+
+// Status. Reading it clears BLT_STAT_DONE and the IRQ.
+#define BLT_STAT_BUSY 0b10000000
+#define BLT_STAT_DONE 0b01000000 // finished since last read
+
+/* Main events
+ */
+
+void blt_stop(void);
+
+// Register access from the CPU bus
+void blt_start(uint8_t ctrl);
+uint8_t blt_status(void);
+
+// Move the next block, called between CPU bus cycles.
+extern volatile bool blt_busy;
+void blt_step(void);
+
+static inline bool blt_active(void)
+{
+    return blt_busy;
+}
+
+#endif /* _RIA_SYS_BLT_H_ */
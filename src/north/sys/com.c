@@ -9,8 +9,10 @@
 #include "hw.h"
 #include "main.h"
 #include "sys/mem.h"
+#include <hardware/dma.h>
 #include <pico/stdio/driver.h>
 #include <pico/stdlib.h>
+#include <stdio.h>
 
 #if defined(DEBUG_RIA_SYS) || defined(DEBUG_RIA_SYS_COM)
 #include <stdio.h>
@@ -27,41 +29,91 @@ static inline void DBG(const char *fmt, ...)
 
 static stdio_driver_t com_stdio_driver;
 
+// Both rings are serviced by DMA so nothing is lost while the
+// main loop is stuck in a long blocking operation.
 volatile size_t com_tx_tail;
 volatile size_t com_tx_head;
 volatile uint8_t com_tx_buf[COM_TX_BUF_SIZE];
+static int com_tx_dma_chan;
+static size_t com_tx_dma_count;
 
-#define COM_RX_BUF_SIZE 32
-static size_t com_rx_tail;
-static size_t com_rx_head;
-static uint8_t com_rx_buf[COM_RX_BUF_SIZE];
+#define COM_RX_BUF_BITS 12
+#define COM_RX_BUF_SIZE (1u << COM_RX_BUF_BITS)
+static uint8_t com_rx_buf[COM_RX_BUF_SIZE]
+    __attribute__((aligned(COM_RX_BUF_SIZE)));
+static int com_rx_dma_chan;
+static volatile uint32_t com_rx_laps;
+static uint32_t com_rx_read; // total bytes consumed
+static uint32_t com_rx_overflow;
 volatile int com_rx_char;
 
-static int com_rx_buf_getchar(void)
+// Total bytes DMA has written into the RX ring since com_init.
+static uint32_t com_rx_written(void)
 {
-    if (com_rx_head != com_rx_tail)
+    uint32_t laps, remaining;
+    do
     {
-        com_rx_tail = (com_rx_tail + 1) % COM_RX_BUF_SIZE;
-        return com_rx_buf[com_rx_tail];
+        laps = com_rx_laps;
+        remaining = dma_channel_hw_addr(com_rx_dma_chan)->transfer_count;
+    } while (laps != com_rx_laps);
+    return laps * COM_RX_BUF_SIZE + COM_RX_BUF_SIZE - remaining;
+}
+
+static void __isr __not_in_flash_func(com_rx_dma_irq_handler)(void)
+{
+    if (dma_irqn_get_channel_status(COM_DMA_IRQ_INDEX, com_rx_dma_chan))
+    {
+        dma_irqn_acknowledge_channel(COM_DMA_IRQ_INDEX, com_rx_dma_chan);
+        com_rx_laps++;
+        // Write address has wrapped back to the start of the ring.
+        dma_channel_set_trans_count(com_rx_dma_chan, COM_RX_BUF_SIZE, true);
     }
+}
+
+static size_t com_rx_available(void)
+{
+    uint32_t available = com_rx_written() - com_rx_read;
+    if (available > COM_RX_BUF_SIZE)
+    {
+        // DMA lapped the reader, the oldest data is gone.
+        com_rx_overflow += available - COM_RX_BUF_SIZE;
+        com_rx_read += available - COM_RX_BUF_SIZE;
+        available = COM_RX_BUF_SIZE;
+    }
+    return available;
+}
+
+static int com_rx_buf_getchar(void)
+{
+    if (com_rx_available())
+        return com_rx_buf[com_rx_read++ % COM_RX_BUF_SIZE];
     return -1;
 }
 
 static void com_clear_all_rx()
 {
     com_rx_char = -1;
-    com_rx_tail = com_rx_head = 0;
+    com_rx_read = com_rx_written();
 }
 
 static void com_tx_task(void)
 {
-    while (com_tx_head != com_tx_tail
-           && uart_get_hw(COM_UART)->fr & UART_UARTFR_TXFE_BITS)
+    if (dma_channel_is_busy(com_tx_dma_chan))
+        return;
+    if (com_tx_dma_count)
     {
-        com_tx_tail = (com_tx_tail + 1) % COM_TX_BUF_SIZE;
-        char ch = com_tx_buf[com_tx_tail];
-        uart_putc_raw(COM_UART, ch);
+        com_tx_tail = (com_tx_tail + com_tx_dma_count) % COM_TX_BUF_SIZE;
+        com_tx_dma_count = 0;
     }
+    size_t head = com_tx_head;
+    if (head == com_tx_tail)
+        return;
+    // Send the contiguous run up to head or the end of the ring.
+    size_t start = (com_tx_tail + 1) % COM_TX_BUF_SIZE;
+    size_t end = head >= start ? head : COM_TX_BUF_SIZE - 1;
+    com_tx_dma_count = end - start + 1;
+    dma_channel_transfer_from_buffer_now(com_tx_dma_chan,
+                                         &com_tx_buf[start], com_tx_dma_count);
 }
 
 static int com_rx_task(char *buf, int length)
@@ -84,26 +136,59 @@ static int com_rx_task(char *buf, int length)
         in_keyboard = false;
     }
 
-    // Get char from UART
+    // Get chars from UART ring
     int count = 0;
-    bool readable = uart_is_readable(COM_UART);
-    if (readable)
+    if (com_rx_available())
         com_stdio_uart_timer = make_timeout_time_us(COM_STDIO_UART_PAUSE_US);
-    while (readable && count < length)
+    while (count < length)
     {
-        buf[count++] = (uint8_t)uart_get_hw(COM_UART)->dr;
-        readable = uart_is_readable(COM_UART);
+        int ch = com_rx_buf_getchar();
+        if (ch < 0)
+            break;
+        buf[count++] = ch;
     }
 
     return count ? count : PICO_ERROR_NO_DATA;
 }
 
+static void com_dma_init(void)
+{
+    // TX DMA feeds the UART from the TX ring on demand.
+    com_tx_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(com_tx_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq_num(COM_UART, true));
+    dma_channel_configure(com_tx_dma_chan, &c,
+                          &uart_get_hw(COM_UART)->dr, NULL, 0, false);
+
+    // RX DMA runs forever, wrapping around the RX ring.
+    com_rx_dma_chan = dma_claim_unused_channel(true);
+    c = dma_channel_get_default_config(com_rx_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, COM_RX_BUF_BITS);
+    channel_config_set_dreq(&c, uart_get_dreq_num(COM_UART, false));
+    dma_channel_configure(com_rx_dma_chan, &c,
+                          com_rx_buf, &uart_get_hw(COM_UART)->dr,
+                          COM_RX_BUF_SIZE, false);
+    dma_irqn_set_channel_enabled(COM_DMA_IRQ_INDEX, com_rx_dma_chan, true);
+    irq_add_shared_handler(dma_get_irq_num(COM_DMA_IRQ_INDEX),
+                           com_rx_dma_irq_handler,
+                           PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY);
+    irq_set_enabled(dma_get_irq_num(COM_DMA_IRQ_INDEX), true);
+    dma_channel_start(com_rx_dma_chan);
+}
+
 void com_init(void)
 {
     gpio_set_function(COM_UART_TX_PIN, COM_UART_GPIO_FUNC);
     gpio_set_function(COM_UART_RX_PIN, COM_UART_GPIO_FUNC);
     stdio_set_driver_enabled(&com_stdio_driver, true);
     uart_init(COM_UART, COM_UART_BAUD_RATE);
+    com_dma_init();
     com_clear_all_rx();
     // Wait for the UART to settle then purge everything.
     // If we leave garbage then there is a chance for
@@ -130,19 +215,16 @@ void com_task(void)
     // Process transmit.
     com_tx_task();
 
-    // Move char into ria action loop.
+    // Move char into ria action loop, from the UART ring or from
+    // the keyboard once the UART has been quiet.
+    // Receive is drained by DMA, which also keeps break detection
+    // working since the UART FIFO never fills.
     if (com_rx_char < 0)
-        com_rx_char = com_rx_buf_getchar();
-
-    // Process receive. UART doesn't detect breaks when FIFO is full
-    // so we keep it drained and discard overruns like the UART would.
-    char ch;
-    while (com_rx_task(&ch, 1) == 1)
-        if (((com_rx_head + 1) % COM_RX_BUF_SIZE) != com_rx_tail)
-        {
-            com_rx_head = (com_rx_head + 1) % COM_RX_BUF_SIZE;
-            com_rx_buf[com_rx_head] = ch;
-        }
+    {
+        char ch;
+        if (com_rx_task(&ch, 1) == 1)
+            com_rx_char = (uint8_t)ch;
+    }
 
     // Detect UART breaks.
     static uint32_t break_detect = 0;
@@ -168,7 +250,7 @@ static void com_stdio_out_chars(const char *buf, int len)
 
 static void com_stdio_out_flush(void)
 {
-    while (com_tx_head != com_tx_tail)
+    while (com_tx_head != com_tx_tail || com_tx_dma_count)
         com_tx_task();
     while (uart_get_hw(COM_UART)->fr & UART_UARTFR_BUSY_BITS)
         tight_loop_contents();
@@ -215,6 +297,15 @@ static int com_stdio_in_chars(char *buf, int length)
     return count ? count : PICO_ERROR_NO_DATA;
 }
 
+int com_status_response(char *buf, size_t buf_size, int state)
+{
+    if (state < 0)
+        return state;
+    snprintf(buf, buf_size, "COM : %d baud, %lu bytes RX overflow\n",
+             COM_UART_BAUD_RATE, (unsigned long)com_rx_overflow);
+    return -1;
+}
+
 static stdio_driver_t com_stdio_driver = {
     .out_chars = com_stdio_out_chars,
     .out_flush = com_stdio_out_flush,
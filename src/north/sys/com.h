@@ -22,13 +22,16 @@ void com_init(void);
 void com_run(void);
 void com_stop(void);
 
+// Monitor status, shows RX overflow count.
+int com_status_response(char *buf, size_t buf_size, int state);
+
 /* Expose the internals here because ria.c needs direct access
  */
 
 // 1-byte message queue to the RIA action loop. -1 = empty
 extern volatile int com_rx_char;
 
-#define COM_TX_BUF_SIZE 32
+#define COM_TX_BUF_SIZE 4096
 extern volatile uint8_t com_tx_buf[COM_TX_BUF_SIZE];
 extern volatile size_t com_tx_tail;
 extern volatile size_t com_tx_head;
@@ -15,6 +15,7 @@
 #include <hardware/sync.h>
 #include <pico.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(DEBUG_RIA_SYS) || defined(DEBUG_RIA_SYS_MEM)
 #include <stdio.h>
@@ -435,6 +436,7 @@ __force_inline void __attribute__((optimize("O3")))
 __not_in_flash_func(mem_write_ram)(uint32_t addr24, uint8_t data)
 {
     // L2 write-through cache
+    pix_vcache_touch(addr24);
     mem_select_bank(addr24 & 0x800000);
     *(volatile uint8_t *)(XIP_PSRAM_NOCACHE | (addr24 & 0x7FFFFF)) = data;
 
@@ -468,3 +470,95 @@ __not_in_flash_func(mem_fetch_row)(uint8_t bank, uint16_t addr)
                   (const uint32_t *)(XIP_PSRAM_NOCACHE | (addr24 & 0x7FFFE0)));
     return fetch_row_data;
 }
+
+#if MEM_USE_L2_CACHE
+#define MEM_PSRAM_BASE XIP_PSRAM_NOCACHE
+#else
+#define MEM_PSRAM_BASE XIP_PSRAM_CACHED
+#endif
+
+void __attribute__((optimize("O3")))
+__not_in_flash_func(mem_read_blk)(uint32_t addr24, uint8_t *buf, size_t len)
+{
+    // L2 cache is write-through, PSRAM is always current
+    mem_select_bank(addr24 & 0x800000);
+    memcpy(buf, (const void *)(MEM_PSRAM_BASE | (addr24 & 0x7FFFFF)), len);
+}
+
+// Mark the written blocks for VPU cache delta transfers,
+// before the data reaches PSRAM.
+static inline void mem_touch_blk(uint32_t addr24, size_t len)
+{
+    for (uint32_t a = addr24 & ~(PIX_VCACHE_BLOCK_SIZE - 1); a < addr24 + len; a += PIX_VCACHE_BLOCK_SIZE)
+        pix_vcache_touch(a);
+}
+
+// Update the L2 cache lines that are present.
+static inline void mem_l2_update(uint32_t addr24, const uint8_t *buf, uint8_t data, size_t len)
+{
+#if MEM_USE_L2_CACHE
+    while (len)
+    {
+        const uint16_t index = (addr24 >> 5) & CACHE_LINE_MASK;
+        const uint8_t tag = (addr24 >> 16) & TAG_MASK;
+        const uint16_t stored_tag = l2_tags[index];
+        const size_t offset = addr24 & OFFSET_MASK;
+        size_t run = CACHE_LINE_SIZE - offset;
+        if (run > len)
+            run = len;
+        if (((stored_tag & TAG_MASK) == tag) && (stored_tag & TAG_VALID_BIT))
+        {
+            if (buf)
+                memcpy(&l2_data[index][offset], buf, run);
+            else
+                memset(&l2_data[index][offset], data, run);
+        }
+        if (buf)
+            buf += run;
+        addr24 += run, len -= run;
+    }
+#else
+    (void)addr24, (void)buf, (void)data, (void)len;
+#endif
+}
+
+void __attribute__((optimize("O3")))
+__not_in_flash_func(mem_write_blk)(uint32_t addr24, const uint8_t *buf, size_t len)
+{
+    mem_touch_blk(addr24, len);
+    mem_select_bank(addr24 & 0x800000);
+    memcpy((void *)(MEM_PSRAM_BASE | (addr24 & 0x7FFFFF)), buf, len);
+    mem_l2_update(addr24, buf, 0, len);
+
+    // Sync write to CGIA L1 cache
+    uint8_t msg[3 + PIX_MEM_WRITE_MAX];
+    while (len)
+    {
+        const size_t run = len < PIX_MEM_WRITE_MAX ? len : PIX_MEM_WRITE_MAX;
+        msg[0] = (uint8_t)(addr24 >> 16);
+        msg[1] = (uint8_t)(addr24 >> 8);
+        msg[2] = (uint8_t)(addr24 & 0xFF);
+        memcpy(&msg[3], buf, run);
+        pix_send_request(PIX_MEM_WRITE, 3 + run, msg, nullptr);
+        addr24 += run, buf += run, len -= run;
+    }
+}
+
+void __attribute__((optimize("O3")))
+__not_in_flash_func(mem_fill_blk)(uint32_t addr24, uint8_t data, size_t len)
+{
+    mem_touch_blk(addr24, len);
+    mem_select_bank(addr24 & 0x800000);
+    memset((void *)(MEM_PSRAM_BASE | (addr24 & 0x7FFFFF)), data, len);
+    mem_l2_update(addr24, NULL, data, len);
+
+    // Sync write to CGIA L1 cache
+    pix_send_request(PIX_MEM_FILL, 6,
+                     (uint8_t[]) {(uint8_t)(addr24 >> 16),
+                                  (uint8_t)(addr24 >> 8),
+                                  (uint8_t)(addr24 & 0xFF),
+                                  (uint8_t)(len >> 8),
+                                  (uint8_t)(len & 0xFF),
+                                  data},
+                     nullptr);
+}
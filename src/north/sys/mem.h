@@ -100,6 +100,7 @@ __force_inline static void __attribute__((optimize("O3")))
 mem_write_ram(uint32_t addr24, uint8_t data)
 {
     // No L2 cache - direct write to PSRAM
+    pix_vcache_touch(addr24);
     mem_select_bank(addr24 & 0x800000);
     *(volatile uint8_t *)(XIP_PSRAM_CACHED | (addr24 & 0x7FFFFF)) = data;
     // Sync write to CGIA L1 cache
@@ -110,14 +111,41 @@ mem_write_ram(uint32_t addr24, uint8_t data)
 // Fetch a PSRAM cache row (32 bytes) and return a pointer to it
 uint8_t *mem_fetch_row(uint8_t bank, uint16_t addr);
 
-// helper function to copy memory to PSRAM
+// Block access within one 64 KB bank. Writes keep the L2 cache
+// and VPU cache in sync, sending blocks instead of single bytes.
+void mem_read_blk(uint32_t addr24, uint8_t *buf, size_t len);
+void mem_write_blk(uint32_t addr24, const uint8_t *buf, size_t len);
+void mem_fill_blk(uint32_t addr24, uint8_t data, size_t len);
+
+// helper function to copy memory to PSRAM, in blocks split at banks
 __force_inline static void __attribute__((optimize("O3")))
 mem_cpy(uint32_t dest_addr24, const void *src, size_t len)
 {
     const uint8_t *s = (const uint8_t *)src;
-    while (len--)
+    while (len)
+    {
+        const uint32_t addr24 = dest_addr24 & 0xFFFFFF;
+        size_t run = 0x10000 - (addr24 & 0xFFFF);
+        if (run > len)
+            run = len;
+        mem_write_blk(addr24, s, run);
+        dest_addr24 += run, s += run, len -= run;
+    }
+}
+
+// and its counterpart, copying PSRAM out
+__force_inline static void __attribute__((optimize("O3")))
+mem_read(void *dest, uint32_t src_addr24, size_t len)
+{
+    uint8_t *d = (uint8_t *)dest;
+    while (len)
     {
-        mem_write_ram(dest_addr24++, *s++);
+        const uint32_t addr24 = src_addr24 & 0xFFFFFF;
+        size_t run = 0x10000 - (addr24 & 0xFFFF);
+        if (run > len)
+            run = len;
+        mem_read_blk(addr24, d, run);
+        src_addr24 += run, d += run, len -= run;
     }
 }
 
@@ -6,9 +6,11 @@
 
 #include "sys/pix.h"
 #include "api/api.h"
+#include "api/sgu.h"
 #include "hw.h"
 #include "main.h"
 #include "pix.pio.h"
+#include "pix_pack.h"
 #include "sys/vpu.h"
 #include <hardware/clocks.h>
 #include <hardware/pio.h>
@@ -17,6 +19,7 @@
 #include <pico/time.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(DEBUG_RIA_SYS) || defined(DEBUG_RIA_SYS_PIX)
 #include <stdio.h>
@@ -35,9 +38,36 @@ static critical_section_t pix_resp_cs;
 static mutex_t pix_send_mutex;
 static absolute_time_t pix_last_activity;
 
-static uint16_t pix_dma_blocks_remaining = 0;
+// VPU cache slot transfer in progress
+static volatile bool pix_dma_active = false;
 static uint8_t pix_dma_bank = 0;
-static uint16_t pix_dma_offset = 0;
+static uint8_t pix_dma_slot = 0;
+static int pix_dma_src_bank = -1; // bank the slot holds, -1 for a full transfer
+static uint32_t pix_dma_offset = 0; // next block to scan
+static uint32_t pix_dma_dest = 0;   // where the VPU writes the next byte
+static uint8_t pix_dma_rows = 0;    // rows of the scanned block to send raw
+
+// Scanned block, and packed tokens waiting to fill a frame
+static uint8_t pix_dma_block[PIX_VCACHE_BLOCK_SIZE];
+static uint8_t pix_dma_pack[PIX_PACK_FRAME_MAX + 3 + PIX_VCACHE_BLOCK_SIZE];
+static size_t pix_dma_pack_len = 0;
+
+// Bank mirrored by each VPU cache slot, -1 when unknown
+static int pix_vcache_bank[PIX_VCACHE_SLOTS] = {-1, -1, -1, -1, -1, -1, -1, -1};
+// Bitmask of slots mirroring each bank
+uint8_t pix_vcache_slots[256];
+// Slot refills, and the last block marked with the count it was marked at
+volatile uint16_t pix_vcache_gen;
+volatile uint32_t pix_vcache_marked = UINT32_MAX;
+// Blocks of the mirrored bank written since each slot was filled
+static volatile uint8_t pix_vcache_dirty[PIX_VCACHE_SLOTS][0x10000 / PIX_VCACHE_BLOCK_SIZE];
+
+#define PIX_DMA_BLOCK_ROWS (PIX_VCACHE_BLOCK_SIZE / PIX_VCACHE_ROW_SIZE)
+
+// Send blocks packed when that takes fewer bytes than their raw rows.
+#ifndef PIX_DMA_PACK
+#define PIX_DMA_PACK 1
+#endif
 
 #define PIX_ACK_TIMEOUT_MS 50
 
@@ -84,9 +114,20 @@ static void __isr pix_irq_handler(void)
     case PIX_PONG:
         break;
     case PIX_DMA_REQ:
-        pix_dma_bank = (uint8_t)PIX_REPLY_PAYLOAD(reply);
+    {
+        const uint16_t payload = PIX_REPLY_PAYLOAD(reply);
+        pix_dma_bank = PIX_DMA_REQ_BANK(payload);
+        pix_dma_slot = PIX_DMA_REQ_SLOT(payload);
+        pix_dma_src_bank = (payload & PIX_DMA_REQ_DELTA) ? pix_vcache_bank[pix_dma_slot] : -1;
         pix_dma_offset = 0;
-        pix_dma_blocks_remaining = 0x10000 / 32; // 64kB in 32-byte blocks
+        pix_dma_dest = 0;
+        pix_dma_rows = 0;
+        pix_dma_pack_len = 0;
+        pix_dma_active = true;
+    }
+    break;
+    case PIX_PCM_REQ:
+        sgu_pcm_request(PIX_REPLY_PAYLOAD(reply));
         break;
     case PIX_DEV_DATA:
         if (!pix_resp)
@@ -103,6 +144,126 @@ static void __isr pix_irq_handler(void)
     }
 }
 
+void pix_vcache_mark(uint32_t addr24)
+{
+    const uint8_t block = (addr24 >> 8) & 0xFF;
+    uint8_t slots = pix_vcache_slots[addr24 >> 16];
+    for (uint slot = 0; slots; ++slot, slots >>= 1)
+        if (slots & 1)
+            pix_vcache_dirty[slot][block] = 1;
+}
+
+// Read the next block and queue what the VPU cache slot does not already hold.
+static void pix_dma_scan(void)
+{
+    const uint16_t block = pix_dma_offset;
+    pix_dma_offset += PIX_VCACHE_BLOCK_SIZE;
+    uint8_t rows = 0;
+    for (int i = 0; i < PIX_DMA_BLOCK_ROWS; ++i)
+    {
+        const uint16_t offset = block + i * PIX_VCACHE_ROW_SIZE;
+        uint8_t *row = &pix_dma_block[i * PIX_VCACHE_ROW_SIZE];
+        memcpy(row, mem_fetch_row(pix_dma_bank, offset), PIX_VCACHE_ROW_SIZE);
+        if (pix_dma_src_bank < 0
+            || memcmp(row, mem_fetch_row(pix_dma_src_bank, offset), PIX_VCACHE_ROW_SIZE))
+            rows |= 1u << i;
+    }
+    if (pix_dma_src_bank >= 0)
+    {
+        // Writes mark blocks dirty before reaching PSRAM,
+        // so check after the compare.
+        __dmb();
+        if (pix_vcache_dirty[pix_dma_slot][block / PIX_VCACHE_BLOCK_SIZE])
+            rows = 0xFF;
+    }
+    if (!rows)
+        return;
+
+    const uint first = __builtin_ctz(rows);
+    const uint last = 31 - __builtin_clz(rows);
+    const uint16_t start = block + first * PIX_VCACHE_ROW_SIZE;
+#if PIX_DMA_PACK
+    // Rows in between go too, they are what the slot holds anyway.
+    size_t len = pix_dma_pack_len;
+    if (pix_dma_dest != start)
+    {
+        pix_dma_pack[len++] = PIX_PACK_SEEK;
+        pix_dma_pack[len++] = start >> 8;
+        pix_dma_pack[len++] = start & 0xFF;
+    }
+    const size_t packed = pix_pack(&pix_dma_block[first * PIX_VCACHE_ROW_SIZE],
+                                   (last - first + 1) * PIX_VCACHE_ROW_SIZE,
+                                   &pix_dma_pack[len],
+                                   __builtin_popcount(rows) * PIX_VCACHE_ROW_SIZE - 1);
+    if (packed)
+    {
+        pix_dma_pack_len = len + packed;
+        pix_dma_dest = block + (last + 1) * PIX_VCACHE_ROW_SIZE;
+        return;
+    }
+#else
+    (void)first;
+    (void)last;
+    (void)start;
+#endif
+    pix_dma_rows = rows;
+}
+
+// Send the next frame of a VPU cache slot transfer.
+static void pix_dma_step(void)
+{
+    while (true)
+    {
+        // Packed tokens go out in full frames, or before anything else.
+        if (pix_dma_pack_len >= PIX_PACK_FRAME_MAX
+            || (pix_dma_pack_len && (pix_dma_rows || pix_dma_offset >= 0x10000)))
+        {
+            const size_t len = pix_pack_frame(pix_dma_pack, pix_dma_pack_len);
+            pix_send_request(PIX_DMA_WRITE, len, pix_dma_pack, nullptr);
+            pix_dma_pack_len -= len;
+            memmove(pix_dma_pack, &pix_dma_pack[len], pix_dma_pack_len);
+            return;
+        }
+        if (pix_dma_rows)
+        {
+            const uint i = __builtin_ctz(pix_dma_rows);
+            const uint16_t offset = pix_dma_offset - PIX_VCACHE_BLOCK_SIZE + i * PIX_VCACHE_ROW_SIZE;
+            if (pix_dma_dest != offset)
+            {
+                pix_send_request(PIX_DMA_WRITE, 3,
+                                 (uint8_t[]) {PIX_PACK_SEEK, offset >> 8, offset & 0xFF}, nullptr);
+                pix_dma_dest = offset;
+                return;
+            }
+            pix_dma_rows &= ~(1u << i);
+            pix_send_request(PIX_DMA_WRITE, PIX_VCACHE_ROW_SIZE,
+                             &pix_dma_block[i * PIX_VCACHE_ROW_SIZE], nullptr);
+            pix_dma_dest = offset + PIX_VCACHE_ROW_SIZE;
+            return;
+        }
+        if (pix_dma_offset >= 0x10000)
+        {
+            // End of transfer, the slot now mirrors pix_dma_bank
+            pix_send_request(PIX_DMA_WRITE, 1, (uint8_t[]) {0}, nullptr);
+            const uint8_t mask = 1u << pix_dma_slot;
+            if (pix_vcache_bank[pix_dma_slot] >= 0)
+                pix_vcache_slots[pix_vcache_bank[pix_dma_slot]] &= ~mask;
+            memset((void *)pix_vcache_dirty[pix_dma_slot], 0, sizeof(pix_vcache_dirty[0]));
+            pix_vcache_bank[pix_dma_slot] = pix_dma_bank;
+            pix_vcache_slots[pix_dma_bank] |= mask;
+            // Blocks marked until now have to be marked again
+            __dmb();
+            ++pix_vcache_gen;
+            pix_dma_active = false;
+            return;
+        }
+        // One block per call, it may leave nothing to send.
+        pix_dma_scan();
+        if (!pix_dma_rows && pix_dma_pack_len < PIX_PACK_FRAME_MAX && pix_dma_offset < 0x10000)
+            return;
+    }
+}
+
 void pix_send_request(pix_req_type_t msg_type,
                       uint8_t req_len5, const uint8_t *req_data,
                       pix_response_t *resp)
@@ -214,11 +375,9 @@ void pix_task(void)
     if (pio_sm_is_tx_fifo_empty(PIX_PIO, PIX_SM)
         && pix_in_flight == 0)
     {
-        if (pix_dma_blocks_remaining > 0)
+        if (pix_dma_active)
         {
-            pix_send_request(PIX_DMA_WRITE, 32, mem_fetch_row(pix_dma_bank, pix_dma_offset), nullptr);
-            pix_dma_offset += 32;
-            --pix_dma_blocks_remaining;
+            pix_dma_step();
         }
         else
         {
@@ -41,6 +41,26 @@ void pix_send_request(pix_req_type_t msg_type,
                       uint8_t req_len5, const uint8_t *req_data,
                       pix_response_t *resp);
 
+// Track writes to banks mirrored in VPU cache slots.
+// Call before the write reaches PSRAM.
+// The block marked last, by either core, is not marked again
+// until a slot refill moves pix_vcache_gen on.
+extern uint8_t pix_vcache_slots[256];
+extern volatile uint16_t pix_vcache_gen;
+extern volatile uint32_t pix_vcache_marked;
+void pix_vcache_mark(uint32_t addr24);
+__force_inline static void
+pix_vcache_touch(uint32_t addr24)
+{
+    if (!pix_vcache_slots[(addr24 >> 16) & 0xFF])
+        return;
+    const uint32_t key = (uint32_t)pix_vcache_gen << 16 | addr24 / PIX_VCACHE_BLOCK_SIZE;
+    if (key == pix_vcache_marked)
+        return;
+    pix_vcache_mark(addr24);
+    pix_vcache_marked = key;
+}
+
 // pass EVERY RAM write through CGIA for updating VRAM cache banks
 __force_inline static void
 pix_mem_write(uint32_t addr24, uint8_t data)
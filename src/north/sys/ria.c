@@ -12,6 +12,7 @@
 #include "hw.h"
 #include "main.h"
 #include "south/cgia/cgia.h"
+#include "sys/blt.h"
 #include "sys/cia.h"
 #include "sys/com.h"
 #include "sys/mem.h"
@@ -259,6 +260,12 @@ __attribute__((optimize("O1"))) static void __no_inline_not_in_flash_func(act_lo
                     else if (addr >= 0xFFD0)
                         switch (rw_addr_bus & (CPU_RWB_MASK | (CPU_IODEV_MASK << 8)))
                         {
+                        case CASE_WRIT(BLT_REG_CTRL): // Blitter control
+                            blt_start(data);
+                            break;
+                        case CASE_READ(BLT_REG_CTRL): // Blitter status
+                            data = blt_status();
+                            break;
                         default:
                         {
                             if (is_read)
@@ -573,6 +580,11 @@ __attribute__((optimize("O1"))) static void __no_inline_not_in_flash_func(act_lo
             }
 #endif
         }
+        else if (blt_active())
+        {
+            // bus is idle - move next block
+            blt_step();
+        }
     }
 }
 
@@ -29,6 +29,7 @@ void ria_stop();
 
 // Update IRQ state
 #define RIA_IRQ_SOURCE_CIA 0x01
+#define RIA_IRQ_SOURCE_BLT 0x02
 void ria_set_irq(uint8_t source);
 void ria_clear_irq(uint8_t source);
 
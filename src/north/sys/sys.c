@@ -12,6 +12,7 @@
 #include "net/ble.h"
 #include "net/ntp.h"
 #include "net/wfi.h"
+#include "sys/com.h"
 #include "sys/cpu.h"
 #include "sys/mem.h"
 #include "sys/ria.h"
@@ -96,6 +97,7 @@ void sys_mon_status(const char *args, size_t len)
     mon_add_response_fn(vpu_status_response);
     mon_add_response_fn(cpu_status_response);
     mon_add_response_fn(ram_status_response);
+    mon_add_response_fn(com_status_response);
     mon_add_response_fn(wfi_status_response);
     mon_add_response_fn(ntp_status_response);
     mon_add_response_fn(clk_status_response);
@@ -29,6 +29,7 @@ typedef enum
     PIX_DEV_CMD,
     PIX_DEV_WRITE,
     PIX_DEV_READ,
+    PIX_MEM_FILL,
 } pix_req_type_t;
 
 #define PIX_MESSAGE(req_type, req_len) \
@@ -40,6 +41,7 @@ typedef enum
     PIX_PONG,
     PIX_DMA_REQ,
     PIX_DEV_DATA,
+    PIX_PCM_REQ,
     PIX_NAK = 0xFF,
 } pix_rsp_code_t;
 
@@ -48,6 +50,39 @@ typedef enum
 #define PIX_REPLY_CODE(reply)    (((reply) >> 12) & 0x0F)
 #define PIX_REPLY_PAYLOAD(reply) ((reply) & 0x0FFF)
 
+/*
+ * RAM writes mirrored to the VPU
+ *
+ * PIX_MEM_WRITE frames carry bank, offset hi, lo and 1 to
+ * PIX_MEM_WRITE_MAX data bytes for consecutive offsets.
+ * PIX_MEM_FILL frames carry bank, offset hi, lo, length hi, lo
+ * (0 for 64 KB) and the fill value. Neither crosses the end of the bank.
+ */
+
+#define PIX_MEM_WRITE_MAX 29
+
+/*
+ * VRAM cache transfers
+ *
+ * PIX_DMA_REQ asks the RIA to fill a VPU cache slot with a PSRAM bank.
+ * With PIX_DMA_REQ_DELTA the slot still mirrors the bank it was last
+ * filled with, so the RIA sends only the rows that differ from it or
+ * were written since. PIX_DMA_WRITE frames then carry:
+ *   32 bytes    - next cache row
+ *    2-31 bytes - packed tokens, see pix_pack.h
+ *    1 byte     - end of transfer
+ */
+
+#define PIX_VCACHE_SLOTS      8
+#define PIX_VCACHE_ROW_SIZE   32
+#define PIX_VCACHE_BLOCK_SIZE 256
+
+#define PIX_DMA_REQ_DELTA 0x800
+#define PIX_DMA_REQ_PAYLOAD(bank, slot, delta) \
+    (uint16_t)(((bank) & 0xFF) | (((slot) & 0x7) << 8) | ((delta) ? PIX_DMA_REQ_DELTA : 0))
+#define PIX_DMA_REQ_BANK(payload) ((payload) & 0xFF)
+#define PIX_DMA_REQ_SLOT(payload) (((payload) >> 8) & 0x7)
+
 typedef enum pix_dev
 {
     PIX_DEV_RIA = 0,
@@ -72,6 +107,55 @@ typedef enum pix_vpu_cmd
 
 #define VPU_VERSION_MESSAGE_SIZE 20
 
+/*
+ * PCM RAM upload to the SGU-1
+ *
+ * PIX_SPU_CMD_PCM_WRITE frames carry the command, PCM RAM offset lo, hi
+ * and 1 to PIX_SPU_PCM_WRITE_MAX data bytes for consecutive offsets,
+ * wrapping at the end of PCM RAM.
+ */
+
+typedef enum pix_spu_cmd
+{
+    PIX_SPU_CMD_PCM_WRITE = 0,
+    PIX_SPU_CMD_REC,
+    PIX_SPU_CMD_REC_READ,
+    PIX_SPU_CMD_PLAY,
+} pix_spu_cmd_t;
+
+#define PIX_SPU_PCM_WRITE_MAX 29
+
+/*
+ * PCM streaming to the SGU-1
+ *
+ * A streaming channel plays a ring of PCM RAM. Once it is done with
+ * either half of the ring, PIX_PCM_REQ in place of an ACK asks the RIA
+ * to refill that half with PIX_SPU_CMD_PCM_WRITE frames.
+ */
+
+#define PIX_PCM_REQ_PAYLOAD(chan, half) (uint16_t)(((chan) & 0xF) | ((half) ? 0x10 : 0))
+#define PIX_PCM_REQ_CHAN(payload)       ((payload) & 0xF)
+#define PIX_PCM_REQ_HALF(payload)       (((payload) >> 4) & 1)
+
+/*
+ * SGU-1 register stream (see sgr.h)
+ *
+ * PIX_SPU_CMD_REC with 1 starts recording the register writes the VPU
+ * passes on, timed in SGU-1 samples, 0 stops it. PIX_SPU_CMD_REC_READ
+ * answers PIX_DEV_DATA with the next recorded byte and
+ * PIX_SPU_REC_BYTE, or without it when none is waiting and
+ * PIX_SPU_REC_LOST once the recording overflowed and stopped.
+ *
+ * PIX_SPU_CMD_PLAY frames carry the command, PCM RAM ring offset lo, hi
+ * and size lo, hi, the SGU-1 plays the commands from the ring. Its
+ * halves are refilled like a PCM stream's, PIX_PCM_REQ with
+ * PIX_SPU_PLAY_CHAN. Size 0 stops the player.
+ */
+
+#define PIX_SPU_REC_BYTE  0x100
+#define PIX_SPU_REC_LOST  0x200
+#define PIX_SPU_PLAY_CHAN 9
+
 typedef enum pix_misc_cmd
 {
     PIX_LED_CMD_SET_RGB888 = 0,
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pix_pack.h"
+#include <stdint.h>
+#include <string.h>
+
+#define PIX_PACK_FULL SIZE_MAX
+
+static inline uint8_t pix_pack_hash(const uint8_t *p)
+{
+    return (uint8_t)(((uint32_t)(p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >> 24);
+}
+
+static size_t pix_pack_literals(const uint8_t *src, size_t len,
+                                uint8_t *out, size_t o, size_t out_size)
+{
+    while (len)
+    {
+        const size_t n = len < PIX_PACK_LITERAL_MAX ? len : PIX_PACK_LITERAL_MAX;
+        if (o + 1 + n > out_size)
+            return PIX_PACK_FULL;
+        out[o++] = (uint8_t)(PIX_PACK_LITERAL | (n - 1));
+        memcpy(&out[o], src, n);
+        o += n;
+        src += n;
+        len -= n;
+    }
+    return o;
+}
+
+size_t pix_pack(const uint8_t *src, size_t len, uint8_t *out, size_t out_size)
+{
+    // Last position + 1 of each 3 byte hash, one candidate is plenty
+    // for tile maps and attributes.
+    uint16_t head[256];
+    memset(head, 0, sizeof(head));
+
+    size_t o = 0;
+    size_t lit = 0; // start of pending literals
+    size_t pos = 0;
+    while (pos < len)
+    {
+        const size_t max = len - pos < PIX_PACK_RUN_MAX ? len - pos : PIX_PACK_RUN_MAX;
+        size_t run = 1;
+        while (run < max && src[pos + run] == src[pos])
+            ++run;
+        size_t match = 0;
+        size_t from = 0;
+        if (max >= PIX_PACK_RUN_MIN)
+        {
+            const uint8_t h = pix_pack_hash(&src[pos]);
+            if (head[h])
+            {
+                from = head[h] - 1u;
+                while (match < max && src[from + match] == src[pos + match])
+                    ++match;
+            }
+            head[h] = (uint16_t)(pos + 1);
+        }
+
+        uint8_t token[2];
+        size_t n;
+        if (run >= PIX_PACK_RUN_MIN && run >= match)
+        {
+            n = run;
+            token[0] = (uint8_t)(PIX_PACK_FILL | (n - PIX_PACK_RUN_MIN));
+            token[1] = src[pos];
+        }
+        else if (match >= PIX_PACK_RUN_MIN)
+        {
+            n = match;
+            token[0] = (uint8_t)(PIX_PACK_COPY | (n - PIX_PACK_RUN_MIN));
+            token[1] = (uint8_t)(pos - from - 1);
+        }
+        else
+        {
+            ++pos;
+            continue;
+        }
+
+        o = pix_pack_literals(&src[lit], pos - lit, out, o, out_size);
+        if (o == PIX_PACK_FULL || o + 2 > out_size)
+            return 0;
+        out[o++] = token[0];
+        out[o++] = token[1];
+        for (size_t p = pos + 1; p < pos + n && p + PIX_PACK_RUN_MIN <= len; ++p)
+            head[pix_pack_hash(&src[p])] = (uint16_t)(p + 1);
+        pos += n;
+        lit = pos;
+    }
+    o = pix_pack_literals(&src[lit], len - lit, out, o, out_size);
+    return o == PIX_PACK_FULL ? 0 : o;
+}
+
+size_t pix_pack_frame(const uint8_t *buf, size_t len)
+{
+    size_t n = 0;
+    while (n < len)
+    {
+        const uint8_t c = buf[n];
+        const size_t t = c < PIX_PACK_SEEK ? c + 2u : c == PIX_PACK_SEEK ? 3 : 2;
+        if (n + t > PIX_PACK_FRAME_MAX)
+            break;
+        n += t;
+    }
+    return n;
+}
+
+uint8_t *pix_unpack(uint8_t *base, uint8_t *dest, const uint8_t *frame, size_t len)
+{
+    const uint8_t *const end = frame + len;
+    const uint8_t *const limit = base + 0x10000;
+    while (frame < end)
+    {
+        const uint8_t c = *frame++;
+        if (c < PIX_PACK_SEEK)
+        {
+            const size_t n = c + 1u;
+            if (n > (size_t)(end - frame) || n > (size_t)(limit - dest))
+                return NULL;
+            memcpy(dest, frame, n);
+            frame += n;
+            dest += n;
+        }
+        else if (c == PIX_PACK_SEEK)
+        {
+            if (end - frame < 2)
+                return NULL;
+            dest = base + (frame[0] << 8 | frame[1]);
+            frame += 2;
+        }
+        else if (c < PIX_PACK_FILL)
+            return NULL;
+        else
+        {
+            const size_t n = (c & 0x3Fu) + PIX_PACK_RUN_MIN;
+            if (frame == end || n > (size_t)(limit - dest))
+                return NULL;
+            const uint8_t arg = *frame++;
+            if (c < PIX_PACK_COPY)
+                memset(dest, arg, n);
+            else
+            {
+                const size_t dist = arg + 1u;
+                if (dist > (size_t)(dest - base))
+                    return NULL;
+                const uint8_t *src = dest - dist;
+                if (dist >= n)
+                    memcpy(dest, src, n);
+                else
+                    for (size_t i = 0; i < n; ++i)
+                        dest[i] = src[i];
+            }
+            dest += n;
+        }
+    }
+    return dest;
+}
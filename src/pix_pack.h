@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PIX_PACK_H_
+#define _PIX_PACK_H_
+
+/* Packed VRAM cache transfers.
+ *
+ * PIX_DMA_WRITE frames of 2 to PIX_PACK_FRAME_MAX bytes carry whole
+ * tokens, decoded into the cache slot at the current position:
+ *   0x00-0x3F  literal, the next n+1 bytes
+ *   0x40       seek, offset hi, lo follow
+ *   0x80-0xBF  fill, (c & 0x3F) + 3 bytes of the next byte
+ *   0xC0-0xFF  copy, (c & 0x3F) + 3 bytes from the next byte + 1 back,
+ *              overlapping the output when shorter than the length
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PIX_PACK_FRAME_MAX   31 // 32 byte frames are raw cache rows
+#define PIX_PACK_WINDOW      256
+#define PIX_PACK_LITERAL     0x00
+#define PIX_PACK_LITERAL_MAX (PIX_PACK_FRAME_MAX - 1)
+#define PIX_PACK_SEEK        0x40
+#define PIX_PACK_FILL        0x80
+#define PIX_PACK_COPY        0xC0
+#define PIX_PACK_RUN_MIN     3
+#define PIX_PACK_RUN_MAX     (0x3F + PIX_PACK_RUN_MIN)
+
+// Encode len bytes, at most PIX_PACK_WINDOW, copying only from within src.
+// Returns the token bytes, or 0 when they would not fit in out_size.
+size_t pix_pack(const uint8_t *src, size_t len, uint8_t *out, size_t out_size);
+
+// Bytes of whole tokens at the start of buf for the next frame.
+size_t pix_pack_frame(const uint8_t *buf, size_t len);
+
+// Decode a frame of tokens to dest, within the 64 KB slot at base.
+// Returns the new position, or NULL for a malformed frame.
+uint8_t *pix_unpack(uint8_t *base, uint8_t *dest, const uint8_t *frame, size_t len);
+
+#endif /* _PIX_PACK_H_ */
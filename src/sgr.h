@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SGR_H_
+#define _SGR_H_
+
+/* SGU-1 register stream
+ *
+ * Register writes timed in SGU-1 samples, recorded on the VPU and
+ * played back by the SGU-1 itself on the samples they were timed for.
+ * Files and PSRAM images start with an SGR_HEADER_SIZE header:
+ *   "SGR", SGR_VERSION, loop offset (32-bit, little endian) from the
+ *   first command, SGR_NO_LOOP when the stream plays once.
+ * Commands follow:
+ *   00RRRRRR DDDDDDDD          - write D to register R, 0x3F selects
+ *                                the channel as on the CPU bus
+ *   01NNNNNN                   - wait N+1 samples
+ *   10000000 LLLLLLLL HHHHHHHH - wait HL+1 samples
+ *   11111111                   - end of stream
+ * Other commands are reserved and end the stream too. Past its last
+ * command a looping stream goes on at the loop offset, one that plays
+ * once ends.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SGR_HEADER_SIZE 8
+#define SGR_VERSION     1
+#define SGR_NO_LOOP     0xFFFFFFFFu
+
+#define SGR_WAIT_SHORT     0x40
+#define SGR_WAIT_SHORT_MAX 64
+#define SGR_WAIT_LONG      0x80
+#define SGR_WAIT_LONG_MAX  0x10000
+#define SGR_END            0xFF
+
+#define SGR_SAMPLE_RATE 48000
+
+static inline void sgr_header(uint8_t *header, uint32_t loop)
+{
+    header[0] = 'S';
+    header[1] = 'G';
+    header[2] = 'R';
+    header[3] = SGR_VERSION;
+    for (int i = 0; i < 4; i++)
+        header[4 + i] = (uint8_t)(loop >> (8 * i));
+}
+
+// Returns false for anything but a version this code plays.
+static inline bool sgr_header_loop(const uint8_t *header, uint32_t *loop)
+{
+    if (header[0] != 'S' || header[1] != 'G' || header[2] != 'R'
+        || header[3] != SGR_VERSION)
+        return false;
+    *loop = (uint32_t)header[4] | (uint32_t)header[5] << 8
+            | (uint32_t)header[6] << 16 | (uint32_t)header[7] << 24;
+    return true;
+}
+
+#endif /* _SGR_H_ */
@@ -5,16 +5,23 @@
 #include "hardware/dma.h"
 #include "hardware/gpio.h"
 #include "hardware/interp.h"
+#include "hardware/sync.h"
 
 #include "cgia_encode.h"
 #define CGIA_PALETTE_IMPL
 #include "cgia_palette.h"
 #include "hw.h"
 #include "sys/out.h"
+#include "sys/pix.h"
+#include "sys/prf.h"
 
 #include <string.h>
+
+_Static_assert(CGIA_VRAM_SLOTS <= PIX_VCACHE_SLOTS, "Too many CGIA_VRAM_SLOTS");
 #endif
 
+_Static_assert(CGIA_VRAM_SLOTS >= CGIA_PLANES, "CGIA_VRAM_SLOTS must cover all planes");
+
 #define DISPLAY_WIDTH_PIXELS (MODE_H_ACTIVE_PIXELS / FB_H_REPEAT)
 #define MAX_BORDER_COLUMNS   (DISPLAY_WIDTH_PIXELS / CGIA_COLUMN_PX / 2 /* borders */)
 
@@ -24,14 +31,17 @@
 
 #define UNHANDLED_DL_COLOR (234)
 
+#define CGIA_CORES           (2)
+#define SCRATCH_LINE_PADDING (128) // maximum scroll of signed 8 bit
+
 #define CGIA_REGS_NO ((CGIA_PLANE_REGS_NO * CGIA_PLANES) << 1)
 _Static_assert(CGIA_REGS_NO == sizeof(struct cgia_t), "Incorrect CGIA_REGS_NO");
 
 // --- Globals ---
-// two "banks" to mirror PSRAM content for fast CGIA access
+// cache slots to mirror PSRAM banks for fast CGIA access
 uint8_t
     __attribute__((aligned(4)))
-    vram_cache[CGIA_VRAM_BANKS][0x10000];
+    vram_cache[CGIA_VRAM_SLOTS][0x10000];
 
 uint8_t
     __attribute__((aligned(4)))
@@ -51,77 +61,254 @@ struct cgia_plane_internal
     bool wait_vbl;
     bool sprites_need_update;
 };
+// Render state is kept per core. With OUT_DUAL_CORE both cores walk
+// every display list line, but only draw the lines they own.
 struct cgia_plane_internal
     __attribute__((aligned(4)))
     __scratch_x("cgia_data")
-        plane_int[CGIA_PLANES]
+        plane_int[CGIA_CORES][CGIA_PLANES]
     = {0};
 
+// Background plane registers as each core's display list walk left
+// them. CPU writes go to both copies, and only the core drawing line 0
+// publishes its copy to CGIA.plane[] for the CPU to read back.
+static union cgia_plane_regs_t
+    __attribute__((aligned(4)))
+    __scratch_x("cgia_data")
+        plane_regs_int[CGIA_CORES][CGIA_PLANES];
+static uint8_t cgia_publish_core;
+
+// Lines a sprite descriptor is shown on, following next_dsc_offset chains.
+struct cgia_sprite_span
+{
+    uint16_t dsc_offset;
+    uint16_t y_start;
+    uint16_t y_end; // exclusive
+    uint8_t index;  // sprite number, lower has priority
+};
+
+#define CGIA_SPRITE_SPANS (4 * CGIA_SPRITES)
+
+// Built at the start of frame, sorted by y_start, so each line
+// touches only the sprites that overlap it.
+struct cgia_sprite_list
+{
+    struct cgia_sprite_span spans[CGIA_SPRITE_SPANS];
+    uint8_t count;
+    uint8_t next;         // first span not started yet
+    uint8_t active_count; // spans covering current line
+    uint8_t active[CGIA_SPRITES];
+};
+static struct cgia_sprite_list sprite_lists[CGIA_CORES][CGIA_PLANES];
+static struct cgia_sprite_span sprite_spans_unsorted[CGIA_CORES][CGIA_SPRITE_SPANS];
+
+// Per frame sprite load, published in plane sprite registers
+static uint8_t sprite_peak[CGIA_PLANES];
+static uint8_t sprite_dropped[CGIA_PLANES];
+
+// Private copies of the display list / sprite table pointers.
+// CGIA.offset[] is only written when the CPU sets it, or by the
+// core that draws a line, so the CPU reads back the current position.
 static uint16_t
     __attribute__((aligned(4)))
     __scratch_x("cgia_data")
-        sprite_dsc_offsets[CGIA_PLANES][CGIA_SPRITES]
+        plane_offsets[CGIA_CORES][CGIA_PLANES]
     = {0};
 
-// store which PSRAM bank is currently mirrored in cache
-uint8_t
+// which cache slot mirrors a PSRAM bank, -1 if not resident
+int8_t
     __attribute__((aligned(4)))
     __scratch_x("cgia_data")
-        vram_cache_bank[CGIA_VRAM_BANKS]
-    = {0, 0};
+        vram_bank_slot[256];
 
-// store which memory bank is wanted in vram cache bank
-// used to trigger DMA transfer during cgia_run() workloop
+// which cache slot each plane reads from
 uint8_t
     __attribute__((aligned(4)))
     __scratch_x("cgia_data")
-        vram_wanted_bank[CGIA_VRAM_BANKS]
-    = {0, 0};
+        vram_plane_slot[CGIA_PLANES]
+    = {0};
+
+struct vram_slot_t
+{
+    int16_t bank;  // PSRAM bank the slot is assigned to, -1 if free
+    bool stale;    // waits for a transfer from PSRAM
+    bool coherent; // mirrors the bank it was last filled with, so the next
+                   // transfer into it only needs the rows that changed
+    uint32_t used; // last vram_clock tick a plane wanted it, for LRU eviction
+};
+static struct vram_slot_t vram_slots[CGIA_VRAM_SLOTS];
+static uint32_t vram_clock;
+
+// Display list walk cache. The walk of a frame is recorded per plane
+// and replayed on the following frames, so a static display list is not
+// decoded again on every line. Replay needs the frame to start in the
+// recorded state, and stops once the plane walk is invalidated.
+#ifndef CGIA_DL_CACHE
+#define CGIA_DL_CACHE (1)
+#endif
+#if CGIA_DL_CACHE
+#define CGIA_DL_CACHE_REGS (16) // lines loading plane registers per frame
+
+// Plane state at the last instruction fetch of a line,
+// so the line continues with the mode row, blank or wait instruction.
+struct cgia_dl_line
+{
+    uint16_t plane_offset;
+    uint16_t memory_scan;
+    uint16_t colour_scan;
+    uint16_t backgr_scan;
+    uint16_t char_gen_offset;
+    uint8_t row_line_count;
+    uint8_t regs; // 1 + index of plane registers loaded on this line, 0 if none
+    bool wait_vbl;
+};
+
+struct cgia_dl_cache
+{
+    enum
+    {
+        DL_CACHE_EMPTY,
+        DL_CACHE_RECORDING,
+        DL_CACHE_REPLAYING,
+    } state;
+    uint32_t gen; // dl_cache_gen[] the walk was recorded at
+    uint16_t lines_recorded;
+    uint8_t regs_count;
+    struct cgia_dl_line start; // plane state at the start of the frame
+    union cgia_plane_regs_t start_regs;
+    struct cgia_dl_line lines[DISPLAY_HEIGHT_LINES];
+    union cgia_plane_regs_t regs[CGIA_DL_CACHE_REGS];
+};
+
+// Cores walk the display lists separately only with OUT_DUAL_CORE.
+#define DL_CACHE_CORES (OUT_DUAL_CORE ? CGIA_CORES : 1)
+static struct cgia_dl_cache dl_caches[DL_CACHE_CORES][CGIA_PLANES];
+
+// Bumped by every write that may change the walk of a plane.
+static volatile uint32_t dl_cache_gen[CGIA_PLANES];
+
+// Display list bytes fetched from each cache slot.
+static struct
+{
+    uint16_t lo, hi;
+} dl_cache_range[CGIA_VRAM_SLOTS];
+
+static void cgia_dl_invalidate_slot(uint slot)
+{
+    for (uint p = 0; p < CGIA_PLANES; ++p)
+        if (vram_plane_slot[p] == slot)
+            ++dl_cache_gen[p];
+}
+#endif
 
 inline void __attribute__((always_inline)) __attribute__((optimize("O3")))
 cgia_ram_write(uint8_t bank, uint16_t addr, uint8_t data)
 {
-    // We use wanted_bank, not cache_bank because the switch may already be in progress
-    // and we want to update the bank we are switching to, not the one we are switching from
-    if (bank == vram_wanted_bank[0])
+    // A slot is assigned before its transfer starts, so writes landing
+    // during the transfer update the bank we are switching to.
+    const int8_t slot = vram_bank_slot[bank];
+    if (slot >= 0)
     {
-        vram_cache[0][addr] = data;
+        vram_cache[slot][addr] = data;
+#if CGIA_DL_CACHE
+        if (addr >= dl_cache_range[slot].lo && addr <= dl_cache_range[slot].hi)
+            cgia_dl_invalidate_slot(slot);
+#endif
     }
-    if (bank == vram_wanted_bank[1])
+}
+
+void cgia_ram_write_block(uint8_t bank, uint16_t addr, const uint8_t *data, uint32_t len)
+{
+    const int8_t slot = vram_bank_slot[bank];
+    if (slot >= 0 && addr + len <= 0x10000)
     {
-        vram_cache[1][addr] = data;
+        memcpy(&vram_cache[slot][addr], data, len);
+#if CGIA_DL_CACHE
+        if (addr <= dl_cache_range[slot].hi && addr + len > dl_cache_range[slot].lo)
+            cgia_dl_invalidate_slot(slot);
+#endif
     }
 }
 
-// store in which vram cache bank a cgia bank (backgnd/sprite) is stored
-// these may be shared - backgnd and sprites in same bank
-uint8_t *
-    __scratch_x("cgia_data")
-        vram_cache_ptr[CGIA_VRAM_BANKS]
-    = {vram_cache[0], vram_cache[0]};
+void cgia_ram_fill(uint8_t bank, uint16_t addr, uint8_t data, uint32_t len)
+{
+    const int8_t slot = vram_bank_slot[bank];
+    if (slot >= 0 && addr + len <= 0x10000)
+    {
+        memset(&vram_cache[slot][addr], data, len);
+#if CGIA_DL_CACHE
+        if (addr <= dl_cache_range[slot].hi && addr + len > dl_cache_range[slot].lo)
+            cgia_dl_invalidate_slot(slot);
+#endif
+    }
+}
 
-void cgia_set_bank(uint8_t cgia_bank_id, uint8_t mem_bank_no)
+// PSRAM bank a plane reads from
+static inline uint8_t cgia_plane_bank(uint p)
 {
-    assert(cgia_bank_id < 2);
-    vram_wanted_bank[cgia_bank_id] = mem_bank_no;
+    if (CGIA.plane_banks & (1u << p))
+        return CGIA.plane_bank[p];
+    return (CGIA.planes & (0x10u << p)) ? CGIA.sprite_bank : CGIA.bckgnd_bank;
+}
 
-    if (mem_bank_no == vram_cache_bank[cgia_bank_id])
+// Evict the least recently used slot not wanted by any plane.
+// Slots mapped in this update are stamped with vram_clock.
+static uint cgia_claim_slot(uint8_t bank)
+{
+    uint slot = CGIA_VRAM_SLOTS;
+    for (uint s = 0; s < CGIA_VRAM_SLOTS; ++s)
     {
-        // if the bank matches - nothing to do
-        return;
+        if (vram_slots[s].bank < 0)
+        {
+            slot = s;
+            break;
+        }
+        if (vram_slots[s].used == vram_clock)
+            continue;
+        if (slot == CGIA_VRAM_SLOTS || vram_slots[s].used < vram_slots[slot].used)
+            slot = s;
     }
-    // if the new bank_no matches the one in other bank, re-use it
-    const uint8_t other_bank_id = cgia_bank_id ^ 1;
-    if (mem_bank_no == vram_cache_bank[other_bank_id])
+
+    struct vram_slot_t *vs = &vram_slots[slot];
+    if (vs->bank >= 0)
+        vram_bank_slot[vs->bank] = -1;
+    if (vs->stale) // writes of two banks got mixed
+        vs->coherent = false;
+    vs->bank = bank;
+    vs->stale = true;
+    vram_bank_slot[bank] = (int8_t)slot;
+#if CGIA_DL_CACHE
+    dl_cache_range[slot].lo = 0xFFFF;
+    dl_cache_range[slot].hi = 0;
+#endif
+    return slot;
+}
+
+// Map plane banks to cache slots, claiming slots for missing banks.
+// Transfers are scheduled in cgia_task().
+static void cgia_update_banks(void)
+{
+    uint8_t banks[CGIA_PLANES];
+    ++vram_clock;
+    // mark resident banks first, so they are not evicted
+    for (uint p = 0; p < CGIA_PLANES; ++p)
     {
-        vram_cache_bank[cgia_bank_id] = mem_bank_no;
-        vram_cache_ptr[cgia_bank_id] = vram_cache_ptr[other_bank_id];
-        return;
+        banks[p] = cgia_plane_bank(p);
+        const int8_t slot = vram_bank_slot[banks[p]];
+        if (slot >= 0)
+            vram_slots[slot].used = vram_clock;
+    }
+    for (uint p = 0; p < CGIA_PLANES; ++p)
+    {
+        int slot = vram_bank_slot[banks[p]];
+        if (slot < 0)
+            slot = cgia_claim_slot(banks[p]);
+        vram_slots[slot].used = vram_clock;
+        vram_plane_slot[p] = (uint8_t)slot;
+#if CGIA_DL_CACHE
+        ++dl_cache_gen[p];
+#endif
     }
-
-    // if we got here, the vram_wanted_bank differs from vram_cache_bank
-    // which will trigger memory bank switch in work loop
-    // our job here is done
 }
 
 // This mask is used to enable interruptable render points in time.
@@ -166,10 +353,13 @@ inline __attribute__((always_inline)) __attribute__((optimize("O2"))) void cgia_
     switch (reg)
     {
     case CGIA_REG_BCKGND_BANK:
-        cgia_set_bank(0, value);
-        break;
     case CGIA_REG_SPRITE_BANK:
-        cgia_set_bank(1, value);
+    case CGIA_REG_PLANE_BANKS:
+    case CGIA_REG_PLANE_BANK + 0:
+    case CGIA_REG_PLANE_BANK + 1:
+    case CGIA_REG_PLANE_BANK + 2:
+    case CGIA_REG_PLANE_BANK + 3:
+        cgia_update_banks();
         break;
     case CGIA_REG_INT_ENABLE:
         regs_int[reg] = value & 0b11100000;
@@ -180,23 +370,47 @@ inline __attribute__((always_inline)) __attribute__((optimize("O2"))) void cgia_
         int_mask = 0x00;
         break;
 
-    case CGIA_REG_PLANES + CGIA_PLANE_REGS_NO * 0: // .plane[0].sprite.active ?
-        if (CGIA.planes & (0x10 << 0))
-            plane_int[0].sprites_need_update = true;
-        break;
-    case CGIA_REG_PLANES + CGIA_PLANE_REGS_NO * 1: // .plane[1].sprite.active ?
-        if (CGIA.planes & (0x10 << 1))
-            plane_int[1].sprites_need_update = true;
-        break;
-    case CGIA_REG_PLANES + CGIA_PLANE_REGS_NO * 2: // .plane[2].sprite.active ?
-        if (CGIA.planes & (0x10 << 2))
-            plane_int[2].sprites_need_update = true;
-        break;
-    case CGIA_REG_PLANES + CGIA_PLANE_REGS_NO * 3: // .plane[3].sprite.active ?
-        if (CGIA.planes & (0x10 << 3))
-            plane_int[3].sprites_need_update = true;
+    case CGIA_REG_OFFSET + 0:
+    case CGIA_REG_OFFSET + 1:
+    case CGIA_REG_OFFSET + 2:
+    case CGIA_REG_OFFSET + 3:
+    case CGIA_REG_OFFSET + 4:
+    case CGIA_REG_OFFSET + 5:
+    case CGIA_REG_OFFSET + 6:
+    case CGIA_REG_OFFSET + 7:
+    {
+        const uint p = (reg - CGIA_REG_OFFSET) >> 1;
+        plane_offsets[0][p] = plane_offsets[1][p] = CGIA.offset[p];
+#if CGIA_DL_CACHE
+        ++dl_cache_gen[p];
+#endif
+    }
+    break;
+
+    case CGIA_REG_PLANES:
+        // plane type selects bckgnd or sprite bank
+        cgia_update_banks();
+        for (uint p = 0; p < CGIA_PLANES; ++p)
+            plane_int[0][p].sprites_need_update = plane_int[1][p].sprites_need_update = true;
         break;
     }
+
+    if (reg >= CGIA_REG_PLANE)
+    {
+        const uint p = (reg - CGIA_REG_PLANE) / CGIA_PLANE_REGS_NO;
+        const uint r = (reg - CGIA_REG_PLANE) % CGIA_PLANE_REGS_NO;
+        plane_regs_int[0][p].reg[r] = plane_regs_int[1][p].reg[r] = value;
+#if CGIA_DL_CACHE
+        ++dl_cache_gen[p];
+#endif
+        if ((CGIA.planes & (0x10u << p))
+            && (r == offsetof(struct cgia_sprite_regs, active)
+                || (r >= offsetof(struct cgia_sprite_regs, active_ext)
+                    && r < offsetof(struct cgia_sprite_regs, active_ext) + 3)))
+        {
+            plane_int[0][p].sprites_need_update = plane_int[1][p].sprites_need_update = true;
+        }
+    }
 }
 
 static inline __attribute__((always_inline)) void cpu_set_nmi(void)
@@ -216,33 +430,54 @@ struct dma_control_block
 static int ctrl_chan;
 static int data_chan;
 
-// DMA channel to fill raster line with background color
-static int back_chan;
+// DMA channels to fill raster line with background color, one per core
+static int back_chans[CGIA_CORES];
 
 // CGIA VRAM CACHE bank sync
 static int vcache_transfer; // records which bank is being transferred
-uint8_t vcache_dma_bank = 0;
-uint16_t vcache_dma_blocks_remaining = 0;
+volatile uint8_t vcache_dma_state = VCACHE_DMA_IDLE;
+uint16_t vcache_dma_request = 0;
+uint8_t *vcache_dma_base = 0;
 uint8_t *vcache_dma_dest = 0;
 
 void cgia_reset(void)
 {
     memset(&CGIA, 0, CGIA_REGS_NO);
     memset(plane_int, 0, sizeof(plane_int));
-    memset(sprite_dsc_offsets, 0, sizeof(sprite_dsc_offsets));
+    memset(plane_regs_int, 0, sizeof(plane_regs_int));
+    memset(sprite_lists, 0, sizeof(sprite_lists));
+    memset(plane_offsets, 0, sizeof(plane_offsets));
 
-    for (uint i = 0; i < CGIA_PLANES; ++i)
+    for (uint c = 0; c < CGIA_CORES; ++c)
     {
-        // All planes should initially wait for VBL
-        plane_int[i].wait_vbl = true;
-        // And update sprite descriptors
-        plane_int[i].sprites_need_update = true;
+        for (uint i = 0; i < CGIA_PLANES; ++i)
+        {
+            // All planes should initially wait for VBL
+            plane_int[c][i].wait_vbl = true;
+            // And update sprite descriptors
+            plane_int[c][i].sprites_need_update = true;
+        }
     }
     vcache_transfer = -1;
-    vram_wanted_bank[0] = CGIA.bckgnd_bank = 0;
-    vram_wanted_bank[1] = CGIA.sprite_bank = 0;
-    vram_cache_bank[0] = 0xFF; // Force initial transfer of bank
-    vram_cache_bank[1] = 0;
+    vcache_dma_state = VCACHE_DMA_IDLE;
+    // Force initial transfer of bank
+    memset(vram_bank_slot, -1, sizeof(vram_bank_slot));
+    for (uint s = 0; s < CGIA_VRAM_SLOTS; ++s)
+    {
+        vram_slots[s].bank = -1;
+        vram_slots[s].stale = false;
+        vram_slots[s].coherent = false;
+        vram_slots[s].used = 0;
+    }
+#if CGIA_DL_CACHE
+    memset(dl_caches, 0, sizeof(dl_caches));
+    for (uint s = 0; s < CGIA_VRAM_SLOTS; ++s)
+    {
+        dl_cache_range[s].lo = 0xFFFF;
+        dl_cache_range[s].hi = 0;
+    }
+#endif
+    cgia_update_banks();
 }
 
 void cgia_init(void)
@@ -284,19 +519,22 @@ void cgia_init(void)
         false // Don't start yet.
     );
 
-    back_chan = dma_claim_unused_channel(true);
-    c = dma_channel_get_default_config(back_chan);
-    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
-    channel_config_set_read_increment(&c, false);
-    channel_config_set_write_increment(&c, true);
-
-    dma_channel_configure(
-        back_chan,
-        &c,
-        NULL,
-        NULL,
-        DISPLAY_WIDTH_PIXELS,
-        false);
+    for (uint core = 0; core < CGIA_CORES; ++core)
+    {
+        back_chans[core] = dma_claim_unused_channel(true);
+        c = dma_channel_get_default_config(back_chans[core]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+
+        dma_channel_configure(
+            back_chans[core],
+            &c,
+            NULL,
+            NULL,
+            DISPLAY_WIDTH_PIXELS,
+            false);
+    }
 #endif
 
     cgia_reset();
@@ -360,6 +598,7 @@ static inline __attribute__((always_inline)) uint32_t *fill_back(
     uint32_t columns,
     uint32_t color_idx)
 {
+    const int back_chan = back_chans[get_core_num()];
     dma_channel_wait_for_finish_blocking(back_chan);
     dma_channel_set_read_addr(back_chan, &cgia_rgb_palette[color_idx], false);
     dma_channel_set_write_addr(back_chan, buf, false);
@@ -416,37 +655,260 @@ static inline __attribute__((always_inline)) void set_mode7_interp_config(union
     interp_config_set_shift(&cfg, 0);
     interp_config_set_mask(&cfg, CGIA_AFFINE_FRACTIONAL_BITS, CGIA_AFFINE_FRACTIONAL_BITS + texture_height_bits - 1);
     interp_set_config(interp1, 1, &cfg);
-    interp1->accum[0] = plane->affine.u;
-    interp1->base[0] = plane->affine.dx;
-    interp1->accum[1] = plane->affine.v;
-    interp1->base[1] = plane->affine.dy;
-    interp1->base[2] = 0;
+    interp_set_accumulator(interp1, 0, plane->affine.u);
+    interp_set_base(interp1, 0, plane->affine.dx);
+    interp_set_accumulator(interp1, 1, plane->affine.v);
+    interp_set_base(interp1, 1, plane->affine.dy);
+    interp_set_base(interp1, 2, 0);
+}
+// Little endian word wrapping at the end of the bank
+static inline __attribute__((always_inline)) int16_t bank_word(const uint8_t *bank, uint16_t offset)
+{
+    return (int16_t)(bank[offset] | bank[(uint16_t)(offset + 1)] << 8);
 }
+
 static inline __attribute__((always_inline)) void set_mode7_scans(union cgia_plane_regs_t *plane, const uint8_t *memory_scan)
 {
-    interp0->base[2] = (uintptr_t)memory_scan;
-    const uint32_t xy = interp1->pop[2];
-    interp0->accum[0] = (xy & 0x00FF) << CGIA_AFFINE_FRACTIONAL_BITS;
-    interp0->base[0] = plane->affine.du;
-    interp0->accum[1] = (xy & 0xFF00);
-    interp0->base[1] = plane->affine.dv;
+    interp_set_base(interp0, 2, (uintptr_t)memory_scan);
+    const uint32_t xy = interp_pop_full_result(interp1);
+    interp_set_accumulator(interp0, 0, (xy & 0x00FF) << CGIA_AFFINE_FRACTIONAL_BITS);
+    interp_set_base(interp0, 0, plane->affine.du);
+    interp_set_accumulator(interp0, 1, (xy & 0xFF00));
+    interp_set_base(interp0, 1, plane->affine.dv);
 }
 #endif
 
-void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
+static inline uint32_t sprite_active_mask(const union cgia_plane_regs_t *plane)
+{
+    return plane->sprite.active
+           | plane->sprite.active_ext[0] << 8
+           | plane->sprite.active_ext[1] << 16
+           | (uint32_t)plane->sprite.active_ext[2] << 24;
+}
+
+// Follow every active sprite's descriptor chain from line y to the end
+// of frame and bucket the spans by their first line.
+static void cgia_build_sprite_list(struct cgia_sprite_list *list,
+                                   struct cgia_sprite_span *spans,
+                                   const union cgia_plane_regs_t *plane,
+                                   const uint8_t *sprite_bank,
+                                   uint16_t table_offset, uint16_t y)
+{
+    uint count = 0;
+    const uint32_t active = sprite_active_mask(plane);
+    for (uint index = 0; index < CGIA_SPRITES; ++index)
+    {
+        if (!(active & (1u << index)))
+            continue;
+        uint16_t dsc_offset = table_offset + index * sizeof(struct cgia_sprite_t);
+        int from = y;
+        // every span ends past its start, so chains end within a frame
+        while (from < DISPLAY_HEIGHT_LINES && count < CGIA_SPRITE_SPANS)
+        {
+            const struct cgia_sprite_t *sprite = (const struct cgia_sprite_t *)(sprite_bank + dsc_offset);
+            const int start = sprite->pos_y > from ? sprite->pos_y : from;
+            const int end = sprite->pos_y + sprite->lines_y;
+            if (start >= DISPLAY_HEIGHT_LINES)
+                break; // parked below the screen
+            if (end <= start)
+                break; // never ends, so next descriptor is not loaded
+            spans[count].dsc_offset = dsc_offset;
+            spans[count].y_start = (uint16_t)start;
+            spans[count].y_end = (uint16_t)(end < DISPLAY_HEIGHT_LINES ? end : DISPLAY_HEIGHT_LINES);
+            spans[count].index = (uint8_t)index;
+            ++count;
+            from = end;
+            dsc_offset = sprite->next_dsc_offset;
+        }
+    }
+
+    uint8_t bucket[DISPLAY_HEIGHT_LINES + 1] = {0};
+    for (uint i = 0; i < count; ++i)
+        ++bucket[spans[i].y_start + 1];
+    for (uint l = 1; l <= DISPLAY_HEIGHT_LINES; ++l)
+        bucket[l] += bucket[l - 1];
+    for (uint i = 0; i < count; ++i)
+        list->spans[bucket[spans[i].y_start]++] = spans[i];
+
+    list->count = (uint8_t)count;
+    list->next = 0;
+    list->active_count = 0;
+}
+
+// Drop spans that ended, add the ones starting on line y.
+static inline void cgia_step_sprite_list(struct cgia_sprite_list *list, uint16_t y)
 {
-    static union cgia_plane_regs_t *plane;
-    static uint16_t *plane_offset;
-    static struct cgia_plane_internal *plane_data;
-    static uint16_t (*sprite_dscs)[CGIA_SPRITES];
-    static uint8_t max_instr_count;
-    static uint16_t plane_order;
-    static uint p;
-
-    CGIA.raster = y;
-    int_mask |= CGIA_REG_INT_FLAG_RSI;
+    uint n = 0;
+    for (uint i = 0; i < list->active_count; ++i)
+        if (list->spans[list->active[i]].y_end > y)
+            list->active[n++] = list->active[i];
+    while (list->next < list->count && list->spans[list->next].y_start <= y)
+    {
+        // keep active spans ordered by sprite index
+        const uint8_t index = list->spans[list->next].index;
+        uint i = n++;
+        for (; i > 0 && list->spans[list->active[i - 1]].index > index; --i)
+            list->active[i] = list->active[i - 1];
+        list->active[i] = list->next++;
+    }
+    list->active_count = (uint8_t)n;
+}
+
+// Scratch line for lines that are walked but not drawn. Only the
+// encoders that leave scan pointers in the interpolators write here.
+static uint32_t
+    __attribute__((aligned(4)))
+        scratch_line[CGIA_CORES][DISPLAY_WIDTH_PIXELS + 2 * SCRATCH_LINE_PADDING];
+
+#if CGIA_DL_CACHE
+static inline void cgia_dl_save(struct cgia_dl_line *line,
+                                const struct cgia_plane_internal *plane_data,
+                                uint16_t plane_offset)
+{
+    line->plane_offset = plane_offset;
+    line->memory_scan = plane_data->memory_scan;
+    line->colour_scan = plane_data->colour_scan;
+    line->backgr_scan = plane_data->backgr_scan;
+    line->char_gen_offset = plane_data->char_gen_offset;
+    line->row_line_count = plane_data->row_line_count;
+    line->wait_vbl = plane_data->wait_vbl;
+}
+
+// Record the plane state at an instruction fetch of line y.
+// The last fetch of a line overwrites the previous ones.
+static void cgia_dl_record(struct cgia_dl_cache *dl_cache, uint p, uint16_t y,
+                           const union cgia_plane_regs_t *plane,
+                           const struct cgia_plane_internal *plane_data,
+                           uint16_t plane_offset, bool regs_loaded)
+{
+    struct cgia_dl_line *line = &dl_cache->lines[y];
+    if (y == dl_cache->lines_recorded)
+    {
+        ++dl_cache->lines_recorded;
+        line->regs = 0;
+    }
+    else if (y + 1 != dl_cache->lines_recorded)
+    {
+        dl_cache->state = DL_CACHE_EMPTY; // a line was skipped
+        return;
+    }
+    if (regs_loaded && !line->regs)
+    {
+        if (dl_cache->regs_count == CGIA_DL_CACHE_REGS)
+        {
+            dl_cache->state = DL_CACHE_EMPTY;
+            return;
+        }
+        line->regs = ++dl_cache->regs_count;
+    }
+    cgia_dl_save(line, plane_data, plane_offset);
+    if (line->regs)
+        dl_cache->regs[line->regs - 1] = *plane;
+
+    // instruction and its longest operands
+    const uint slot = vram_plane_slot[p];
+    const uint16_t lo = plane_offset > 0xFFFF - 8 ? 0 : plane_offset;
+    const uint16_t hi = plane_offset > 0xFFFF - 8 ? 0xFFFF : plane_offset + 8;
+    if (lo < dl_cache_range[slot].lo)
+        dl_cache_range[slot].lo = lo;
+    if (hi > dl_cache_range[slot].hi)
+        dl_cache_range[slot].hi = hi;
+}
+
+// Restore the recorded plane state of line y. Returns false when
+// the line has to be decoded, starting a new recording on frame start.
+static bool cgia_dl_replay(struct cgia_dl_cache *dl_cache, uint p, uint16_t y,
+                           union cgia_plane_regs_t *plane,
+                           union cgia_plane_regs_t *plane_state,
+                           struct cgia_plane_internal *plane_data,
+                           uint16_t *plane_offset)
+{
+    const uint32_t gen = dl_cache_gen[p];
     if (y == 0)
-        int_mask |= CGIA_REG_INT_FLAG_VBI;
+    {
+        const struct cgia_dl_line *start = &dl_cache->start;
+        const bool recorded = dl_cache->gen == gen
+                              && (dl_cache->state == DL_CACHE_REPLAYING
+                                  || (dl_cache->state == DL_CACHE_RECORDING
+                                      && dl_cache->lines_recorded == DISPLAY_HEIGHT_LINES));
+        if (recorded
+            && *plane_offset == start->plane_offset
+            && plane_data->memory_scan == start->memory_scan
+            && plane_data->colour_scan == start->colour_scan
+            && plane_data->backgr_scan == start->backgr_scan
+            && plane_data->char_gen_offset == start->char_gen_offset
+            && !memcmp(plane, &dl_cache->start_regs, sizeof(*plane)))
+        {
+            dl_cache->state = DL_CACHE_REPLAYING;
+        }
+        else
+        {
+            dl_cache->state = DL_CACHE_RECORDING;
+            dl_cache->gen = gen;
+            dl_cache->lines_recorded = 0;
+            dl_cache->regs_count = 0;
+            cgia_dl_save(&dl_cache->start, plane_data, *plane_offset);
+            dl_cache->start_regs = *plane;
+            return false;
+        }
+    }
+    if (dl_cache->state != DL_CACHE_REPLAYING)
+        return false;
+    if (dl_cache->gen != gen)
+    {
+        // the decoded walk continues from the replayed state
+        dl_cache->state = DL_CACHE_EMPTY;
+        return false;
+    }
+
+    const struct cgia_dl_line *line = &dl_cache->lines[y];
+    *plane_offset = line->plane_offset;
+    plane_data->memory_scan = line->memory_scan;
+    plane_data->colour_scan = line->colour_scan;
+    plane_data->backgr_scan = line->backgr_scan;
+    plane_data->char_gen_offset = line->char_gen_offset;
+    plane_data->row_line_count = line->row_line_count;
+    plane_data->wait_vbl = line->wait_vbl;
+    if (line->regs)
+        *plane_state = *plane = dl_cache->regs[line->regs - 1];
+    return true;
+}
+#endif
+
+void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
+{
+    const uint core = get_core_num();
+    const bool draw = rgbbuf != NULL;
+    if (!draw)
+        rgbbuf = scratch_line[core] + SCRATCH_LINE_PADDING;
+    const int back_chan = back_chans[core];
+
+    union cgia_plane_regs_t plane_regs;
+    union cgia_plane_regs_t *plane = &plane_regs;
+    union cgia_plane_regs_t *plane_state;
+    uint16_t *plane_offset;
+    struct cgia_plane_internal *plane_data;
+    struct cgia_sprite_list *sprite_list;
+    uint8_t max_instr_count;
+#if CGIA_DL_CACHE
+    struct cgia_dl_cache *dl_cache = NULL;
+#endif
+    bool dl_regs_loaded;
+    uint16_t plane_order;
+    uint p;
+
+    if (draw)
+    {
+        CGIA.raster = y;
+        int_mask |= CGIA_REG_INT_FLAG_RSI;
+        if (y == 0)
+        {
+            cgia_publish_core = (uint8_t)core;
+            int_mask |= CGIA_REG_INT_FLAG_VBI;
+            CGIA.load = prf_frame_load();
+            CGIA.late = prf_frame_late();
+        }
+    }
 
     // track whether we need to fill line with background color
     // for transparent or sprite planes
@@ -476,53 +938,45 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
                 line_background_filled = true;
             }
 
-            plane = &CGIA.plane[p];
-            plane_offset = &CGIA.offset[p];
-            plane_data = &plane_int[p];
-            sprite_dscs = &sprite_dsc_offsets[p];
-            uint8_t *sprite_bank = vram_cache_ptr[1];
+            plane_regs = CGIA.plane[p];
+            plane_offset = &plane_offsets[core][p];
+            plane_data = &plane_int[core][p];
+            sprite_list = &sprite_lists[core][p];
+            const uint8_t sprite_slot = vram_plane_slot[p];
+            uint8_t *sprite_bank = vram_cache[sprite_slot];
 
-            if (vram_cache_bank[1] != vram_wanted_bank[1])
+            if (vram_slots[sprite_slot].stale)
             {
                 continue; // skip if the sprite bank is not synced yet
             }
 
-            if (y == 0 // start of frame - reload descriptors
+            if (y == 0 // start of frame - rebuild sprite list
                 || plane_data->sprites_need_update)
             {
-                uint16_t offs = *plane_offset;
-                (*sprite_dscs)[0] = offs;
-                offs += 16;
-                (*sprite_dscs)[1] = offs;
-                offs += 16;
-                (*sprite_dscs)[2] = offs;
-                offs += 16;
-                (*sprite_dscs)[3] = offs;
-                offs += 16;
-                (*sprite_dscs)[4] = offs;
-                offs += 16;
-                (*sprite_dscs)[5] = offs;
-                offs += 16;
-                (*sprite_dscs)[6] = offs;
-                offs += 16;
-                (*sprite_dscs)[7] = offs;
-
+                if (y == 0 && draw)
+                {
+                    plane->sprite.peak = CGIA.plane[p].sprite.peak = sprite_peak[p];
+                    plane->sprite.dropped = CGIA.plane[p].sprite.dropped = sprite_dropped[p];
+                    sprite_peak[p] = sprite_dropped[p] = 0;
+                }
+                cgia_build_sprite_list(sprite_list, sprite_spans_unsorted[core],
+                                       plane, sprite_bank, *plane_offset, y);
                 plane_data->sprites_need_update = false;
             }
+            cgia_step_sprite_list(sprite_list, y);
 
-            // render sprites in reverse order
-            // so lower indexed sprites have higher visual priority
-            uint8_t sprite_index = 7;
-            uint8_t mask = 0b10000000;
-
-            // wait until back fill is done, as it may overwrite sprites on the right side
-            dma_channel_wait_for_finish_blocking(back_chan);
-
-            while (mask)
+            if (draw && sprite_list->active_count)
             {
-                if (plane->sprite.active & mask)
+                // lower indexed sprites have higher visual priority,
+                // the ones past the line pixel budget are dropped
+                struct cgia_sprite_t *sprites[CGIA_SPRITES];
+                int sprite_lines[CGIA_SPRITES];
+                uint visible = 0;
+                uint pixels = 0;
+                bool over_budget = false;
+                for (uint i = 0; i < sprite_list->active_count; ++i)
                 {
-                    struct cgia_sprite_t *sprite = (struct cgia_sprite_t *)(sprite_bank + (*sprite_dscs)[sprite_index]);
+                    struct cgia_sprite_t *sprite = (struct cgia_sprite_t *)(sprite_bank + sprite_list->spans[sprite_list->active[i]].dsc_offset);
 
                     int sprite_line = (sprite->flags & SPRITE_MASK_MIRROR_Y)
                                           ? sprite->pos_y + sprite->lines_y - 1 - y
@@ -531,33 +985,50 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
                         && sprite_line < sprite->lines_y
                         && (!plane->sprite.stop_y || sprite_line <= plane->sprite.stop_y))
                     {
-                        const uint8_t sprite_width = sprite->flags & SPRITE_MASK_WIDTH;
-                        const uint sprite_offset = sprite_line * (sprite_width + 1);
-
-                        uint8_t *src = sprite_bank + sprite->data_offset;
-                        if (sprite->flags & SPRITE_MASK_MIRROR_X)
+                        const uint width = ((sprite->flags & SPRITE_MASK_WIDTH) + 1) * CGIA_COLUMN_PX
+                                           << ((sprite->flags & SPRITE_MASK_DOUBLE_WIDTH) ? 1 : 0);
+                        if (pixels + width > CGIA_SPRITE_LINE_PIXELS)
                         {
-                            src += sprite_offset + sprite_width;
-                            // TODO: inc/dec inside renderer
-                            cgia_encode_sprite_mirror(rgbbuf, (uint32_t *)sprite,
-                                                      src, sprite_width);
-                        }
-                        else
-                        {
-                            src += sprite_offset;
-                            cgia_encode_sprite(rgbbuf, (uint32_t *)sprite,
-                                               src, sprite_width);
+                            over_budget = true;
+                            continue;
                         }
+                        pixels += width;
+                        sprites[visible] = sprite;
+                        sprite_lines[visible++] = sprite_line;
+                    }
+                }
+                if (visible > sprite_peak[p])
+                    sprite_peak[p] = visible;
+                if (over_budget && sprite_dropped[p] < UINT8_MAX)
+                    ++sprite_dropped[p];
 
-                        // if this was the last line of sprite, load the next offset
-                        if (sprite->pos_y + sprite->lines_y == (int)y + 1)
-                        {
-                            (*sprite_dscs)[sprite_index] = sprite->next_dsc_offset;
-                        }
+                // wait until back fill is done, as it may overwrite sprites on the right side
+                dma_channel_wait_for_finish_blocking(back_chan);
+
+                // render sprites in reverse order
+                const uint32_t enc_start = prf_time();
+                while (visible--)
+                {
+                    struct cgia_sprite_t *sprite = sprites[visible];
+                    const uint8_t sprite_width = sprite->flags & SPRITE_MASK_WIDTH;
+                    const uint sprite_offset = sprite_lines[visible] * (sprite_width + 1);
+
+                    uint8_t *src = sprite_bank + sprite->data_offset;
+                    if (sprite->flags & SPRITE_MASK_MIRROR_X)
+                    {
+                        src += sprite_offset + sprite_width;
+                        // TODO: inc/dec inside renderer
+                        cgia_encode_sprite_mirror(rgbbuf, (uint32_t *)sprite,
+                                                  src, sprite_width);
+                    }
+                    else
+                    {
+                        src += sprite_offset;
+                        cgia_encode_sprite(rgbbuf, (uint32_t *)sprite,
+                                           src, sprite_width);
                     }
                 }
-                --sprite_index;
-                mask >>= 1;
+                prf_enc(core, PRF_ENC_SPRITE, enc_start);
             }
             // borders
             uint8_t border_columns = plane->sprite.border_columns;
@@ -574,10 +1045,19 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
         else
         {
             /* --- BACKGROUND --- */
-            plane = &CGIA.plane[p];
-            plane_offset = &CGIA.offset[p];
-            plane_data = &plane_int[p];
+            plane_state = &plane_regs_int[core][p];
+            plane_regs = *plane_state;
+            plane_offset = &plane_offsets[core][p];
+            plane_data = &plane_int[core][p];
             max_instr_count = CGIA_MAX_DL_INSTR_PER_LINE;
+            dl_regs_loaded = false;
+
+#if CGIA_DL_CACHE
+            dl_cache = &dl_caches[OUT_DUAL_CORE ? core : 0][p];
+            if ((CGIA.planes & (1u << p))
+                && cgia_dl_replay(dl_cache, p, y, plane, plane_state, plane_data, plane_offset))
+                goto process_instruction;
+#endif
 
         restart_plane:
             if (y == 0) // start of frame - reset flags and counters
@@ -590,6 +1070,10 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
                 continue; // next if not enabled
 
         process_instruction:
+#if CGIA_DL_CACHE
+            if (dl_cache->state == DL_CACHE_RECORDING)
+                cgia_dl_record(dl_cache, p, y, plane, plane_data, *plane_offset, dl_regs_loaded);
+#endif
             if (plane_data->wait_vbl) // DL is stopped and waiting for VBL
             {
                 // if the plane border is not transparent, it should become
@@ -604,13 +1088,17 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
                 continue; // and we're done
             }
 
-            const uint8_t *bckgnd_bank = vram_cache_ptr[0];
+            const uint8_t *bckgnd_bank = vram_cache[vram_plane_slot[p]];
             const uint8_t dl_instr = bckgnd_bank[*plane_offset];
             const uint8_t instr_code = dl_instr & 0b00001111;
-            int_mask |= CGIA_REG_INT_FLAG_DLI;
+            if (draw)
+                int_mask |= CGIA_REG_INT_FLAG_DLI;
 
-            if (vram_cache_bank[0] != vram_wanted_bank[0])
+            if (vram_slots[vram_plane_slot[p]].stale)
             {
+#if CGIA_DL_CACHE
+                dl_cache->state = DL_CACHE_EMPTY;
+#endif
                 continue; // skip if the bg bank is not synced yet
             }
 
@@ -620,6 +1108,10 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
 
             if (0 == max_instr_count--)
             {
+#if CGIA_DL_CACHE
+                // replay would resume with a fresh instruction budget
+                dl_cache->state = DL_CACHE_EMPTY;
+#endif
                 // move to next plane if we already processed maximum allowed instructions per raster line
                 goto plane_epilogue;
             }
@@ -705,17 +1197,21 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
 
                 case 0x4: // Set 8-bit register
                 {
-                    plane->reg[(dl_instr & 0b11110000) >> 4] = bckgnd_bank[++*plane_offset];
+                    const uint8_t rg = (dl_instr & 0b11110000) >> 4;
+                    plane_state->reg[rg] = plane->reg[rg] = bckgnd_bank[++*plane_offset];
                 }
+                    dl_regs_loaded = true;
                     ++*plane_offset; // Move to next DL instruction
                     goto process_instruction;
 
                 case 0x5: // Set 16-bit register
                 {
                     uint8_t rg = (dl_instr & 0b01110000) >> 3;
-                    plane->reg[rg++] = bckgnd_bank[++*plane_offset];
-                    plane->reg[rg] = bckgnd_bank[++*plane_offset];
+                    plane_state->reg[rg] = plane->reg[rg] = bckgnd_bank[++*plane_offset];
+                    ++rg;
+                    plane_state->reg[rg] = plane->reg[rg] = bckgnd_bank[++*plane_offset];
                 }
+                    dl_regs_loaded = true;
                     ++*plane_offset; // Move to next DL instruction
                     goto process_instruction;
 
@@ -730,9 +1226,18 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
             {
                 // Copy plane flag bits from DL instruction
                 plane->bckgnd.flags = (plane->bckgnd.flags & ~PLANE_MASK_FROM_DL) | (dl_instr & PLANE_MASK_FROM_DL);
+                plane_state->bckgnd.flags = plane->bckgnd.flags;
+
+                // A line that is only walked needs the encoder just when the
+                // row ends with scan pointers left in the interpolators.
+                if (!draw
+                    && (instr_code <= (0x3 | CGIA_DL_MODE_BIT) || instr_code == (0x6 | CGIA_DL_MODE_BIT))
+                    && (plane->bckgnd.stride || plane_data->row_line_count != dl_row_lines))
+                    goto plane_epilogue;
 
                 if (row_columns)
                 {
+                    const uint32_t enc_start = prf_time();
                     // ------- Mode Rows --------------
                     switch (instr_code)
                     {
@@ -1211,7 +1716,22 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
 
                     case (0x7 | CGIA_DL_MODE_BIT): // MODE7 (F) - affine transform mode
                     {
-                        if (plane_data->row_line_count == 0)
+                        union cgia_plane_regs_t *affine = plane;
+                        union cgia_plane_regs_t line_regs;
+                        if (plane->affine.flags & PLANE_MASK_AFFINE_TABLE)
+                        {
+                            // each line starts from its own entry in the table at color scan
+                            const uint16_t entry = plane_data->colour_scan
+                                                   + plane_data->row_line_count * CGIA_AFFINE_LINE_SIZE;
+                            line_regs = *plane;
+                            line_regs.affine.u = bank_word(bckgnd_bank, entry);
+                            line_regs.affine.v = bank_word(bckgnd_bank, entry + 2);
+                            line_regs.affine.du = bank_word(bckgnd_bank, entry + 4);
+                            line_regs.affine.dv = bank_word(bckgnd_bank, entry + 6);
+                            affine = &line_regs;
+                            set_mode7_interp_config(affine);
+                        }
+                        else if (plane_data->row_line_count == 0)
                         {
                             // start interpolators
                             set_mode7_interp_config(plane);
@@ -1222,11 +1742,12 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
                             interp_restore(interp0, &plane_data->interpolator[0]);
                             interp_restore(interp1, &plane_data->interpolator[1]);
                         }
-                        set_mode7_scans(plane, bckgnd_bank + plane_data->memory_scan);
+                        set_mode7_scans(affine, bckgnd_bank + plane_data->memory_scan);
 
-                        cgia_encode_mode_7(
-                            rgbbuf + border_columns * CGIA_COLUMN_PX,
-                            row_columns);
+                        if (draw)
+                            cgia_encode_mode_7(
+                                rgbbuf + border_columns * CGIA_COLUMN_PX,
+                                row_columns);
 
                         // save interpolators state for this plane
                         interp_save(interp0, &plane_data->interpolator[0]);
@@ -1240,6 +1761,7 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
                         dl_row_lines = plane_data->row_line_count; // force moving to next DL instruction
                         goto plane_epilogue;
                     }
+                    prf_enc(core, PRF_ENC_MODE0 + (instr_code & 0x7), enc_start);
                 }
 
                 // borders
@@ -1297,6 +1819,18 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
         }
     }
 
+    if (!draw)
+        return;
+
+    // publish display list positions for the CPU
+    memcpy(CGIA.offset, plane_offsets[core], sizeof(CGIA.offset));
+
+    // and registers the display lists loaded
+    if (core == cgia_publish_core)
+        for (uint i = 0; i < CGIA_PLANES; ++i)
+            if (!(CGIA.planes & (0x10u << i)))
+                CGIA.plane[i] = plane_regs_int[core][i];
+
     // if we ended-up here without painting the line, we need to fill it with back color
     if (!line_background_filled)
     {
@@ -1324,42 +1858,47 @@ void __attribute__((optimize("O2"))) cgia_render(uint16_t y, uint32_t *rgbbuf)
     cpu_set_nmi();
 }
 
-static void _cgia_transfer_vcache_bank(uint8_t bank);
-
 void cgia_task(void)
 {
     cpu_set_nmi();
 
-    _cgia_transfer_vcache_bank(0);
-    _cgia_transfer_vcache_bank(1);
-}
-
-static void _cgia_transfer_vcache_bank(uint8_t vcache_bank)
-{
-    if (vcache_dma_blocks_remaining == 0)
+    if (vcache_dma_state == VCACHE_DMA_IDLE)
     {
         // Start DMA transfer from PSRAM to VRAM CACHE:
         // - do not start if transfer already in progress
-        // - store vcache id of destination being trasferred
-        // - allocate PSRAM chip, so CPU gets blocked until transfer is done
-        // - update vram_cache_bank when transfer is done with stored value
-        //   - vram_wanted_bank might already have changed and next transfer
-        //     will be started next tick
-
+        // - store cache slot of destination being trasferred
+        // - a coherent slot asks only for rows that differ from its bank
+        // - mark the slot synced when transfer is done
+        //   - the slot might have been reassigned meanwhile and next
+        //     transfer will be started next tick
+
+        // bank registers are written from PIX IRQ
+        const uint32_t irq = save_and_disable_interrupts();
         if (vcache_transfer >= 0)
         {
-            vram_cache_bank[vcache_transfer] = vram_wanted_bank[vcache_transfer];
-            vram_cache_ptr[vcache_transfer] = vram_cache[vcache_transfer];
+            struct vram_slot_t *vs = &vram_slots[vcache_transfer];
+            if (vs->bank == PIX_DMA_REQ_BANK(vcache_dma_request))
+            {
+                vs->stale = false;
+                vs->coherent = true;
+            }
             vcache_transfer = -1;
         }
 
-        if (vram_wanted_bank[vcache_bank] != vram_cache_bank[vcache_bank])
+        // only fill slots some plane still wants
+        for (uint s = 0; s < CGIA_VRAM_SLOTS; ++s)
         {
-            // start memory transfer
-            vcache_transfer = vcache_bank;
-            vcache_dma_bank = vram_wanted_bank[vcache_bank];
-            vcache_dma_dest = vram_cache[vcache_bank];
-            vcache_dma_blocks_remaining = 0x10000 / 32; // 64kB in 32-byte blocks
+            struct vram_slot_t *vs = &vram_slots[s];
+            if (vs->stale && vs->used == vram_clock)
+            {
+                // start memory transfer
+                vcache_transfer = (int)s;
+                vcache_dma_request = PIX_DMA_REQ_PAYLOAD(vs->bank, s, vs->coherent);
+                vcache_dma_base = vcache_dma_dest = vram_cache[s];
+                vcache_dma_state = VCACHE_DMA_REQUEST;
+                break;
+            }
         }
+        restore_interrupts(irq);
     }
 }
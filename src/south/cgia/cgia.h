@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdint.h>
 #include <sys/types.h>
 
 #define CGIA_COLUMN_PX (8)
@@ -117,7 +118,10 @@ union cgia_plane_regs_t
         uint8_t border_columns;
         uint8_t start_y;
         uint8_t stop_y;
-        uint8_t reserved[12];
+        uint8_t active_ext[3]; // bitmask for active sprites 8-31
+        uint8_t peak;          // most sprites drawn on a line in last frame
+        uint8_t dropped;       // lines that ran out of pixel budget in last frame
+        uint8_t reserved[7];
     } sprite;
 
     uint8_t reg[CGIA_PLANE_REGS_NO];
@@ -125,17 +129,22 @@ union cgia_plane_regs_t
 
 #define CGIA_PLANES                 (4)
 #define CGIA_AFFINE_FRACTIONAL_BITS (8)
+// Affine table entry per line of a MODE7 row: int16 u, v, du, dv.
+// Lines take u, v instead of stepping them by dx, dy.
+#define CGIA_AFFINE_LINE_SIZE       (8)
 #define CGIA_MAX_DL_INSTR_PER_LINE  (32)
 
 // plane flags:
 // 0 - color 0 is transparent
-// 1-2 - [RESERVED]
+// 1 - affine: load u, v, du, dv of each line from the table at the color scan
+// 2 - [RESERVED]
 // 3 - border is transparent
 // 4 - double-width pixel
 // 5 - multicolor-pixel
 // 6,7 - pixel bits: 00 - 1bit, 2 colors; 01 - 2bit, 4 colors;
 //                   10 - 3bit, 8 colors; 11 - 4bit, 8 colors + half-bright
 #define PLANE_MASK_TRANSPARENT        0b00000001
+#define PLANE_MASK_AFFINE_TABLE       0b00000010
 #define PLANE_MASK_BORDER_TRANSPARENT 0b00001000
 #define PLANE_MASK_DOUBLE_WIDTH       0b00010000
 #define PLANE_MASK_MULTICOLOR         0b00100000
@@ -154,10 +163,14 @@ struct cgia_t
 
     uint8_t bckgnd_bank;
     uint8_t sprite_bank;
-    uint8_t _ctl_reserved[16 - 3];
+    uint8_t plane_banks;                // [xxxxPPPP] planes reading plane_bank[] instead
+    uint8_t plane_bank[CGIA_PLANES];    // per plane PSRAM bank
+    uint8_t _ctl_reserved[16 - 8];
     // -------------------------------------------------------------------
     uint16_t raster;
-    uint8_t _rst_reserved1[8 - 2];
+    uint8_t load; // worst line of last frame, % of render budget
+    uint8_t late; // lines of last frame rendered too late
+    uint8_t _rst_reserved1[8 - 4];
 
     uint16_t int_raster; // Line to generate raster interrupt.
     uint8_t int_enable;  // Interrupt flags. [VBI DLI RSI x x x x x]
@@ -185,12 +198,18 @@ struct cgia_t
 #define CGIA_REG_MODE        (offsetof(struct cgia_t, mode))
 #define CGIA_REG_BCKGND_BANK (offsetof(struct cgia_t, bckgnd_bank))
 #define CGIA_REG_SPRITE_BANK (offsetof(struct cgia_t, sprite_bank))
+#define CGIA_REG_PLANE_BANKS (offsetof(struct cgia_t, plane_banks))
+#define CGIA_REG_PLANE_BANK  (offsetof(struct cgia_t, plane_bank))
 #define CGIA_REG_RASTER      (offsetof(struct cgia_t, raster))
+#define CGIA_REG_LOAD        (offsetof(struct cgia_t, load))
+#define CGIA_REG_LATE        (offsetof(struct cgia_t, late))
 #define CGIA_REG_INT_RASTER  (offsetof(struct cgia_t, int_raster))
 #define CGIA_REG_INT_ENABLE  (offsetof(struct cgia_t, int_enable))
 #define CGIA_REG_INT_STATUS  (offsetof(struct cgia_t, int_status))
 #define CGIA_REG_PLANES      (offsetof(struct cgia_t, planes))
 #define CGIA_REG_BACK_COLOR  (offsetof(struct cgia_t, back_color))
+#define CGIA_REG_OFFSET      (offsetof(struct cgia_t, offset))
+#define CGIA_REG_PLANE       (offsetof(struct cgia_t, plane))
 
 #define CGIA_REG_INT_FLAG_VBI 0b10000000
 #define CGIA_REG_INT_FLAG_DLI 0b01000000
@@ -211,9 +230,13 @@ struct cgia_sprite_t
                               // this is a built-in sprite multiplexer
 };
 
-#define CGIA_SPRITES     (8)
+#define CGIA_SPRITES     (32)
 #define SPRITE_MAX_WIDTH (8)
 
+// Sprite pixels drawn per plane and line. Sprites past it are dropped,
+// starting with the highest numbered ones.
+#define CGIA_SPRITE_LINE_PIXELS (SPRITE_MAX_WIDTH * CGIA_COLUMN_PX * 2 * 8)
+
 // sprite flags:
 // 0-2 - width in bytes
 // 3 - [RESERVED]
@@ -231,6 +254,8 @@ struct cgia_sprite_t
 // ---- internals ----
 void cgia_init(void);
 void cgia_reset(void);
+// Renders raster line y. With NULL rgbbuf the line is walked to keep
+// this core's display list state in step, but nothing is drawn.
 void cgia_render(uint16_t y, uint32_t *rgbbuf);
 void cgia_vbi(void);
 uint8_t cgia_reg_read(uint8_t reg_no);
@@ -238,11 +263,28 @@ void cgia_reg_write(uint8_t reg_no, uint8_t value);
 
 void cgia_task(void);
 
-#define CGIA_VRAM_BANKS (2)
-extern uint8_t vram_cache[CGIA_VRAM_BANKS][0x10000];
+// Resident PSRAM bank mirrors, 64 KB of SRAM each.
+// One per plane keeps any plane setup resident, so the count goes
+// from CGIA_PLANES up to PIX_VCACHE_SLOTS. There are no spare slots
+// by default, flipping to a bank no plane maps refills a slot.
+// The link checks the slots still fit the SRAM budget, see sram.ld.
+#ifndef CGIA_VRAM_SLOTS
+#define CGIA_VRAM_SLOTS (4)
+#endif
+extern uint8_t vram_cache[CGIA_VRAM_SLOTS][0x10000];
 // pass EVERY RAM write through CGIA for updating VRAM cache banks
 void cgia_ram_write(uint8_t bank, uint16_t addr, uint8_t data);
+// Block writes, not crossing the end of the bank
+void cgia_ram_write_block(uint8_t bank, uint16_t addr, const uint8_t *data, uint32_t len);
+void cgia_ram_fill(uint8_t bank, uint16_t addr, uint8_t data, uint32_t len);
 // VCACHE DMA transfer control
-extern uint8_t vcache_dma_bank;
-extern uint16_t vcache_dma_blocks_remaining;
+enum
+{
+    VCACHE_DMA_IDLE,
+    VCACHE_DMA_REQUEST, // vcache_dma_request waits for the next ACK
+    VCACHE_DMA_RUNNING,
+};
+extern volatile uint8_t vcache_dma_state;
+extern uint16_t vcache_dma_request;
+extern uint8_t *vcache_dma_base;
 extern uint8_t *vcache_dma_dest;
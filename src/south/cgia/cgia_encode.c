@@ -0,0 +1,578 @@
+#include "cgia_encode.h"
+
+#if CGIA_ENCODE_C
+
+/* Portable C versions of the encoders in cgia_encode.S and
+ * cgia_sprites.S. They take scan pointers from the interpolators
+ * exactly like the assembly does, so cgia.c can not tell them apart.
+ * Off-target the interpolators are modelled in misc/host.
+ */
+
+#include "cgia.h"
+#include "cgia_palette.h"
+#include "hardware/interp.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef CGIA_ENCODE_CYCLES
+// Costs follow the assembly instruction by instruction:
+// 1 per ALU op and store, 2 per load and taken branch.
+uint32_t cgia_encode_cycles;
+#define CYCLES(n) (cgia_encode_cycles += (n))
+#else
+#define CYCLES(n) ((void)0)
+#endif
+
+#define ENCODE static inline __attribute__((always_inline))
+
+ENCODE const uint8_t *pop_scan(interp_hw_t *interp, uint lane)
+{
+    return (const uint8_t *)(uintptr_t)interp_pop_lane_result(interp, lane);
+}
+
+ENCODE const uint8_t *peek_scan(interp_hw_t *interp, uint lane)
+{
+    return (const uint8_t *)(uintptr_t)interp_peek_lane_result(interp, lane);
+}
+
+ENCODE uint32_t *put_pixel(uint32_t *buf, uint32_t color, bool doubled)
+{
+    *buf++ = color;
+    if (doubled)
+        *buf++ = color;
+    return buf;
+}
+
+ENCODE uint32_t *skip_pixel(uint32_t *buf, bool doubled)
+{
+    return buf + (doubled ? 2 : 1);
+}
+
+// Indexed pixel through the shared colors table, index 0 is
+// transparent unless mapped.
+ENCODE uint32_t *put_indexed(uint32_t *buf, uint index, bool half_bright,
+                             const uint8_t *shared_colors, bool doubled, bool mapped,
+                             uint cost)
+{
+    if (!mapped && !index)
+    {
+        CYCLES(7);
+        return skip_pixel(buf, doubled);
+    }
+    uint color = shared_colors[index];
+    if (half_bright)
+        color ^= 4;
+    CYCLES(cost + !mapped + doubled);
+    return put_pixel(buf, cgia_rgb_palette[color], doubled);
+}
+
+// 8 pixels, MSB first. Clear bits show back color, or nothing if not mapped.
+ENCODE uint32_t *put_bitmap(uint32_t *buf, uint8_t bitmap, uint32_t fore, uint32_t back,
+                            bool doubled, bool mapped)
+{
+    for (uint bit = 0x80; bit; bit >>= 1)
+    {
+        if (bitmap & bit)
+        {
+            CYCLES(5 + doubled);
+            buf = put_pixel(buf, fore, doubled);
+        }
+        else if (mapped)
+        {
+            CYCLES(4 + doubled);
+            buf = put_pixel(buf, back, doubled);
+        }
+        else
+        {
+            CYCLES(4);
+            buf = skip_pixel(buf, doubled);
+        }
+    }
+    return buf;
+}
+
+// 4 pixels of 2 bits, MSB first, from a 4 entry RGB table.
+ENCODE uint32_t *put_multi(uint32_t *buf, uint8_t bitmap, const uint32_t colors[4],
+                           bool doubled, bool mapped)
+{
+    for (int sh = 6; sh >= 0; sh -= 2)
+    {
+        const uint index = (bitmap >> sh) & 3;
+        if (!mapped && !index)
+        {
+            CYCLES(6);
+            buf = skip_pixel(buf, doubled);
+            continue;
+        }
+        CYCLES(8 + !mapped + 2 * doubled);
+        buf = put_pixel(buf, colors[index], doubled);
+    }
+    return buf;
+}
+
+//////////////////// MODE 0 ////////////////////
+////         palette text/tile mode         ////
+
+ENCODE uint32_t *encode_mode_0(uint32_t *rgbbuf, uint32_t columns,
+                               const uint8_t *character_generator, uint32_t char_shift,
+                               const uint8_t *shared_colors,
+                               uint bpp, bool doubled, bool mapped)
+{
+    do
+    {
+        uint code = *pop_scan(interp0, 0);
+        // character code high bits select the color pair
+        uint color_bits = code >> (9 - bpp);
+        bool half_bright = false;
+        if (bpp == 4)
+        {
+            color_bits &= 3;
+            half_bright = code & 0x80;
+        }
+        code &= 0xFFu >> (bpp - 1);
+        const uint8_t bitmap = character_generator[code << char_shift];
+        CYCLES(bpp == 4 ? 15 : 13);
+
+        for (int sh = 7; sh >= 0; --sh)
+            rgbbuf = put_indexed(rgbbuf, ((bitmap >> sh) & 1) | color_bits << 1, half_bright,
+                                 shared_colors, doubled, mapped, bpp == 4 ? 14 : 11);
+    } while (--columns);
+    return rgbbuf;
+}
+
+ENCODE uint32_t *encode_mode_0_multi(uint32_t *rgbbuf, uint32_t columns,
+                                     const uint8_t *character_generator, uint32_t char_shift,
+                                     const uint8_t *shared_colors,
+                                     uint bpp, bool doubled, bool mapped)
+{
+    do
+    {
+        uint code = *pop_scan(interp0, 0);
+        uint color_bits = 0;
+        bool half_bright = false;
+        if (bpp == 3)
+        {
+            color_bits = (code & 0x80) >> 5;
+            code &= 0x7F;
+        }
+        if (bpp == 4)
+        {
+            half_bright = code & 0x80;
+            color_bits = (code & 0x40) >> 4;
+            code &= 0x3F;
+        }
+        const uint8_t bitmap = character_generator[code << char_shift];
+        CYCLES(bpp == 2 ? 12 : bpp == 3 ? 14 : 15);
+
+        for (int sh = 6; sh >= 0; sh -= 2)
+            rgbbuf = put_indexed(rgbbuf, ((bitmap >> sh) & 3) | color_bits, half_bright,
+                                 shared_colors, doubled, mapped, bpp == 4 ? 14 : 11);
+    } while (--columns);
+    return rgbbuf;
+}
+
+#define CGIA_ENCODE_MODE_0_IMPL(multi, pixels, doubled, shared, bpp, is_doubled, is_mapped) \
+    CGIA_ENCODE_MODE_0(multi, pixels, doubled, shared)                                    \
+    {                                                                                     \
+        return encode_mode_0##multi(rgbbuf, columns, character_generator, char_shift,     \
+                                    shared_colors, bpp, is_doubled, is_mapped);           \
+    }
+
+CGIA_ENCODE_MODE_0_IMPL(, _1bpp, , _shared, 1, false, false)
+CGIA_ENCODE_MODE_0_IMPL(, _1bpp, , _mapped, 1, false, true)
+CGIA_ENCODE_MODE_0_IMPL(, _1bpp, _doubled, _shared, 1, true, false)
+CGIA_ENCODE_MODE_0_IMPL(, _1bpp, _doubled, _mapped, 1, true, true)
+CGIA_ENCODE_MODE_0_IMPL(, _2bpp, , _shared, 2, false, false)
+CGIA_ENCODE_MODE_0_IMPL(, _2bpp, , _mapped, 2, false, true)
+CGIA_ENCODE_MODE_0_IMPL(, _2bpp, _doubled, _shared, 2, true, false)
+CGIA_ENCODE_MODE_0_IMPL(, _2bpp, _doubled, _mapped, 2, true, true)
+CGIA_ENCODE_MODE_0_IMPL(, _3bpp, , _shared, 3, false, false)
+CGIA_ENCODE_MODE_0_IMPL(, _3bpp, , _mapped, 3, false, true)
+CGIA_ENCODE_MODE_0_IMPL(, _3bpp, _doubled, _shared, 3, true, false)
+CGIA_ENCODE_MODE_0_IMPL(, _3bpp, _doubled, _mapped, 3, true, true)
+CGIA_ENCODE_MODE_0_IMPL(, _4bpp, , _shared, 4, false, false)
+CGIA_ENCODE_MODE_0_IMPL(, _4bpp, , _mapped, 4, false, true)
+CGIA_ENCODE_MODE_0_IMPL(, _4bpp, _doubled, _shared, 4, true, false)
+CGIA_ENCODE_MODE_0_IMPL(, _4bpp, _doubled, _mapped, 4, true, true)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _2bpp, , _shared, 2, false, false)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _2bpp, , _mapped, 2, false, true)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _2bpp, _doubled, _shared, 2, true, false)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _2bpp, _doubled, _mapped, 2, true, true)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _3bpp, , _shared, 3, false, false)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _3bpp, , _mapped, 3, false, true)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _3bpp, _doubled, _shared, 3, true, false)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _3bpp, _doubled, _mapped, 3, true, true)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _4bpp, , _shared, 4, false, false)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _4bpp, , _mapped, 4, false, true)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _4bpp, _doubled, _shared, 4, true, false)
+CGIA_ENCODE_MODE_0_IMPL(_multi, _4bpp, _doubled, _mapped, 4, true, true)
+
+//////////////////// MODE 1 ////////////////////
+////           palette bitmap mode          ////
+
+ENCODE uint32_t *encode_mode_1(uint32_t *rgbbuf, uint32_t columns,
+                               const uint8_t *shared_colors,
+                               uint bpp, bool doubled, bool mapped)
+{
+    do
+    {
+        // a column is bpp bytes, first one in the highest bits
+        uint32_t bitmap = *pop_scan(interp0, 0);
+        for (uint i = 1; i < bpp; ++i)
+            bitmap = bitmap << 8 | *pop_scan(interp0, 0);
+        CYCLES(7 + 6 * (bpp - 1));
+
+        for (int px = 7; px >= 0; --px)
+        {
+            uint index = (bitmap >> (px * bpp)) & ((1u << bpp) - 1);
+            bool half_bright = false;
+            if (bpp == 4)
+            {
+                half_bright = index & 8;
+                index &= 7;
+            }
+            rgbbuf = put_indexed(rgbbuf, index, half_bright,
+                                 shared_colors, doubled, mapped, bpp == 4 ? 14 : 10);
+        }
+    } while (--columns);
+    return rgbbuf;
+}
+
+#define CGIA_ENCODE_MODE_1_IMPL(pixels, doubled, shared, bpp, is_doubled, is_mapped)      \
+    CGIA_ENCODE_MODE_1(pixels, doubled, shared)                                           \
+    {                                                                                     \
+        return encode_mode_1(rgbbuf, columns, shared_colors, bpp, is_doubled, is_mapped); \
+    }
+
+CGIA_ENCODE_MODE_1_IMPL(_1bpp, , _shared, 1, false, false)
+CGIA_ENCODE_MODE_1_IMPL(_1bpp, , _mapped, 1, false, true)
+CGIA_ENCODE_MODE_1_IMPL(_1bpp, _doubled, _shared, 1, true, false)
+CGIA_ENCODE_MODE_1_IMPL(_1bpp, _doubled, _mapped, 1, true, true)
+CGIA_ENCODE_MODE_1_IMPL(_2bpp, , _shared, 2, false, false)
+CGIA_ENCODE_MODE_1_IMPL(_2bpp, , _mapped, 2, false, true)
+CGIA_ENCODE_MODE_1_IMPL(_2bpp, _doubled, _shared, 2, true, false)
+CGIA_ENCODE_MODE_1_IMPL(_2bpp, _doubled, _mapped, 2, true, true)
+CGIA_ENCODE_MODE_1_IMPL(_3bpp, , _shared, 3, false, false)
+CGIA_ENCODE_MODE_1_IMPL(_3bpp, , _mapped, 3, false, true)
+CGIA_ENCODE_MODE_1_IMPL(_3bpp, _doubled, _shared, 3, true, false)
+CGIA_ENCODE_MODE_1_IMPL(_3bpp, _doubled, _mapped, 3, true, true)
+CGIA_ENCODE_MODE_1_IMPL(_4bpp, , _shared, 4, false, false)
+CGIA_ENCODE_MODE_1_IMPL(_4bpp, , _mapped, 4, false, true)
+CGIA_ENCODE_MODE_1_IMPL(_4bpp, _doubled, _shared, 4, true, false)
+CGIA_ENCODE_MODE_1_IMPL(_4bpp, _doubled, _mapped, 4, true, true)
+
+//////////////////// MODE 2 ////////////////////
+////        attribute text/tile mode        ////
+
+// interp1 lane 0 scans foreground colors, lane 1 background colors.
+// Popping lane 0 advances both.
+
+ENCODE uint32_t *encode_mode_2(uint32_t *rgbbuf, uint32_t columns,
+                               const uint8_t *character_generator, uint32_t char_shift,
+                               bool doubled, bool mapped)
+{
+    do
+    {
+        uint32_t back = 0;
+        if (mapped)
+            back = cgia_rgb_palette[*peek_scan(interp1, 1)];
+        const uint32_t fore = cgia_rgb_palette[*pop_scan(interp1, 0)];
+        const uint8_t bitmap = character_generator[*pop_scan(interp0, 0) << char_shift];
+        CYCLES(mapped ? 23 : 17);
+        rgbbuf = put_bitmap(rgbbuf, bitmap, fore, back, doubled, mapped);
+    } while (--columns);
+    return rgbbuf;
+}
+
+ENCODE uint32_t *encode_mode_2_multi(uint32_t *rgbbuf, uint32_t columns,
+                                     const uint8_t *character_generator, uint32_t char_shift,
+                                     const uint8_t *shared_colors,
+                                     bool doubled, bool mapped)
+{
+    uint32_t cell_colors[4] = {0};
+    if (mapped)
+        cell_colors[0] = cgia_rgb_palette[shared_colors[0]];
+    cell_colors[3] = cgia_rgb_palette[shared_colors[1]];
+    CYCLES(20);
+    do
+    {
+        cell_colors[1] = cgia_rgb_palette[*peek_scan(interp1, 1)];
+        cell_colors[2] = cgia_rgb_palette[*pop_scan(interp1, 0)];
+        const uint8_t bitmap = character_generator[*pop_scan(interp0, 0) << char_shift];
+        CYCLES(24);
+        rgbbuf = put_multi(rgbbuf, bitmap, cell_colors, doubled, mapped);
+    } while (--columns);
+    return rgbbuf;
+}
+
+#define CGIA_ENCODE_MODE_2_IMPL(doubled, shared, is_doubled, is_mapped)            \
+    CGIA_ENCODE_MODE_2(, doubled, shared)                                          \
+    {                                                                              \
+        (void)shared_colors;                                                       \
+        return encode_mode_2(rgbbuf, columns, character_generator, char_shift,     \
+                             is_doubled, is_mapped);                               \
+    }                                                                              \
+    CGIA_ENCODE_MODE_2(_multi, doubled, shared)                                    \
+    {                                                                              \
+        return encode_mode_2_multi(rgbbuf, columns, character_generator, char_shift, \
+                                   shared_colors, is_doubled, is_mapped);          \
+    }
+
+CGIA_ENCODE_MODE_2_IMPL(, _shared, false, false)
+CGIA_ENCODE_MODE_2_IMPL(, _mapped, false, true)
+CGIA_ENCODE_MODE_2_IMPL(_doubled, _shared, true, false)
+CGIA_ENCODE_MODE_2_IMPL(_doubled, _mapped, true, true)
+
+//////////////////// VT ////////////////////
+
+// Cells are {code, pad[3], fg RGB, bg RGB}, see term_data_t.
+uint32_t *__not_in_flash_func(cgia_encode_vt)(
+    uint32_t *rgbbuf,
+    uint32_t columns,
+    const uint8_t *character_generator,
+    uint32_t char_shift)
+{
+    do
+    {
+        const uint8_t *cell = pop_scan(interp0, 0);
+        uint32_t fore, back;
+        memcpy(&fore, cell + 4, sizeof(fore));
+        memcpy(&back, cell + 8, sizeof(back));
+        const uint8_t bitmap = character_generator[cell[0] << char_shift];
+        CYCLES(19);
+        rgbbuf = put_bitmap(rgbbuf, bitmap, fore, back, false, true);
+    } while (--columns);
+    return rgbbuf;
+}
+
+//////////////////// MODE 3 ////////////////////
+////         attribute bitmap mode         ////
+
+ENCODE uint32_t *encode_mode_3(uint32_t *rgbbuf, uint32_t columns,
+                               bool doubled, bool mapped)
+{
+    do
+    {
+        uint32_t back = 0;
+        if (mapped)
+            back = cgia_rgb_palette[*peek_scan(interp1, 1)];
+        const uint32_t fore = cgia_rgb_palette[*pop_scan(interp1, 0)];
+        const uint8_t bitmap = *pop_scan(interp0, 0);
+        CYCLES(mapped ? 20 : 14);
+        rgbbuf = put_bitmap(rgbbuf, bitmap, fore, back, doubled, mapped);
+    } while (--columns);
+    return rgbbuf;
+}
+
+ENCODE uint32_t *encode_mode_3_multi(uint32_t *rgbbuf, uint32_t columns,
+                                     const uint8_t *shared_colors,
+                                     bool doubled, bool mapped)
+{
+    uint32_t cell_colors[4] = {0};
+    if (mapped)
+        cell_colors[0] = cgia_rgb_palette[shared_colors[0]];
+    cell_colors[3] = cgia_rgb_palette[shared_colors[1]];
+    CYCLES(20);
+    do
+    {
+        cell_colors[1] = cgia_rgb_palette[*peek_scan(interp1, 1)];
+        cell_colors[2] = cgia_rgb_palette[*pop_scan(interp1, 0)];
+        const uint8_t bitmap = *pop_scan(interp0, 0);
+        CYCLES(21);
+        rgbbuf = put_multi(rgbbuf, bitmap, cell_colors, doubled, mapped);
+    } while (--columns);
+    return rgbbuf;
+}
+
+#define CGIA_ENCODE_MODE_3_IMPL(doubled, shared, is_doubled, is_mapped)                 \
+    CGIA_ENCODE_MODE_3(, doubled, shared)                                               \
+    {                                                                                   \
+        (void)shared_colors;                                                            \
+        return encode_mode_3(rgbbuf, columns, is_doubled, is_mapped);                   \
+    }                                                                                   \
+    CGIA_ENCODE_MODE_3(_multi, doubled, shared)                                         \
+    {                                                                                   \
+        return encode_mode_3_multi(rgbbuf, columns, shared_colors, is_doubled, is_mapped); \
+    }
+
+CGIA_ENCODE_MODE_3_IMPL(, _shared, false, false)
+CGIA_ENCODE_MODE_3_IMPL(, _mapped, false, true)
+CGIA_ENCODE_MODE_3_IMPL(_doubled, _shared, true, false)
+CGIA_ENCODE_MODE_3_IMPL(_doubled, _mapped, true, true)
+
+//////////////////// MODE 6 ////////////////////
+////       Hold-and-Modify (HAM) mode       ////
+
+ENCODE uint32_t ham_command(uint32_t color, uint command, const uint8_t *base_color)
+{
+    const uint code = command >> 3;
+    if (code == 0) // 000 - load base color
+    {
+        CYCLES(12);
+        return cgia_rgb_palette[base_color[command & 7]];
+    }
+    if (code == 1) // 001 - blend current color with base color
+    {
+        // average channels without carry between them, then add back
+        // the halves of the lowest bits so the error does not accumulate
+        CYCLES(30);
+        const uint32_t base = cgia_rgb_palette[base_color[command & 7]];
+        const uint32_t fast_blend = ((base & 0xFEFEFE) + (color & 0xFEFEFE)) >> 1;
+        return fast_blend + ((((base & 0x010101) + (color & 0x010101)) >> 1) & 0x7F7F7F);
+    }
+    // 01x/10x/11x - modify red/green/blue by signed 4 bit delta in x8 quanta
+    CYCLES(20);
+    const int delta = (int8_t)((command & 15) << 4) >> 1;
+    const uint shift = ((code >> 1) - 1) * 8;
+    const uint32_t mask = 0xFFu << shift;
+    return (color & ~mask) | ((color + ((uint32_t)delta << shift)) & mask);
+}
+
+ENCODE uint32_t *encode_mode_6(uint32_t *rgbbuf, uint32_t columns,
+                               const uint8_t *base_color, uint8_t back_color,
+                               bool doubled)
+{
+    uint32_t color = cgia_rgb_palette[back_color];
+    do
+    {
+        // four 6 bit commands packed MSB first in three bytes
+        uint32_t data;
+        memcpy(&data, pop_scan(interp0, 0), sizeof(data));
+        (void)pop_scan(interp0, 0);
+        (void)pop_scan(interp0, 0);
+        const uint commands[4] = {
+            (data >> 2) & 0x3F,
+            ((data >> 12) & 15) | (data & 3) << 4,
+            ((data >> 6) & 60) | (data & 0xC00000) >> 22,
+            (data >> 16) & 0x3F,
+        };
+        CYCLES(27);
+        for (uint i = 0; i < 4; ++i)
+        {
+            color = ham_command(color, commands[i], base_color);
+            CYCLES(1 + doubled * 2);
+            rgbbuf = put_pixel(rgbbuf, color, doubled);
+        }
+    } while (--columns);
+    return rgbbuf;
+}
+
+uint32_t *__not_in_flash_func(cgia_encode_mode_6)(
+    uint32_t *rgbbuf,
+    uint32_t columns,
+    uint8_t base_color[8],
+    uint8_t back_color)
+{
+    return encode_mode_6(rgbbuf, columns, base_color, back_color, false);
+}
+
+uint32_t *__not_in_flash_func(cgia_encode_mode_6_doubled)(
+    uint32_t *rgbbuf,
+    uint32_t columns,
+    uint8_t base_color[8],
+    uint8_t back_color)
+{
+    return encode_mode_6(rgbbuf, columns, base_color, back_color, true);
+}
+
+//////////////////// MODE 7 ////////////////////
+////   affine transform chunky pixel mode   ////
+
+uint32_t *__not_in_flash_func(cgia_encode_mode_7)(
+    uint32_t *rgbbuf,
+    uint32_t columns)
+{
+    do
+    {
+        for (uint i = 0; i < CGIA_COLUMN_PX; ++i)
+            *rgbbuf++ = cgia_rgb_palette[*(const uint8_t *)(uintptr_t)interp_pop_full_result(interp0)];
+        CYCLES(61);
+    } while (--columns);
+    return rgbbuf;
+}
+
+//////////////////// SPRITES ////////////////////
+
+ENCODE void encode_sprite(uint32_t *rgbbuf, const struct cgia_sprite_t *sprite,
+                          const uint8_t *data, uint32_t width, bool rtl)
+{
+    CYCLES(20);
+    if (sprite->pos_x >= 768 || sprite->pos_x < -SPRITE_MAX_WIDTH * 8 * 2)
+        return;
+    rgbbuf += sprite->pos_x;
+
+    const bool doubled = sprite->flags & SPRITE_MASK_DOUBLE_WIDTH;
+    if (sprite->flags & SPRITE_MASK_MULTICOLOR)
+    {
+        const uint32_t colors[4] = {
+            0,
+            cgia_rgb_palette[sprite->color[0]],
+            cgia_rgb_palette[sprite->color[1]],
+            cgia_rgb_palette[sprite->color[2]],
+        };
+        CYCLES(12);
+        for (uint32_t i = 0; i <= width; ++i)
+        {
+            const uint8_t bitmap = rtl ? *data-- : *data++;
+            CYCLES(6);
+            for (uint px = 0; px < 4; ++px)
+            {
+                const uint index = (bitmap >> (rtl ? px * 2 : 6 - px * 2)) & 3;
+                if (index)
+                {
+                    CYCLES(9 + doubled);
+                    rgbbuf = put_pixel(rgbbuf, colors[index], doubled);
+                }
+                else
+                {
+                    CYCLES(6);
+                    rgbbuf = skip_pixel(rgbbuf, doubled);
+                }
+            }
+        }
+    }
+    else
+    {
+        const uint32_t color = cgia_rgb_palette[sprite->color[0]];
+        CYCLES(4);
+        for (uint32_t i = 0; i <= width; ++i)
+        {
+            const uint8_t bitmap = rtl ? *data-- : *data++;
+            CYCLES(6 + !rtl);
+            for (uint px = 0; px < 8; ++px)
+            {
+                if (bitmap & (rtl ? 1u << px : 0x80u >> px))
+                {
+                    CYCLES(5 + doubled);
+                    rgbbuf = put_pixel(rgbbuf, color, doubled);
+                }
+                else
+                {
+                    CYCLES(4);
+                    rgbbuf = skip_pixel(rgbbuf, doubled);
+                }
+            }
+        }
+    }
+}
+
+void __not_in_flash_func(cgia_encode_sprite)(
+    uint32_t *rgbbuf,
+    const uint32_t *descriptor,
+    const uint8_t *data_ptr,
+    uint32_t width)
+{
+    encode_sprite(rgbbuf, (const struct cgia_sprite_t *)descriptor, data_ptr, width, false);
+}
+
+void __not_in_flash_func(cgia_encode_sprite_mirror)(
+    uint32_t *rgbbuf,
+    const uint32_t *descriptor,
+    const uint8_t *data_ptr,
+    uint32_t width)
+{
+    encode_sprite(rgbbuf, (const struct cgia_sprite_t *)descriptor, data_ptr, width, true);
+}
+
+#endif /* CGIA_ENCODE_C */
@@ -3,6 +3,17 @@
 
 #include "pico.h"
 
+// Build the portable C encoders in cgia_encode.c instead of the
+// assembly ones. The host renderer in misc/cgia_render.c uses them.
+#ifndef CGIA_ENCODE_C
+#define CGIA_ENCODE_C 0
+#endif
+
+#if CGIA_ENCODE_C && defined(CGIA_ENCODE_CYCLES)
+// Running estimate of Cortex-M33 cycles the assembly would take.
+extern uint32_t cgia_encode_cycles;
+#endif
+
 #define CGIA_ENCODE_MODE_0(multi, pixels, doubled, shared)                             \
     uint32_t *__not_in_flash_func(cgia_encode_mode_0##multi##pixels##doubled##shared)( \
         uint32_t *rgbbuf,                                                              \
@@ -7,6 +7,7 @@
 
 #include "main.h"
 #include "cgia/cgia.h"
+#include "hw.h"
 #include "sys/aud.h"
 #include "sys/buz.h"
 #include "sys/com.h"
@@ -14,6 +15,7 @@
 #include "sys/led.h"
 #include "sys/out.h"
 #include "sys/pix.h"
+#include "sys/sch.h"
 #include "term/font.h"
 #include "term/term.h"
 #include "usb/cdc.h"
@@ -44,35 +46,30 @@ static void init(void)
     out_init();
 }
 
-static void task(void)
-{
-    // com_task is important
-    term_task();
-    com_task();
-    cdc_task();
-    com_task();
-    com_task();
-    cgia_task();
-    com_task();
-    usb_task();
-    com_task();
-    com_task();
-    pix_task();
-    com_task();
-    led_task();
-    com_task();
-    buz_task();
-    com_task();
-    aud_task();
-    com_task();
-}
+// Drain the UART before its 32 byte FIFO is half full.
+#define COM_DRAIN_US (16 * 10 * 1000000 / COM_UART_BAUDRATE)
+
+// Listed in priority order. See sys/sch.h.
+static sch_task_t tasks[] = {
+    SCH_TASK(com_task, COM_DRAIN_US, 100),
+    SCH_TASK(cdc_task, 0, 200),
+    SCH_TASK(usb_task, 0, 500),
+    SCH_TASK(buz_task, 1000, 50),
+    SCH_TASK(led_task, 10000, 500),
+    SCH_TASK(aud_stream_task, 2000, 200),
+    SCH_TASK(cgia_task, 0, 100),
+    SCH_TASK(pix_task, 0, 100),
+    SCH_TASK(term_task, 0, 500),
+    SCH_TASK(aud_task, 0, 100),
+};
 
 int main(void)
 {
     init();
 
+    sch_init(tasks, sizeof(tasks) / sizeof(*tasks));
     while (true)
-        task();
+        sch_task();
 
     __builtin_unreachable();
 }
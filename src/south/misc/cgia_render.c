@@ -0,0 +1,471 @@
+/*
+ * cgia_render.c  Render CGIA frames on the host with the C encoders
+ *
+ * gcc cgia_render.c ../cgia/cgia.c ../cgia/cgia_encode.c -O2 -o cgia_render -Wall \
+ *     -Ihost -I.. -DCGIA_ENCODE_C=1 -DCGIA_ENCODE_CYCLES
+ *
+ * ./cgia_render -o frame.png regs.bin 00=bank00.bin 01=bank01.bin
+ * ./cgia_render -f 2 -g golden.png regs.bin 00=bank00.bin
+ * ./cgia_render -t
+ *
+ * regs.bin is the 128 byte CGIA register file, written in order.
+ * BB=file loads up to 64 KB into PSRAM bank BB (hex), other banks
+ * read as zeros. The last of -f frames is written with -o and/or
+ * compared with -g. Golden frames must be PNGs written by -o, only
+ * stored (uncompressed) deflate blocks are read back.
+ *
+ * -t renders the built-in sprite case instead: sprites parked below
+ * the screen and descriptor chains that loop back on themselves,
+ * checking the lines they are drawn on.
+ *
+ * Cycle counts are estimates of the encoders' own work on the
+ * RP2350, display list decoding and DMA fills are not included.
+ *
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../pix.h"
+#include "../cgia/cgia.h"
+#include "../cgia/cgia_encode.h"
+#include "../sys/out.h"
+#include "../sys/prf.h"
+#include "hardware/dma.h"
+#include "hardware/interp.h"
+
+#ifndef SYS_CLK_HZ
+#define SYS_CLK_HZ 336000000
+#endif
+
+#define WIDTH  (MODE_H_ACTIVE_PIXELS / FB_H_REPEAT)
+#define HEIGHT (MODE_V_ACTIVE_LINES / FB_V_REPEAT)
+
+#define MODE_V_TOTAL_LINES ( \
+    MODE_V_FRONT_PORCH + MODE_V_SYNC_WIDTH + MODE_V_BACK_PORCH + MODE_V_ACTIVE_LINES)
+
+// Same as sys/out.c, encoders may scroll up to a signed byte off the line.
+#define LINE_BUFFER_PADDING 128
+#define LINE_BUFFER_LEN     (MODE_H_ACTIVE_PIXELS + 2 * LINE_BUFFER_PADDING)
+
+// Hardware models from host/
+interp_hw_t host_interp_hw[2];
+dma_hw_t host_dma_hw;
+struct host_dma_channel host_dma_channels[NUM_DMA_CHANNELS];
+systick_hw_t host_systick_hw;
+
+// Render profiler is not linked, line cycles are estimated here.
+uint32_t prf_line_enc[2][PRF_ENC_COUNT];
+
+uint8_t prf_frame_load(void)
+{
+    return 0;
+}
+
+uint8_t prf_frame_late(void)
+{
+    return 0;
+}
+
+static uint8_t *banks[256];
+static uint8_t frame[HEIGHT][WIDTH][3];
+static uint32_t line_cycles[HEIGHT];
+
+static uint32_t crc_table[256];
+
+static void crc_init(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+        crc_table[i] = c;
+    }
+}
+
+static uint32_t crc32_update(uint32_t c, const uint8_t *buf, size_t len)
+{
+    while (len--)
+        c = crc_table[(c ^ *buf++) & 0xFF] ^ (c >> 8);
+    return c;
+}
+
+static void fput32(uint32_t word, FILE *file)
+{
+    fputc(word >> 24, file);
+    fputc(word >> 16, file);
+    fputc(word >> 8, file);
+    fputc(word, file);
+}
+
+static uint32_t get32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] << 24 | buf[1] << 16 | buf[2] << 8 | buf[3];
+}
+
+static void png_chunk(FILE *file, const char *type, const uint8_t *data, uint32_t len)
+{
+    fput32(len, file);
+    fwrite(type, 1, 4, file);
+    fwrite(data, 1, len, file);
+    uint32_t crc = crc32_update(0xFFFFFFFF, (const uint8_t *)type, 4);
+    crc = crc32_update(crc, data, len);
+    fput32(crc ^ 0xFFFFFFFF, file);
+}
+
+// Scanlines with filter byte 0, as one zlib stream of stored blocks.
+#define ROW_LEN     (1 + WIDTH * 3)
+#define RAW_LEN     (HEIGHT * ROW_LEN)
+#define STORED_MAX  0xFFFF
+#define STORED_LEN  (RAW_LEN + (RAW_LEN + STORED_MAX - 1) / STORED_MAX * 5)
+#define ZLIB_LEN    (2 + STORED_LEN + 4)
+
+static int png_write(const char *path)
+{
+    static uint8_t raw[RAW_LEN];
+    static uint8_t zlib[ZLIB_LEN];
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        raw[y * ROW_LEN] = 0;
+        memcpy(&raw[y * ROW_LEN + 1], frame[y], WIDTH * 3);
+    }
+    size_t pos = 0;
+    zlib[pos++] = 0x78;
+    zlib[pos++] = 0x01;
+    for (size_t off = 0; off < RAW_LEN;)
+    {
+        size_t len = RAW_LEN - off < STORED_MAX ? RAW_LEN - off : STORED_MAX;
+        zlib[pos++] = off + len == RAW_LEN; // BFINAL, BTYPE 00
+        zlib[pos++] = len & 0xFF;
+        zlib[pos++] = len >> 8;
+        zlib[pos++] = ~len & 0xFF;
+        zlib[pos++] = (~len >> 8) & 0xFF;
+        memcpy(&zlib[pos], &raw[off], len);
+        pos += len, off += len;
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < RAW_LEN; i++)
+    {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    const uint32_t adler = b << 16 | a;
+    for (int i = 3; i >= 0; i--)
+        zlib[pos++] = adler >> (8 * i);
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        perror(path);
+        return -1;
+    }
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const uint8_t ihdr[13] = {
+        0, 0, WIDTH >> 8, WIDTH & 0xFF,
+        0, 0, HEIGHT >> 8, HEIGHT & 0xFF,
+        8, 2, 0, 0, 0, // 8 bit RGB, no interlace
+    };
+    fwrite(signature, 1, sizeof(signature), file);
+    png_chunk(file, "IHDR", ihdr, sizeof(ihdr));
+    png_chunk(file, "IDAT", zlib, pos);
+    png_chunk(file, "IEND", NULL, 0);
+    if (fclose(file))
+    {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+static uint8_t *file_load(const char *path, size_t max, size_t *len)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        perror(path);
+        return NULL;
+    }
+    uint8_t *data = calloc(1, max + 1);
+    *len = fread(data, 1, max + 1, file);
+    fclose(file);
+    if (*len > max)
+    {
+        fprintf(stderr, "%s: larger than %zu bytes\n", path, max);
+        free(data);
+        return NULL;
+    }
+    return data;
+}
+
+// Returns number of differing pixels, -1 if golden can not be read.
+static long png_compare(const char *path)
+{
+    size_t len;
+    uint8_t *png = file_load(path, 16 << 20, &len);
+    if (!png)
+        return -1;
+    static uint8_t idat[ZLIB_LEN];
+    size_t idat_len = 0;
+    bool ihdr_ok = false;
+    if (len < 8 || memcmp(png, "\x89PNG\r\n\x1A\n", 8))
+        goto bad;
+    for (size_t pos = 8; pos + 12 <= len;)
+    {
+        const uint32_t chunk_len = get32(&png[pos]);
+        const uint8_t *type = &png[pos + 4];
+        const uint8_t *data = &png[pos + 8];
+        if (chunk_len > len - pos - 12)
+            goto bad;
+        if (!memcmp(type, "IHDR", 4))
+            ihdr_ok = chunk_len == 13
+                      && get32(data) == WIDTH && get32(data + 4) == HEIGHT
+                      && data[8] == 8 && data[9] == 2 && data[12] == 0;
+        if (!memcmp(type, "IDAT", 4))
+        {
+            if (idat_len + chunk_len > sizeof(idat))
+                goto bad;
+            memcpy(&idat[idat_len], data, chunk_len);
+            idat_len += chunk_len;
+        }
+        pos += 12 + chunk_len;
+    }
+    if (!ihdr_ok || idat_len < 2)
+        goto bad;
+
+    static uint8_t raw[RAW_LEN];
+    size_t raw_len = 0;
+    size_t pos = 2;
+    for (bool final = false; !final;)
+    {
+        if (pos + 5 > idat_len || (idat[pos] & 0x06))
+            goto bad; // not a stored block
+        final = idat[pos] & 1;
+        const size_t block = idat[pos + 1] | idat[pos + 2] << 8;
+        pos += 5;
+        if (pos + block > idat_len || raw_len + block > RAW_LEN)
+            goto bad;
+        memcpy(&raw[raw_len], &idat[pos], block);
+        raw_len += block, pos += block;
+    }
+    if (raw_len != RAW_LEN)
+        goto bad;
+
+    long diff = 0;
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        if (raw[y * ROW_LEN])
+            goto bad; // filtered scanline
+        for (int x = 0; x < WIDTH; x++)
+            if (memcmp(&raw[y * ROW_LEN + 1 + x * 3], frame[y][x], 3) && !diff++)
+                printf("first difference at %d,%d\n", x, y);
+    }
+    free(png);
+    return diff;
+
+bad:
+    fprintf(stderr, "%s: not a %dx%d RGB PNG written by cgia_render\n", path, WIDTH, HEIGHT);
+    free(png);
+    return -1;
+}
+
+// Serve VRAM cache fills the way the RIA does over PIX.
+static void vcache_sync(void)
+{
+    cgia_task();
+    while (vcache_dma_state == VCACHE_DMA_REQUEST)
+    {
+        const uint8_t *bank = banks[PIX_DMA_REQ_BANK(vcache_dma_request)];
+        if (bank)
+            memcpy(vcache_dma_base, bank, 0x10000);
+        else
+            memset(vcache_dma_base, 0, 0x10000);
+        vcache_dma_state = VCACHE_DMA_IDLE;
+        cgia_task();
+    }
+}
+
+static void render_frame(void)
+{
+    static uint32_t linebuffer[LINE_BUFFER_LEN];
+    uint32_t *rgbbuf = linebuffer + LINE_BUFFER_PADDING;
+    for (uint16_t y = 0; y < HEIGHT; y++)
+    {
+        vcache_sync();
+        if (y == 0)
+            cgia_vbi();
+        memset(linebuffer, 0, sizeof(linebuffer));
+#ifdef CGIA_ENCODE_CYCLES
+        cgia_encode_cycles = 0;
+#endif
+        cgia_render(y, rgbbuf);
+#ifdef CGIA_ENCODE_CYCLES
+        line_cycles[y] = cgia_encode_cycles;
+#endif
+        for (int x = 0; x < WIDTH; x++)
+        {
+            frame[y][x][0] = rgbbuf[x];
+            frame[y][x][1] = rgbbuf[x] >> 8;
+            frame[y][x][2] = rgbbuf[x] >> 16;
+        }
+    }
+}
+
+static void print_cycles(void)
+{
+#ifdef CGIA_ENCODE_CYCLES
+    const uint32_t budget = SYS_CLK_HZ / MODE_V_FREQ_HZ / MODE_V_TOTAL_LINES * FB_V_REPEAT;
+    uint64_t total = 0;
+    int worst = 0;
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        total += line_cycles[y];
+        if (line_cycles[y] > line_cycles[worst])
+            worst = y;
+    }
+    printf("encode cycles/line: avg %u, max %u on line %d, budget %u (%u%% used)\n",
+           (unsigned)(total / HEIGHT), line_cycles[worst], worst, budget,
+           (unsigned)(100ull * line_cycles[worst] / budget));
+#else
+    (void)line_cycles;
+#endif
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-f frames] [-o out.png] [-g golden.png] regs.bin [BB=bank.bin]...\n", name);
+    fprintf(stderr, "       %s -t\n", name);
+}
+
+static void sprite_put(uint8_t *bank, uint16_t offset, int16_t pos_y, uint16_t lines_y,
+                       uint16_t next_dsc_offset)
+{
+    const struct cgia_sprite_t sprite = {
+        .pos_x = 16,
+        .pos_y = pos_y,
+        .lines_y = lines_y,
+        .color = {1, 2, 3},
+        .data_offset = 0x1000,
+        .next_dsc_offset = next_dsc_offset,
+    };
+    memcpy(&bank[offset], &sprite, sizeof(sprite));
+}
+
+// Sprite plane 0 with its table at the start of bank 0:
+// 0 - parked below the screen, chained to itself
+// 1 - on lines 10-17, chained to itself
+// 2 - on lines 50-53, chained to lines 100-103 and back
+// 3 - parked far below, its chain never ends
+static int sprite_case(void)
+{
+    uint8_t *bank = banks[0] = calloc(1, 0x10000);
+    const size_t dsc = sizeof(struct cgia_sprite_t);
+    sprite_put(bank, 0 * dsc, HEIGHT + 60, 8, 0 * dsc);
+    sprite_put(bank, 1 * dsc, 10, 8, 1 * dsc);
+    sprite_put(bank, 2 * dsc, 50, 4, 0x100);
+    sprite_put(bank, 0x100, 100, 4, 2 * dsc);
+    sprite_put(bank, 3 * dsc, INT16_MAX - 4, UINT16_MAX, 3 * dsc);
+    memset(&bank[0x1000], 0xFF, 0x100);
+
+    cgia_init();
+    cgia_reg_write(CGIA_REG_SPRITE_BANK, 0);
+    cgia_reg_write(CGIA_REG_OFFSET, 0);
+    cgia_reg_write(CGIA_REG_OFFSET + 1, 0);
+    cgia_reg_write(CGIA_REG_PLANE + offsetof(struct cgia_sprite_regs, active), 0x0F);
+    cgia_reg_write(CGIA_REG_PLANES, 0x11);
+    for (int f = 0; f < 2; f++)
+        render_frame();
+
+    int bad = 0;
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        const bool shown = (y >= 10 && y < 18) || (y >= 50 && y < 54) || (y >= 100 && y < 104);
+        bool drawn = false;
+        for (int x = 0; x < WIDTH; x++)
+            drawn |= memcmp(frame[y][x], frame[0][0], 3) != 0;
+        if (drawn != shown && !bad++)
+            printf("sprite line %d %s\n", y, drawn ? "drawn" : "missing");
+    }
+    printf("sprite case %s\n", bad ? "FAILED" : "passed");
+    return bad ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *out_path = NULL;
+    const char *golden_path = NULL;
+    long frames = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:o:g:t")) != -1)
+    {
+        switch (opt)
+        {
+        case 't':
+            return sprite_case();
+        case 'f':
+            frames = strtol(optarg, NULL, 0);
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'g':
+            golden_path = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || frames < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    crc_init();
+
+    size_t len;
+    uint8_t *regs = file_load(argv[optind], 128, &len);
+    if (!regs)
+        return 1;
+    for (int i = optind + 1; i < argc; i++)
+    {
+        char *path;
+        const long bank = strtol(argv[i], &path, 16);
+        if (*path != '=' || bank < 0 || bank > 255)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        free(banks[bank]);
+        if (!(banks[bank] = file_load(path + 1, 0x10000, &len)))
+            return 1;
+    }
+
+    cgia_init();
+    for (size_t r = 0; r < 128; r++)
+        cgia_reg_write(r, regs[r]);
+    while (frames--)
+        render_frame();
+    print_cycles();
+
+    if (out_path && png_write(out_path))
+        return 1;
+    if (golden_path)
+    {
+        const long diff = png_compare(golden_path);
+        if (diff < 0)
+            return 1;
+        if (diff)
+        {
+            printf("%ld pixels differ from %s\n", diff, golden_path);
+            return 1;
+        }
+        printf("matches %s\n", golden_path);
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_DMA_H_
+#define _HOST_HARDWARE_DMA_H_
+
+/* DMA channels that complete a transfer the moment it is triggered.
+ * Chaining and rings are accepted but not modelled.
+ */
+
+#include "pico.h"
+
+#include <string.h>
+
+#define NUM_DMA_CHANNELS 16
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2,
+};
+
+typedef struct
+{
+    enum dma_channel_transfer_size size;
+    bool read_increment;
+    bool write_increment;
+} dma_channel_config;
+
+typedef struct
+{
+    uint32_t al3_transfer_count;
+} dma_channel_hw_t;
+
+typedef struct
+{
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+struct host_dma_channel
+{
+    bool claimed;
+    dma_channel_config config;
+    const void *read_addr;
+    void *write_addr;
+    uint32_t transfer_count;
+};
+
+// defined by the host program
+extern dma_hw_t host_dma_hw;
+extern struct host_dma_channel host_dma_channels[NUM_DMA_CHANNELS];
+
+#define dma_hw (&host_dma_hw)
+
+static inline int dma_claim_unused_channel(bool required)
+{
+    (void)required;
+    for (int ch = 0; ch < NUM_DMA_CHANNELS; ++ch)
+        if (!host_dma_channels[ch].claimed)
+        {
+            host_dma_channels[ch].claimed = true;
+            return ch;
+        }
+    return -1;
+}
+
+static inline dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    (void)channel;
+    dma_channel_config c = {DMA_SIZE_32, true, false};
+    return c;
+}
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    c->size = size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    c->read_increment = incr;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    c->write_increment = incr;
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+    (void)c, (void)write, (void)size_bits;
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to)
+{
+    (void)c, (void)chain_to;
+}
+
+static inline void host_dma_run(uint channel)
+{
+    struct host_dma_channel *ch = &host_dma_channels[channel];
+    const size_t size = 1u << ch->config.size;
+    const uint8_t *read = ch->read_addr;
+    uint8_t *write = ch->write_addr;
+    for (uint32_t i = 0; i < ch->transfer_count; ++i)
+    {
+        memcpy(write, read, size);
+        if (ch->config.read_increment)
+            read += size;
+        if (ch->config.write_increment)
+            write += size;
+    }
+}
+
+static inline void dma_channel_configure(uint channel, const dma_channel_config *config,
+                                         volatile void *write_addr, const volatile void *read_addr,
+                                         uint transfer_count, bool trigger)
+{
+    struct host_dma_channel *ch = &host_dma_channels[channel];
+    ch->config = *config;
+    ch->write_addr = (void *)write_addr;
+    ch->read_addr = (const void *)read_addr;
+    ch->transfer_count = transfer_count;
+    if (trigger)
+        host_dma_run(channel);
+}
+
+static inline void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+    host_dma_channels[channel].read_addr = (const void *)read_addr;
+    if (trigger)
+        host_dma_run(channel);
+}
+
+static inline void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger)
+{
+    host_dma_channels[channel].write_addr = (void *)write_addr;
+    if (trigger)
+        host_dma_run(channel);
+}
+
+static inline void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger)
+{
+    host_dma_channels[channel].transfer_count = trans_count;
+    if (trigger)
+        host_dma_run(channel);
+}
+
+static inline void dma_channel_wait_for_finish_blocking(uint channel)
+{
+    (void)channel;
+}
+
+#endif /* _HOST_HARDWARE_DMA_H_ */
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_INTERP_H_
+#define _HOST_HARDWARE_INTERP_H_
+
+/* Software model of the SIO interpolators.
+ * Lanes are pointer wide, so scan pointers into host memory survive
+ * add-raw lanes and the full result base. Shift and mask see the low
+ * 32 bits like the hardware does. Blend and clamp are not modelled,
+ * CGIA does not use them.
+ */
+
+#include "pico.h"
+
+#define INTERP_CTRL_SHIFT_LSB    0
+#define INTERP_CTRL_MASK_LSB_LSB 5
+#define INTERP_CTRL_MASK_MSB_LSB 10
+#define INTERP_CTRL_SIGNED       (1u << 15)
+#define INTERP_CTRL_CROSS_INPUT  (1u << 16)
+#define INTERP_CTRL_CROSS_RESULT (1u << 17)
+#define INTERP_CTRL_ADD_RAW      (1u << 18)
+
+typedef struct
+{
+    uintptr_t accum[2];
+    uintptr_t base[3];
+    uint32_t ctrl[2];
+} interp_hw_t;
+
+typedef interp_hw_t interp_hw_save_t;
+
+typedef struct
+{
+    uint32_t ctrl;
+} interp_config;
+
+// defined by the host program
+extern interp_hw_t host_interp_hw[2];
+
+#define interp0 (&host_interp_hw[0])
+#define interp1 (&host_interp_hw[1])
+
+static inline interp_config interp_default_config(void)
+{
+    interp_config c = {31u << INTERP_CTRL_MASK_MSB_LSB};
+    return c;
+}
+
+static inline void interp_config_set_shift(interp_config *c, uint shift)
+{
+    c->ctrl = (c->ctrl & ~(0x1Fu << INTERP_CTRL_SHIFT_LSB)) | (shift & 0x1F) << INTERP_CTRL_SHIFT_LSB;
+}
+
+static inline void interp_config_set_mask(interp_config *c, uint mask_lsb, uint mask_msb)
+{
+    c->ctrl = (c->ctrl & ~(0x3FFu << INTERP_CTRL_MASK_LSB_LSB))
+              | (mask_lsb & 0x1F) << INTERP_CTRL_MASK_LSB_LSB
+              | (mask_msb & 0x1F) << INTERP_CTRL_MASK_MSB_LSB;
+}
+
+static inline void interp_config_set_signed(interp_config *c, bool _signed)
+{
+    c->ctrl = _signed ? c->ctrl | INTERP_CTRL_SIGNED : c->ctrl & ~INTERP_CTRL_SIGNED;
+}
+
+static inline void interp_config_set_cross_input(interp_config *c, bool cross_input)
+{
+    c->ctrl = cross_input ? c->ctrl | INTERP_CTRL_CROSS_INPUT : c->ctrl & ~INTERP_CTRL_CROSS_INPUT;
+}
+
+static inline void interp_config_set_cross_result(interp_config *c, bool cross_result)
+{
+    c->ctrl = cross_result ? c->ctrl | INTERP_CTRL_CROSS_RESULT : c->ctrl & ~INTERP_CTRL_CROSS_RESULT;
+}
+
+static inline void interp_config_set_add_raw(interp_config *c, bool add_raw)
+{
+    c->ctrl = add_raw ? c->ctrl | INTERP_CTRL_ADD_RAW : c->ctrl & ~INTERP_CTRL_ADD_RAW;
+}
+
+static inline void interp_set_config(interp_hw_t *interp, uint lane, interp_config *config)
+{
+    interp->ctrl[lane] = config->ctrl;
+}
+
+static inline void interp_set_base(interp_hw_t *interp, uint lane, uintptr_t val)
+{
+    interp->base[lane] = val;
+}
+
+static inline void interp_set_accumulator(interp_hw_t *interp, uint lane, uintptr_t val)
+{
+    interp->accum[lane] = val;
+}
+
+static inline uintptr_t interp_get_accumulator(interp_hw_t *interp, uint lane)
+{
+    return interp->accum[lane];
+}
+
+static inline void interp_save(interp_hw_t *interp, interp_hw_save_t *saver)
+{
+    *saver = *interp;
+}
+
+static inline void interp_restore(interp_hw_t *interp, interp_hw_save_t *saver)
+{
+    *interp = *saver;
+}
+
+// Shifted and masked lane input, before the base is added.
+static inline uintptr_t host_interp_masked(const interp_hw_t *interp, uint lane)
+{
+    const uint32_t ctrl = interp->ctrl[lane];
+    const uintptr_t input = interp->accum[ctrl & INTERP_CTRL_CROSS_INPUT ? !lane : lane];
+    const uint shift = (ctrl >> INTERP_CTRL_SHIFT_LSB) & 0x1F;
+    const uint lsb = (ctrl >> INTERP_CTRL_MASK_LSB_LSB) & 0x1F;
+    const uint msb = (ctrl >> INTERP_CTRL_MASK_MSB_LSB) & 0x1F;
+    const uint32_t mask = (uint32_t)((2ull << msb) - (1ull << lsb));
+    const uint32_t masked = (uint32_t)(input >> shift) & mask;
+    if ((ctrl & INTERP_CTRL_SIGNED) && (masked & (1u << msb)))
+        return (uintptr_t)(intptr_t)(int32_t)(masked | ~(uint32_t)((2ull << msb) - 1));
+    return masked;
+}
+
+static inline uintptr_t host_interp_lane(const interp_hw_t *interp, uint lane)
+{
+    const uint32_t ctrl = interp->ctrl[lane];
+    const uintptr_t input = interp->accum[ctrl & INTERP_CTRL_CROSS_INPUT ? !lane : lane];
+    return (ctrl & INTERP_CTRL_ADD_RAW ? input : host_interp_masked(interp, lane))
+           + interp->base[lane];
+}
+
+static inline uintptr_t host_interp_full(const interp_hw_t *interp)
+{
+    return interp->base[2] + host_interp_masked(interp, 0) + host_interp_masked(interp, 1);
+}
+
+// Popping any result writes both lane results back to the accumulators.
+static inline void host_interp_pop(interp_hw_t *interp)
+{
+    const uintptr_t result[2] = {host_interp_lane(interp, 0), host_interp_lane(interp, 1)};
+    interp->accum[0] = result[interp->ctrl[0] & INTERP_CTRL_CROSS_RESULT ? 1 : 0];
+    interp->accum[1] = result[interp->ctrl[1] & INTERP_CTRL_CROSS_RESULT ? 0 : 1];
+}
+
+static inline uintptr_t interp_peek_lane_result(interp_hw_t *interp, uint lane)
+{
+    return host_interp_lane(interp, lane);
+}
+
+static inline uintptr_t interp_pop_lane_result(interp_hw_t *interp, uint lane)
+{
+    const uintptr_t result = host_interp_lane(interp, lane);
+    host_interp_pop(interp);
+    return result;
+}
+
+static inline uintptr_t interp_peek_full_result(interp_hw_t *interp)
+{
+    return host_interp_full(interp);
+}
+
+static inline uintptr_t interp_pop_full_result(interp_hw_t *interp)
+{
+    const uintptr_t result = host_interp_full(interp);
+    host_interp_pop(interp);
+    return result;
+}
+
+#endif /* _HOST_HARDWARE_INTERP_H_ */
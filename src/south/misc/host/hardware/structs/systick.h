@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_HARDWARE_STRUCTS_SYSTICK_H_
+#define _HOST_HARDWARE_STRUCTS_SYSTICK_H_
+
+/* SysTick registers for sys/prf.h. Nothing counts on the host.
+ */
+
+#include "pico.h"
+
+typedef struct
+{
+    volatile uint32_t csr;
+    volatile uint32_t rvr;
+    volatile uint32_t cvr;
+    volatile uint32_t calib;
+} systick_hw_t;
+
+#define M33_SYST_CSR_CLKSOURCE_BITS 0x00000004
+#define M33_SYST_CSR_ENABLE_BITS    0x00000001
+
+extern systick_hw_t host_systick_hw;
+#define systick_hw (&host_systick_hw)
+
+#endif /* _HOST_HARDWARE_STRUCTS_SYSTICK_H_ */
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HOST_PICO_H_
+#define _HOST_PICO_H_
+
+/* Just enough of the Pico SDK to build cgia.c and cgia_encode.c
+ * on a Linux box, see misc/cgia_render.c. Hardware state the
+ * models keep is defined there.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define PICO_SDK_VERSION_MAJOR 2
+
+#define __not_in_flash_func(func_name) func_name
+#define __scratch_x(section_name)
+#define __scratch_y(section_name)
+
+static inline uint get_core_num(void)
+{
+    return 0;
+}
+
+#endif /* _HOST_PICO_H_ */
@@ -6,17 +6,88 @@
 
 #include "./aud.h"
 #include "./out.h"
+#include "./pix.h"
 #include "aud.pio.h"
 #include "hw.h"
+#include "sgr.h"
 
 #include <hardware/clocks.h>
+#include <hardware/dma.h>
 #include <hardware/gpio.h>
 #include <hardware/pio.h>
 #include <hardware/spi.h>
+#include <pico/time.h>
 #include <pico/types.h>
 #include <stdio.h>
 
 #define SPI_READ_BIT 0x8000
+#define SPI_BULK_BIT 0x4000
+
+#define SPI_PCM_ADDR_L   0x0000
+#define SPI_PCM_ADDR_H   0x0100
+#define SPI_PCM_BYTE     0x0200
+#define SPI_PCM_HALVES   0x0300
+#define SPI_PLAY_END_L   0x0400
+#define SPI_PLAY_END_H   0x0500
+#define SPI_PLAY_STOP    0x0600
+#define SPI_REG_BURST    0x1000
+#define SPI_PCM_DATA     0x2000
+#define SPI_PCM_DATA_MAX 0x2000 // words per data command
+
+// Bursts and PCM data go by DMA on the SGU-1,
+// faster than it handles single words.
+#ifndef AUD_BULK_BAUDRATE_HZ
+#define AUD_BULK_BAUDRATE_HZ 16000000
+#endif
+// Pause after a burst or data command, for the SGU-1 to start its DMA.
+// Longer than its sample interrupt that holds off the SPI one.
+#define AUD_BULK_ARM_US 12
+
+// Register writes are combined into bursts of runs, a header word
+// [count-1 << 8 | start] and values, two per word, low byte first.
+// A burst goes when the CPU has not written for AUD_BURST_IDLE_US,
+// so a music driver tick reaches the SGU-1 in one piece.
+#define AUD_BURST_WORDS 128
+#ifndef AUD_BURST_IDLE_US
+#define AUD_BURST_IDLE_US 50
+#endif
+
+static uint16_t aud_burst[2][AUD_BURST_WORDS];
+static uint8_t aud_burst_buf; // being filled, the other one may be sending
+static uint8_t aud_burst_len;
+static uint8_t aud_burst_run; // header of the last run
+static uint32_t aud_burst_time;
+static int aud_spi_dma_chan;
+
+// Channels with the PCM stream flag in their flags1 register are
+// polled for the ring halves they played, so is the register stream
+// player. Each new one is a refill the RIA is asked for, with the
+// next PIX ACK.
+#define AUD_CHANNELS          9
+#define AUD_PLAYER            PIX_SPU_PLAY_CHAN
+#define AUD_STREAMS           (AUD_PLAYER + 1)
+#define AUD_REG_CHAN          0x3F
+#define AUD_REG_FLAGS0        0x24
+#define AUD_REG_FLAGS1        0x25
+#define AUD_FLAGS1_PCM_STREAM 0x80
+
+static uint8_t aud_chan;
+static uint16_t aud_stream_mask;
+static uint8_t aud_stream_asked[AUD_STREAMS]; // halves refills were asked for
+static uint8_t aud_stream_next;
+volatile uint16_t aud_pcm_response;
+
+// Register writes are recorded as a register stream (see sgr.h),
+// timed by the microsecond clock, into a ring the RIA drains.
+// Running out of room stops the recording.
+#define AUD_REC_SIZE 4096
+
+static uint8_t aud_rec[AUD_REC_SIZE];
+static uint16_t aud_rec_head;
+static uint16_t aud_rec_tail;
+static bool aud_rec_on;
+static bool aud_rec_lost;
+static uint64_t aud_rec_sample; // recorded up to
 
 #define USE_MIRROR_REGS (1)
 #if USE_MIRROR_REGS
@@ -24,6 +95,83 @@ static uint8_t reg_bank = 0;
 static uint8_t reg_mirror[10 * 64] = {0};
 #endif
 
+// Wait for the last burst to leave.
+static void aud_spi_wait(void)
+{
+    while (dma_channel_is_busy(aud_spi_dma_chan) || spi_is_busy(AUD_SPI))
+        tight_loop_contents();
+    // drop what the SGU-1 shifted back meanwhile
+    while (spi_is_readable(AUD_SPI))
+        (void)spi_get_hw(AUD_SPI)->dr;
+    spi_get_hw(AUD_SPI)->icr = SPI_SSPICR_RORIC_BITS;
+}
+
+// Called from PIX requests or with them held off.
+static void aud_burst_send(void)
+{
+    aud_spi_wait();
+    const uint16_t packet = SPI_BULK_BIT | SPI_REG_BURST | (aud_burst_len - 1);
+    spi_write16_blocking(AUD_SPI, &packet, 1);
+    busy_wait_us_32(AUD_BULK_ARM_US);
+    dma_channel_transfer_from_buffer_now(aud_spi_dma_chan, aud_burst[aud_burst_buf], aud_burst_len);
+    aud_burst_buf ^= 1;
+    aud_burst_len = 0;
+}
+
+static void aud_burst_put(uint8_t reg, uint8_t data)
+{
+    uint16_t *burst = aud_burst[aud_burst_buf];
+    if (aud_burst_len)
+    {
+        uint16_t *run = &burst[aud_burst_run];
+        const uint count = (*run >> 8) + 1;
+        if (reg == ((*run + count) & 0x3F) && count < 64)
+        {
+            if (count & 1)
+            {
+                burst[aud_burst_len - 1] |= (uint16_t)(data << 8);
+                *run += 0x100;
+                return;
+            }
+            if (aud_burst_len < AUD_BURST_WORDS)
+            {
+                burst[aud_burst_len++] = data;
+                *run += 0x100;
+                return;
+            }
+        }
+        if (aud_burst_len + 2 > AUD_BURST_WORDS)
+        {
+            aud_burst_send();
+            burst = aud_burst[aud_burst_buf];
+        }
+    }
+    aud_burst_run = aud_burst_len;
+    burst[aud_burst_len++] = reg;
+    burst[aud_burst_len++] = data;
+}
+
+// The SGU-1 answers from its IRQ handler, give it time.
+// Called from PIX requests or with them held off.
+static bool aud_spi_read(uint16_t packet, uint8_t *data)
+{
+    if (aud_burst_len)
+        aud_burst_send();
+    aud_spi_wait();
+    spi_set_baudrate(AUD_SPI, AUD_BAUDRATE_HZ);
+    int retries = 10;
+    uint16_t response = 0;
+    while (retries-- > 0)
+    {
+        spi_write16_read16_blocking(AUD_SPI, &packet, &response, 1);
+        if ((response & 0xFF00) == (packet & 0xFF00))
+            break;
+    }
+    spi_set_baudrate(AUD_SPI, AUD_BULK_BAUDRATE_HZ);
+    *data = (uint8_t)response;
+    return retries >= 0;
+}
+
 uint8_t aud_read_register(uint8_t reg)
 {
 #if USE_MIRROR_REGS
@@ -36,16 +184,94 @@ uint8_t aud_read_register(uint8_t reg)
         return reg_mirror[reg_bank * 64 + (reg & 0x3F)];
     }
 #endif
-    uint16_t packet = (uint16_t)(SPI_READ_BIT | ((uint16_t)(reg & 0x3F) << 8));
-    int retries = 10;
-    uint16_t response = 0;
-    while (retries-- > 0)
+    uint8_t data;
+    if (!aud_spi_read((uint16_t)(SPI_READ_BIT | ((uint16_t)(reg & 0x3F) << 8)), &data))
+        return 0xFF;
+    return data;
+}
+
+// The SGU-1 zeroes the halves count when the stream flag goes up.
+static void aud_stream_flag(uint8_t chan, bool stream)
+{
+    const uint16_t bit = 1u << chan;
+    if (stream && !(aud_stream_mask & bit))
+        aud_stream_asked[chan] = 0;
+    if (stream)
+        aud_stream_mask |= bit;
+    else
+        aud_stream_mask &= ~bit;
+}
+
+static uint64_t aud_rec_now(void)
+{
+    return time_us_64() * SGR_SAMPLE_RATE / 1000000;
+}
+
+static void aud_rec_put(const uint8_t *bytes, uint len)
+{
+    const uint room = (aud_rec_tail - aud_rec_head - 1u) & (AUD_REC_SIZE - 1);
+    if (len > room)
     {
-        spi_write16_read16_blocking(AUD_SPI, &packet, &response, 1);
-        if ((response & 0xFF00) == (packet & 0xFF00))
-            return (uint8_t)(response);
+        aud_rec_on = false;
+        aud_rec_lost = true;
+        return;
+    }
+    while (len--)
+    {
+        aud_rec[aud_rec_head] = *bytes++;
+        aud_rec_head = (aud_rec_head + 1) & (AUD_REC_SIZE - 1);
     }
-    return 0xFF;
+}
+
+static void aud_rec_write(uint8_t reg, uint8_t data)
+{
+    const uint64_t now = aud_rec_now();
+    while (aud_rec_on && now > aud_rec_sample)
+    {
+        uint32_t wait = now - aud_rec_sample > SGR_WAIT_LONG_MAX
+                            ? SGR_WAIT_LONG_MAX
+                            : (uint32_t)(now - aud_rec_sample);
+        aud_rec_sample += wait--;
+        if (wait < SGR_WAIT_SHORT_MAX)
+            aud_rec_put((uint8_t[]) {SGR_WAIT_SHORT | wait}, 1);
+        else
+            aud_rec_put((uint8_t[]) {SGR_WAIT_LONG, (uint8_t)wait, (uint8_t)(wait >> 8)}, 3);
+    }
+    if (aud_rec_on)
+        aud_rec_put((uint8_t[]) {reg, data}, 2);
+}
+
+void aud_rec_start(bool start)
+{
+    aud_rec_on = false;
+    if (!start)
+        return;
+    aud_rec_head = aud_rec_tail = 0;
+    aud_rec_lost = false;
+    aud_rec_sample = aud_rec_now();
+    aud_rec_on = true;
+#if USE_MIRROR_REGS
+    // Registers as they are, flags0 last to key on the
+    // channels playing with everything else in place.
+    for (uint8_t chan = 0; chan < AUD_CHANNELS; ++chan)
+    {
+        aud_rec_write(AUD_REG_CHAN, chan);
+        for (uint8_t reg = 0; reg < AUD_REG_CHAN; ++reg)
+            if (reg != AUD_REG_FLAGS0)
+                aud_rec_write(reg, reg_mirror[chan * 64 + reg]);
+        aud_rec_write(AUD_REG_FLAGS0, reg_mirror[chan * 64 + AUD_REG_FLAGS0]);
+    }
+#endif
+    aud_rec_write(AUD_REG_CHAN, aud_chan);
+}
+
+uint16_t aud_rec_read(void)
+{
+    if (aud_rec_tail == aud_rec_head)
+        return aud_rec_lost ? PIX_SPU_REC_LOST : 0;
+    const uint8_t data = aud_rec[aud_rec_tail];
+    aud_rec_tail = (aud_rec_tail + 1) & (AUD_REC_SIZE - 1);
+    return PIX_SPU_REC_BYTE | data;
 }
 
 void aud_write_register(uint8_t reg, uint8_t data)
@@ -61,10 +287,82 @@ void aud_write_register(uint8_t reg, uint8_t data)
         reg_mirror[reg_bank * 64 + (reg & 0x3F)] = data;
     }
 #endif
-    uint16_t packet = (uint16_t)(((uint16_t)(reg & 0x3F) << 8) | data);
+    if ((reg & 0x3F) == AUD_REG_CHAN)
+        aud_chan = data % AUD_CHANNELS;
+    else if ((reg & 0x3F) == AUD_REG_FLAGS1)
+        aud_stream_flag(aud_chan, data & AUD_FLAGS1_PCM_STREAM);
+    if (aud_rec_on)
+        aud_rec_write(reg & 0x3F, data);
+    aud_burst_put(reg & 0x3F, data);
+    aud_burst_time = time_us_32();
+}
+
+static inline void aud_write_pcm_command(uint16_t command)
+{
+    const uint16_t packet = SPI_BULK_BIT | command;
     spi_write16_blocking(AUD_SPI, &packet, 1);
 }
 
+void aud_write_pcm(uint16_t addr, const uint8_t *data, size_t len)
+{
+    if (!len)
+        return;
+    // registers written before go first
+    if (aud_burst_len)
+        aud_burst_send();
+    aud_spi_wait();
+    aud_write_pcm_command(SPI_PCM_ADDR_L | (addr & 0xFF));
+    aud_write_pcm_command(SPI_PCM_ADDR_H | (addr >> 8));
+    while (len)
+    {
+        if ((addr & 1) || len == 1)
+        {
+            aud_write_pcm_command(SPI_PCM_BYTE | *data++);
+            ++addr, --len;
+            continue;
+        }
+        // Even pointer and no wrap keep the SGU-1 on the DMA path.
+        uint32_t words = len / 2;
+        if (words > (0x10000u - addr) / 2)
+            words = (0x10000u - addr) / 2;
+        if (words > SPI_PCM_DATA_MAX)
+            words = SPI_PCM_DATA_MAX;
+        aud_write_pcm_command(SPI_PCM_DATA | (uint16_t)(words - 1));
+        busy_wait_us_32(AUD_BULK_ARM_US);
+        addr += words * 2;
+        len -= words * 2;
+        while (words)
+        {
+            uint16_t packet[16];
+            const uint32_t run = words < 16 ? words : 16;
+            for (uint32_t i = 0; i < run; ++i, data += 2)
+                packet[i] = (uint16_t)(data[0] | data[1] << 8);
+            spi_write16_blocking(AUD_SPI, packet, run);
+            words -= run;
+        }
+    }
+}
+
+void aud_play(uint16_t ring, uint16_t size)
+{
+    if (aud_burst_len)
+        aud_burst_send();
+    aud_spi_wait();
+    if (!size)
+    {
+        aud_write_pcm_command(SPI_PLAY_STOP);
+        aud_stream_mask &= ~(1u << AUD_PLAYER);
+        return;
+    }
+    const uint32_t end = (uint32_t)ring + size;
+    aud_write_pcm_command(SPI_PCM_ADDR_L | (ring & 0xFF));
+    aud_write_pcm_command(SPI_PCM_ADDR_H | (ring >> 8));
+    aud_write_pcm_command(SPI_PLAY_END_L | (end & 0xFF));
+    aud_write_pcm_command(SPI_PLAY_END_H | ((end >> 8) & 0xFF));
+    aud_stream_asked[AUD_PLAYER] = 0;
+    aud_stream_mask |= 1u << AUD_PLAYER;
+}
+
 static void aud_i2s_rx_irq_handler()
 {
     // PIO packs stereo into one 32-bit word: (left << 16) | right.
@@ -139,13 +437,28 @@ void aud_init(void)
 #endif
 
     // Configure SPI communication
-    spi_init(AUD_SPI, AUD_BAUDRATE_HZ);
+    spi_init(AUD_SPI, AUD_BULK_BAUDRATE_HZ);
     spi_set_format(AUD_SPI, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
     gpio_set_function(AUD_SPI_RX_PIN, GPIO_FUNC_SPI);
     gpio_set_function(AUD_SPI_SCK_PIN, GPIO_FUNC_SPI);
     gpio_set_function(AUD_SPI_TX_PIN, GPIO_FUNC_SPI);
     gpio_set_function(AUD_SPI_CS_PIN, GPIO_FUNC_SPI);
 
+    // DMA for register bursts
+    aud_spi_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config dma_config = dma_channel_get_default_config(aud_spi_dma_chan);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&dma_config, true);
+    channel_config_set_write_increment(&dma_config, false);
+    channel_config_set_dreq(&dma_config, spi_get_dreq(AUD_SPI, true));
+    dma_channel_configure(
+        aud_spi_dma_chan,
+        &dma_config,
+        &spi_get_hw(AUD_SPI)->dr,
+        aud_burst[0],
+        0,
+        false);
+
     aud_i2s_pio_init();
 }
 
@@ -163,6 +476,35 @@ static void aud_dump_registers(void)
 
 void aud_task(void)
 {
+    if (!aud_burst_len
+        || time_us_32() - aud_burst_time < AUD_BURST_IDLE_US
+        || dma_channel_is_busy(aud_spi_dma_chan))
+        return;
+    pix_hold(true);
+    if (aud_burst_len)
+        aud_burst_send();
+    pix_hold(false);
+}
+
+void aud_stream_task(void)
+{
+    if (!aud_stream_mask || aud_pcm_response)
+        return;
+    pix_hold(true);
+    // one refill at a time, channels take turns
+    for (uint i = 0; i < AUD_STREAMS && !aud_pcm_response; ++i)
+    {
+        const uint8_t chan = aud_stream_next;
+        aud_stream_next = (uint8_t)((chan + 1) % AUD_STREAMS);
+        uint8_t halves;
+        if (!(aud_stream_mask & (1u << chan))
+            || !aud_spi_read(SPI_BULK_BIT | SPI_PCM_HALVES | chan, &halves)
+            || halves == aud_stream_asked[chan])
+            continue;
+        aud_pcm_response = PIX_RESPONSE(PIX_PCM_REQ, PIX_PCM_REQ_PAYLOAD(chan, aud_stream_asked[chan] & 1));
+        ++aud_stream_asked[chan];
+    }
+    pix_hold(false);
 }
 
 void aud_print_status(void)
@@ -10,6 +10,7 @@
 /* Audio chip communication over SPI
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -18,10 +19,25 @@
 
 void aud_init(void);
 void aud_task(void);
+void aud_stream_task(void);
 
 void aud_print_status(void);
 
 uint8_t aud_read_register(uint8_t reg);
 void aud_write_register(uint8_t reg, uint8_t data);
 
+// Bulk write to the SGU-1 PCM RAM, wrapping at its end.
+void aud_write_pcm(uint16_t addr, const uint8_t *data, size_t len);
+
+// Register stream recording, see sgr.h. Reads answer
+// PIX_SPU_CMD_REC_READ.
+void aud_rec_start(bool start);
+uint16_t aud_rec_read(void);
+
+// Register stream player on a PCM RAM ring, size 0 stops it.
+void aud_play(uint16_t ring, uint16_t size);
+
+// PIX_PCM_REQ response for the next ACK to carry, 0 when none.
+extern volatile uint16_t aud_pcm_response;
+
 #endif /* _SB_SYS_AUD_H_ */
@@ -7,6 +7,7 @@
 #include "sys/out.h"
 #include "cgia/cgia.h"
 #include "hw.h"
+#include "sys/prf.h"
 #include "term/term.h"
 #include <hardware/clocks.h>
 #include <hardware/dma.h>
@@ -29,7 +30,11 @@
 // ----------------------------------------------------------------------------
 #define LINE_BUFFER_PADDING (-SCHAR_MIN) // maximum scroll of signed 8 bit
 // RGB line buffers
-#define RGB_LINE_BUFFERS    2
+#if OUT_DUAL_CORE
+#define RGB_LINE_BUFFERS 4 // ring indexed by raster line
+#else
+#define RGB_LINE_BUFFERS 2
+#endif
 #define RGB_LINE_BUFFER_LEN (MODE_H_ACTIVE_PIXELS + 2 * LINE_BUFFER_PADDING)
 static uint32_t linebuffer[RGB_LINE_BUFFER_LEN * RGB_LINE_BUFFERS];
 
@@ -208,6 +213,17 @@ static uint32_t build_line_with_di(uint32_t *buf, const uint32_t *di_words,
     return (uint32_t)(p - buf);
 }
 
+#if OUT_DUAL_CORE
+// Lines are rendered this many rasters ahead of the beam.
+#define OUT_RENDER_AHEAD   2
+#define MODE_V_BLANK_LINES (MODE_V_FRONT_PORCH + MODE_V_SYNC_WIDTH + MODE_V_BACK_PORCH)
+
+static inline uint32_t *out_line_buffer(uint16_t raster)
+{
+    return linebuffer + LINE_BUFFER_PADDING + (raster % RGB_LINE_BUFFERS) * RGB_LINE_BUFFER_LEN;
+}
+#endif
+
 // ----------------------------------------------------------------------------
 // DMA logic
 
@@ -358,6 +374,9 @@ void __isr dma_irq_handler(void)
     else
     {
         // Active video: pixel data
+#if OUT_DUAL_CORE
+        ch->read_addr = (uintptr_t)out_line_buffer(a_scanline / FB_V_REPEAT);
+#else
         if (a_scanline >= gen_scanline && cur_scanline != gen_scanline)
         {
             cur_scanline = gen_scanline;
@@ -366,6 +385,7 @@ void __isr dma_irq_handler(void)
             gen_line_ptr = ptr;
         }
         ch->read_addr = cur_line_ptr;
+#endif
         ch->transfer_count = MODE_H_ACTIVE_PIXELS >> (active_mode == OUT_MODE_CGIA ? 1 : 0);
         vactive_cmdlist_posted = false;
 
@@ -445,6 +465,74 @@ void out_audio_submit(int16_t left, int16_t right)
     }
 }
 
+// ----------------------------------------------------------------------------
+// Dual core rendering
+
+#if OUT_DUAL_CORE
+// Next raster line each core has to process.
+static uint16_t next_raster[2];
+
+// Raster line that should be rendering now, or UINT16_MAX.
+static inline uint16_t out_render_raster(void)
+{
+    const int line = (int)*(volatile uint *)&v_scanline - MODE_V_BLANK_LINES
+                     + OUT_RENDER_AHEAD * FB_V_REPEAT;
+    if (line < 0)
+        return UINT16_MAX;
+    const uint raster = line / FB_V_REPEAT;
+    return raster < MODE_V_ACTIVE_LINES / FB_V_REPEAT ? raster : UINT16_MAX;
+}
+
+// Core 1 draws even lines, core 0 draws odd lines. CGIA display list
+// state is per core, so lines owned by the other core are only walked.
+static void __not_in_flash_func(out_render_lines)(uint core)
+{
+    static uint32_t pair_cycles[2];
+    const uint16_t raster = out_render_raster();
+    if (raster == UINT16_MAX)
+    {
+        if (*(volatile uint *)&v_scanline < MODE_V_BLANK_LINES)
+            next_raster[core] = 0; // new frame
+        return;
+    }
+    while (next_raster[core] <= raster)
+    {
+        const uint16_t y = next_raster[core]++;
+        const bool own = (y & 1) != core;
+        const uint32_t start = prf_time();
+        switch (active_mode)
+        {
+        case OUT_MODE_VT:
+            if (own)
+            {
+                term_render(y, out_line_buffer(y));
+                prf_enc(core, PRF_ENC_TERM, start);
+            }
+            break;
+        case OUT_MODE_CGIA:
+            cgia_render(y, own ? out_line_buffer(y) : NULL);
+            break;
+        }
+        pair_cycles[core] += prf_elapsed(start);
+        if (own)
+        {
+            prf_line(core, y, pair_cycles[core]);
+            pair_cycles[core] = 0;
+        }
+    }
+}
+
+// Core 1 kicks core 0 through the SIO FIFO on every new raster line.
+// Runs at the lowest priority so PIX and audio IRQs preempt it.
+static void __not_in_flash_func(out_core0_fifo_irq)(void)
+{
+    while (multicore_fifo_rvalid())
+        (void)sio_hw->fifo_rd;
+    multicore_fifo_clear_irq();
+    out_render_lines(0);
+}
+#endif
+
 // ----------------------------------------------------------------------------
 // Core1 main loop
 
@@ -559,6 +647,8 @@ void __not_in_flash_func(out_core1_main)(void)
     gen_line_ptr = (uintptr_t)(linebuffer + LINE_BUFFER_PADDING);
     cur_line_ptr = (uintptr_t)(linebuffer + LINE_BUFFER_PADDING + RGB_LINE_BUFFER_LEN);
 
+    prf_timer_init();
+
     while (true)
     {
         if (trigger_vbl)
@@ -567,6 +657,17 @@ void __not_in_flash_func(out_core1_main)(void)
             trigger_vbl = false;
         }
 
+#if OUT_DUAL_CORE
+        static uint16_t kicked_raster = UINT16_MAX;
+        const uint16_t raster = out_render_raster();
+        if (raster != kicked_raster)
+        {
+            kicked_raster = raster;
+            if (multicore_fifo_wready())
+                sio_hw->fifo_wr = raster;
+        }
+        out_render_lines(1);
+#else
         static uint16_t active_scanline = UINT16_MAX;
         if (a_scanline != active_scanline)
         {
@@ -576,18 +677,22 @@ void __not_in_flash_func(out_core1_main)(void)
             uint16_t generated_raster = gen_scanline / FB_V_REPEAT;
             if (generated_raster != active_raster)
             {
+                const uint32_t start = prf_time();
                 switch (active_mode)
                 {
                 case OUT_MODE_VT:
                     term_render(active_raster, (uint32_t *)gen_line_ptr);
+                    prf_enc(1, PRF_ENC_TERM, start);
                     break;
                 case OUT_MODE_CGIA:
                     cgia_render((uint16_t)active_raster, (uint32_t *)gen_line_ptr);
                     break;
                 }
                 gen_scanline = active_scanline;
+                prf_line(1, active_raster, prf_elapsed(start));
             }
         }
+#endif
 
         __wfi(); // wait for interrupt
     }
@@ -624,7 +729,23 @@ void out_init(void)
                     OUT_HSTX_HZ,
                     OUT_HSTX_HZ);
 
+    // Cycles a line may take to render
+#if OUT_DUAL_CORE
+    prf_init(SYS_CLK_HZ / MODE_V_FREQ_HZ / MODE_V_TOTAL_LINES * FB_V_REPEAT * OUT_RENDER_AHEAD);
+#else
+    prf_init(SYS_CLK_HZ / MODE_V_FREQ_HZ / MODE_V_TOTAL_LINES * FB_V_REPEAT);
+#endif
+
     multicore_launch_core1(out_core1_main);
+
+#if OUT_DUAL_CORE
+    prf_timer_init();
+    multicore_fifo_drain();
+    multicore_fifo_clear_irq();
+    irq_set_exclusive_handler(SIO_IRQ_FIFO, out_core0_fifo_irq);
+    irq_set_priority(SIO_IRQ_FIFO, PICO_LOWEST_IRQ_PRIORITY);
+    irq_set_enabled(SIO_IRQ_FIFO, true);
+#endif
 }
 
 void out_write_status(void)
@@ -44,6 +44,13 @@
 #define FB_H_REPEAT 2
 #define FB_V_REPEAT 2
 
+// Render even lines on core 1 and odd lines on core 0.
+// Each line gets two raster periods instead of one, paid for with
+// core 0 time. Display list interrupts fire at the same raster.
+#ifndef OUT_DUAL_CORE
+#define OUT_DUAL_CORE 0
+#endif
+
 void out_init(void);
 void out_write_status(void);
 
@@ -8,6 +8,7 @@
 #include "cgia/cgia.h"
 #include "hw.h"
 #include "pix.pio.h"
+#include "pix_pack.h"
 #include "sys/aud.h"
 #include "sys/buz.h"
 #include "sys/led.h"
@@ -25,16 +26,21 @@ volatile const uint8_t xram[0x10000] __attribute__((aligned(0x10000)));
 static uint8_t __attribute__((aligned(4))) pix_buffer[32];
 
 static int pix_req_dma_chan;
-static bool vcache_dma_running = false;
 
 static inline void __attribute__((always_inline))
 pix_ack(void)
 {
-    if (vcache_dma_blocks_remaining > 0 && !vcache_dma_running)
+    if (vcache_dma_state == VCACHE_DMA_REQUEST)
     {
         // Start DMA transfer of VCACHE Bank
-        *(io_rw_16 *)&PIX_PIO->txf[PIX_SM] = PIX_RESPONSE(PIX_DMA_REQ, vcache_dma_bank);
-        vcache_dma_running = true;
+        *(io_rw_16 *)&PIX_PIO->txf[PIX_SM] = PIX_RESPONSE(PIX_DMA_REQ, vcache_dma_request);
+        vcache_dma_state = VCACHE_DMA_RUNNING;
+    }
+    else if (aud_pcm_response)
+    {
+        // Ask for a PCM stream refill
+        *(io_rw_16 *)&PIX_PIO->txf[PIX_SM] = aud_pcm_response;
+        aud_pcm_response = 0;
     }
     else
     {
@@ -66,27 +72,23 @@ static void __isr pix_irq_handler(void)
     dma_channel_set_transfer_count(pix_req_dma_chan, frame_count, false);
 
     const uint8_t request = header >> 5;
-    if (request == PIX_DMA_WRITE && frame_count == 32)
+    if (request == PIX_DMA_WRITE && frame_count == PIX_VCACHE_ROW_SIZE)
     {
-        // drain FIFO to memory directly
-        dma_channel_set_write_addr(pix_req_dma_chan, vcache_dma_dest, true);
-        dma_channel_wait_for_finish_blocking(pix_req_dma_chan);
-        vcache_dma_dest += 32;
-        if (vcache_dma_blocks_remaining == 0)
+        if (vcache_dma_state != VCACHE_DMA_RUNNING
+            || vcache_dma_dest >= vcache_dma_base + 0x10000)
         {
-            printf("PIX VCACHE DMA OVERFLOW BANK %02X\n", vcache_dma_bank);
+            // nowhere to put it - drain FIFO to buffer
+            dma_channel_set_write_addr(pix_req_dma_chan, pix_buffer, true);
+            dma_channel_wait_for_finish_blocking(pix_req_dma_chan);
+            printf("PIX VCACHE DMA OVERFLOW BANK %02X\n", PIX_DMA_REQ_BANK(vcache_dma_request));
             pix_nak();
+            return;
         }
-        else
-        {
-            --vcache_dma_blocks_remaining;
-            pix_ack();
-        }
-        if (vcache_dma_blocks_remaining == 0)
-        {
-            vcache_dma_running = false;
-        }
-
+        // drain FIFO to memory directly
+        dma_channel_set_write_addr(pix_req_dma_chan, vcache_dma_dest, true);
+        dma_channel_wait_for_finish_blocking(pix_req_dma_chan);
+        vcache_dma_dest += PIX_VCACHE_ROW_SIZE;
+        pix_ack();
         return;
     }
 
@@ -104,15 +106,54 @@ static void __isr pix_irq_handler(void)
         pix_rsp(PIX_PONG, (uint16_t)((pix_buffer[frame_count - 1] << 6) | frame_count));
     }
     break;
+    case PIX_DMA_WRITE:
+    {
+        if (vcache_dma_state != VCACHE_DMA_RUNNING)
+            goto unknown;
+        if (frame_count == 1)
+        {
+            vcache_dma_state = VCACHE_DMA_IDLE;
+        }
+        else
+        {
+            // packed rows, or a seek past rows the cache slot already holds
+            uint8_t *dest = pix_unpack(vcache_dma_base, vcache_dma_dest, pix_buffer, frame_count);
+            if (!dest)
+            {
+                printf("PIX VCACHE BAD PACK BANK %02X\n", PIX_DMA_REQ_BANK(vcache_dma_request));
+                pix_nak();
+                break;
+            }
+            vcache_dma_dest = dest;
+        }
+        pix_ack();
+    }
+    break;
     case PIX_MEM_WRITE:
     {
-        if (frame_count != 4)
+        if (frame_count < 4)
             goto unknown;
         // printf("PIX_MEM_WRITE %06lX %02X\n",
         //        pix_buffer[0] << 16 | pix_buffer[1] << 8 | pix_buffer[2], pix_buffer[3]);
-        cgia_ram_write(pix_buffer[0],
-                       (uint16_t)(pix_buffer[1] << 8 | pix_buffer[2]),
-                       pix_buffer[3]);
+        if (frame_count == 4)
+            cgia_ram_write(pix_buffer[0],
+                           (uint16_t)(pix_buffer[1] << 8 | pix_buffer[2]),
+                           pix_buffer[3]);
+        else
+            cgia_ram_write_block(pix_buffer[0],
+                                 (uint16_t)(pix_buffer[1] << 8 | pix_buffer[2]),
+                                 &pix_buffer[3], frame_count - 3);
+        pix_ack();
+    }
+    break;
+    case PIX_MEM_FILL:
+    {
+        if (frame_count != 6)
+            goto unknown;
+        const uint32_t len = pix_buffer[3] << 8 | pix_buffer[4];
+        cgia_ram_fill(pix_buffer[0],
+                      (uint16_t)(pix_buffer[1] << 8 | pix_buffer[2]),
+                      pix_buffer[5], len ? len : 0x10000);
         pix_ack();
     }
     break;
@@ -159,6 +200,36 @@ static void __isr pix_irq_handler(void)
                 pix_nak();
             }
             break;
+        case PIX_DEV_SPU:
+            switch (cmd)
+            {
+            case PIX_SPU_CMD_PCM_WRITE:
+                if (frame_count < 4)
+                    goto unknown;
+                aud_write_pcm((uint16_t)(pix_buffer[2] << 8 | pix_buffer[1]),
+                              &pix_buffer[3], frame_count - 3);
+                pix_ack();
+                break;
+            case PIX_SPU_CMD_REC:
+                if (frame_count < 2)
+                    goto unknown;
+                aud_rec_start(pix_buffer[1]);
+                pix_ack();
+                break;
+            case PIX_SPU_CMD_REC_READ:
+                pix_rsp(PIX_DEV_DATA, aud_rec_read());
+                break;
+            case PIX_SPU_CMD_PLAY:
+                if (frame_count < 5)
+                    goto unknown;
+                aud_play((uint16_t)(pix_buffer[2] << 8 | pix_buffer[1]),
+                         (uint16_t)(pix_buffer[4] << 8 | pix_buffer[3]));
+                pix_ack();
+                break;
+            default:
+                pix_nak();
+            }
+            break;
         case PIX_DEV_MISC:
             switch (cmd)
             {
@@ -303,11 +374,14 @@ void pix_init(void)
     irq_set_exclusive_handler(PIX_DMA_IRQ, pix_dma_handler);
     irq_set_enabled(PIX_DMA_IRQ, true);
 
-    vcache_dma_running = false;
-
     pio_sm_set_enabled(PIX_PIO, PIX_SM, true);
 }
 
+void pix_hold(bool hold)
+{
+    irq_set_enabled(PIO_IRQ_NUM(PIX_PIO, 0), !hold);
+}
+
 void pix_task(void)
 {
 }
@@ -21,4 +21,7 @@
 void pix_init(void);
 void pix_task(void);
 
+// Hold off PIX requests, for tasks sharing state with their handlers.
+void pix_hold(bool hold);
+
 #endif /* _SB_SYS_PIX_H_ */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "sys/prf.h"
+#include "hw.h"
+#include <hardware/uart.h>
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t prf_budget;
+
+#if PRF_RENDER
+
+// Encoder cycles of the line being rendered, per core
+uint32_t prf_line_enc[2][PRF_ENC_COUNT];
+
+// Per core since the last report, so cores never share a counter.
+// The last histogram row counts lines no encoder ran on.
+static uint32_t prf_hist[2][PRF_ENC_COUNT + 1][PRF_HIST_BUCKETS + 1];
+static uint64_t prf_enc_cycles[2][PRF_ENC_COUNT];
+static uint64_t prf_line_cycles[2];
+static uint32_t prf_frames;
+static uint32_t prf_worst[2];
+static uint16_t prf_worst_y[2];
+
+static struct
+{
+    uint16_t last_y;
+    uint16_t late;
+    uint32_t worst;
+} prf_frame[2];
+
+// Completed frame
+static volatile uint32_t prf_last_worst[2];
+static volatile uint16_t prf_last_late[2];
+
+static const char *const prf_names[PRF_ENC_COUNT + 1] = {
+    "MODE0", "MODE1", "MODE2", "MODE3", "MODE4", "MODE5", "MODE6", "MODE7",
+    "SPRITE", "TERM", "DL"};
+
+void __not_in_flash_func(prf_line)(uint core, uint16_t y, uint32_t cycles)
+{
+    if (!prf_budget)
+        return;
+
+    if (y < prf_frame[core].last_y)
+    {
+        prf_last_worst[core] = prf_frame[core].worst;
+        prf_last_late[core] = prf_frame[core].late;
+        prf_frame[core].worst = 0;
+        prf_frame[core].late = 0;
+        if (core == 1)
+            ++prf_frames;
+    }
+    prf_frame[core].last_y = y;
+
+    uint32_t *enc = prf_line_enc[core];
+    uint top = PRF_ENC_COUNT;
+    uint32_t top_cycles = 0;
+    for (uint e = 0; e < PRF_ENC_COUNT; ++e)
+    {
+        if (enc[e] > top_cycles)
+        {
+            top = e;
+            top_cycles = enc[e];
+        }
+        prf_enc_cycles[core][e] += enc[e];
+        enc[e] = 0;
+    }
+    prf_line_cycles[core] += cycles;
+
+    uint bucket;
+    if (cycles > prf_budget)
+    {
+        bucket = PRF_HIST_BUCKETS;
+        ++prf_frame[core].late;
+    }
+    else
+    {
+        bucket = cycles * PRF_HIST_BUCKETS / prf_budget;
+        if (bucket >= PRF_HIST_BUCKETS)
+            bucket = PRF_HIST_BUCKETS - 1;
+    }
+    ++prf_hist[core][top][bucket];
+
+    if (cycles > prf_frame[core].worst)
+        prf_frame[core].worst = cycles;
+    if (cycles > prf_worst[core])
+    {
+        prf_worst[core] = cycles;
+        prf_worst_y[core] = y;
+    }
+}
+
+uint8_t prf_frame_load(void)
+{
+    if (!prf_budget)
+        return 0;
+    const uint32_t worst = prf_last_worst[0] > prf_last_worst[1] ? prf_last_worst[0] : prf_last_worst[1];
+    const uint32_t load = worst * 100 / prf_budget;
+    return load > UINT8_MAX ? UINT8_MAX : (uint8_t)load;
+}
+
+uint8_t prf_frame_late(void)
+{
+    const uint32_t late = prf_last_late[0] + prf_last_late[1];
+    return late > UINT8_MAX ? UINT8_MAX : (uint8_t)late;
+}
+
+static void prf_write(const char *buf)
+{
+    uart_write_blocking(COM_UART_INTERFACE, (const uint8_t *)buf, strlen(buf));
+}
+
+void prf_write_status(void)
+{
+    char buf[128];
+    if (!prf_budget)
+        return;
+
+    uint32_t late = 0;
+    for (uint core = 0; core < 2; ++core)
+        for (uint e = 0; e <= PRF_ENC_COUNT; ++e)
+            late += prf_hist[core][e][PRF_HIST_BUCKETS];
+    snprintf(buf, sizeof(buf), "PRF : %lu frames, %lu late lines, %lu cycles/line budget\r\n",
+             (unsigned long)prf_frames, (unsigned long)late, (unsigned long)prf_budget);
+    prf_write(buf);
+
+    // Worst line per render core. With OUT_DUAL_CORE it includes
+    // walking the line owned by the other core.
+    for (uint core = 0; core < 2; ++core)
+    {
+        if (!prf_line_cycles[core])
+            continue;
+        snprintf(buf, sizeof(buf), "PRF%u: worst %lu cycles at line %u, %ld%% headroom\r\n", core,
+                 (unsigned long)prf_worst[core], prf_worst_y[core],
+                 (long)(100 - (int64_t)prf_worst[core] * 100 / prf_budget));
+        prf_write(buf);
+    }
+
+    prf_write("PRF : budget%     lines   <12   <25   <37   <50   <62   <75   <87  <100  late  time%\r\n");
+    const uint64_t total = prf_line_cycles[0] + prf_line_cycles[1];
+    for (uint e = 0; e <= PRF_ENC_COUNT; ++e)
+    {
+        uint32_t hist[PRF_HIST_BUCKETS + 1];
+        uint32_t lines = 0;
+        for (uint b = 0; b <= PRF_HIST_BUCKETS; ++b)
+        {
+            hist[b] = prf_hist[0][e][b] + prf_hist[1][e][b];
+            lines += hist[b];
+        }
+        const uint64_t cycles = e < PRF_ENC_COUNT ? prf_enc_cycles[0][e] + prf_enc_cycles[1][e] : 0;
+        if (!lines && !cycles)
+            continue;
+        int len = snprintf(buf, sizeof(buf), "PRF : %-6s %9lu", prf_names[e], (unsigned long)lines);
+        for (uint b = 0; b <= PRF_HIST_BUCKETS; ++b)
+            len += snprintf(buf + len, sizeof(buf) - len, " %5lu", (unsigned long)hist[b]);
+        if (e < PRF_ENC_COUNT && total)
+            snprintf(buf + len, sizeof(buf) - len, "  %4lu%%\r\n", (unsigned long)(cycles * 100 / total));
+        else
+            snprintf(buf + len, sizeof(buf) - len, "\r\n");
+        prf_write(buf);
+    }
+
+    memset(prf_hist, 0, sizeof(prf_hist));
+    memset(prf_enc_cycles, 0, sizeof(prf_enc_cycles));
+    memset(prf_line_cycles, 0, sizeof(prf_line_cycles));
+    memset(prf_worst, 0, sizeof(prf_worst));
+    prf_frames = 0;
+}
+
+#else
+
+uint8_t prf_frame_load(void)
+{
+    return 0;
+}
+
+uint8_t prf_frame_late(void)
+{
+    return 0;
+}
+
+void prf_write_status(void)
+{
+}
+
+#endif
+
+void prf_init(uint32_t budget_cycles)
+{
+    prf_budget = budget_cycles;
+}
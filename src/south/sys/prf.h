@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SB_SYS_PRF_H_
+#define _SB_SYS_PRF_H_
+
+/* Render profiler
+ *
+ * Times every rendered raster line and the encoders drawing it with
+ * the core's SysTick, against the cycles the line may take. This is
+ * the only render timer, out.c starts it on both render cores. Lines are
+ * counted in a histogram by the encoder that took most of their time.
+ * Lines taking longer than the budget are late and show as glitches.
+ * Reported in STATUS, the last frame also in CGIA load/late registers.
+ */
+
+#include <pico.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PRF_RENDER
+#define PRF_RENDER 1
+#endif
+
+#if PRF_RENDER
+#include <hardware/structs/systick.h>
+#endif
+
+typedef enum
+{
+    PRF_ENC_MODE0 = 0, // MODE0-7 display list rows
+    PRF_ENC_MODE7 = 7,
+    PRF_ENC_SPRITE,
+    PRF_ENC_TERM,
+    PRF_ENC_COUNT,
+} prf_enc_t;
+
+#define PRF_HIST_BUCKETS 8 // eighths of the budget, late lines counted apart
+
+// budget_cycles is how long a line may take to render.
+void prf_init(uint32_t budget_cycles);
+
+// Writes the histogram and encoder times to the UART and starts over.
+void prf_write_status(void);
+
+// Worst line of the last frame in percent of the budget, and late lines in it.
+uint8_t prf_frame_load(void);
+uint8_t prf_frame_late(void);
+
+#if PRF_RENDER
+
+extern uint32_t prf_line_enc[2][PRF_ENC_COUNT];
+
+// Starts SysTick free running on the calling core.
+static inline void prf_timer_init(void)
+{
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M33_SYST_CSR_CLKSOURCE_BITS | M33_SYST_CSR_ENABLE_BITS;
+}
+
+// SysTick counts down, 24 bits.
+static inline uint32_t prf_time(void)
+{
+    return systick_hw->cvr;
+}
+
+static inline uint32_t prf_elapsed(uint32_t start)
+{
+    return (start - systick_hw->cvr) & 0x00FFFFFF;
+}
+
+static inline void prf_enc(uint core, prf_enc_t enc, uint32_t start)
+{
+    prf_line_enc[core][enc] += prf_elapsed(start);
+}
+
+// Rendered line y on core, taking cycles in total.
+void prf_line(uint core, uint16_t y, uint32_t cycles);
+
+#else
+
+static inline void prf_timer_init(void)
+{
+}
+
+static inline uint32_t prf_time(void)
+{
+    return 0;
+}
+
+static inline uint32_t prf_elapsed(uint32_t start)
+{
+    (void)start;
+    return 0;
+}
+
+static inline void prf_enc(uint core, prf_enc_t enc, uint32_t start)
+{
+    (void)core;
+    (void)enc;
+    (void)start;
+}
+
+static inline void prf_line(uint core, uint16_t y, uint32_t cycles)
+{
+    (void)core;
+    (void)y;
+    (void)cycles;
+}
+
+#endif
+
+#endif /* _SB_SYS_PRF_H_ */
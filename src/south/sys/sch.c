@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "sys/sch.h"
+#include "hw.h"
+#include <hardware/timer.h>
+#include <hardware/uart.h>
+#include <stdio.h>
+#include <string.h>
+
+static sch_task_t *sch_tasks;
+static size_t sch_count;
+
+static inline void sch_run(sch_task_t *task, uint32_t start)
+{
+    task->fn();
+    uint32_t elapsed = time_us_32() - start;
+    task->runs++;
+    task->total_us += elapsed;
+    if (elapsed > task->max_us)
+        task->max_us = elapsed;
+    if (elapsed > task->budget_us)
+        task->overruns++;
+}
+
+static void sch_run_due(void)
+{
+    for (size_t i = 0; i < sch_count; i++)
+    {
+        sch_task_t *task = &sch_tasks[i];
+        if (!task->period_us)
+            continue;
+        uint32_t now = time_us_32();
+        int32_t late = (int32_t)(now - task->next_us);
+        if (late < 0)
+            continue;
+        if ((uint32_t)late > task->max_late_us)
+            task->max_late_us = late;
+        // Skip missed periods instead of running back to back.
+        task->next_us += task->period_us;
+        if ((int32_t)(now - task->next_us) >= 0)
+            task->next_us = now + task->period_us;
+        sch_run(task, now);
+    }
+}
+
+void sch_init(sch_task_t *tasks, size_t count)
+{
+    sch_tasks = tasks;
+    sch_count = count;
+    uint32_t now = time_us_32();
+    for (size_t i = 0; i < count; i++)
+        tasks[i].next_us = now;
+}
+
+void sch_task(void)
+{
+    sch_run_due();
+    for (size_t i = 0; i < sch_count; i++)
+    {
+        sch_task_t *task = &sch_tasks[i];
+        if (task->period_us)
+            continue;
+        sch_run(task, time_us_32());
+        sch_run_due();
+    }
+}
+
+void sch_write_status(void)
+{
+    char buf[96];
+    for (size_t i = 0; i < sch_count; i++)
+    {
+        const sch_task_t *task = &sch_tasks[i];
+        snprintf(buf, sizeof(buf),
+                 "TASK: %-10s avg %lu max %lu late %lu us, %lu/%lu over\r\n",
+                 task->name,
+                 (unsigned long)(task->runs ? task->total_us / task->runs : 0),
+                 (unsigned long)task->max_us,
+                 (unsigned long)task->max_late_us,
+                 (unsigned long)task->overruns,
+                 (unsigned long)task->runs);
+        uart_write_blocking(COM_UART_INTERFACE, (const uint8_t *)buf, strlen(buf));
+    }
+}
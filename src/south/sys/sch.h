@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Tomasz Sterna
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SB_SYS_SCH_H_
+#define _SB_SYS_SCH_H_
+
+/* Cooperative task scheduler
+ *
+ * Tasks are listed in priority order. Periodic tasks run whenever
+ * their deadline has passed, highest priority first. Tasks with no
+ * period all run on every pass, in order, and every periodic task is
+ * checked again between two background tasks.
+ * Run time is measured against a budget and reported in STATUS.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct
+{
+    void (*fn)(void);
+    const char *name;
+    uint32_t period_us; // 0 runs in the background
+    uint32_t budget_us; // longer runs are counted as overruns
+    // Filled in by the scheduler.
+    uint32_t next_us;
+    uint32_t runs;
+    uint32_t overruns;
+    uint32_t max_us;
+    uint32_t max_late_us;
+    uint64_t total_us;
+} sch_task_t;
+
+#define SCH_TASK(fn, period_us, budget_us) \
+    {fn, #fn, period_us, budget_us, 0, 0, 0, 0, 0, 0}
+
+/* Main events
+ */
+
+void sch_init(sch_task_t *tasks, size_t count);
+void sch_task(void);
+
+// Writes per task statistics to the UART.
+void sch_write_status(void);
+
+#endif /* _SB_SYS_SCH_H_ */
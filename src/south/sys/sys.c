@@ -6,6 +6,8 @@
 
 #include "sys/ext.h"
 #include "sys/out.h"
+#include "sys/prf.h"
+#include "sys/sch.h"
 #include "version.h"
 #include <pico.h>
 
@@ -25,6 +27,8 @@ __in_flash("sys_version") const char *sys_version(void)
 void sys_write_status(void)
 {
     out_write_status();
+    prf_write_status();
+    sch_write_status();
     // aud_print_status();
     // gpx_dump_registers();
     // ext_bus_scan();